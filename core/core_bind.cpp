@@ -109,6 +109,41 @@ PackedStringArray ResourceLoader::get_dependencies(const String &p_path) {
 	return ret;
 }
 
+void ResourceLoader::set_load_trace_enabled(bool p_enabled) {
+	::ResourceLoader::set_load_trace_enabled(p_enabled);
+}
+
+bool ResourceLoader::is_load_trace_enabled() const {
+	return ::ResourceLoader::is_load_trace_enabled();
+}
+
+TypedArray<Dictionary> ResourceLoader::get_load_trace() const {
+	TypedArray<Dictionary> ret;
+	for (const ::ResourceLoader::LoadTraceEntry &E : ::ResourceLoader::get_load_trace()) {
+		Dictionary entry;
+		entry["path"] = E.path;
+		entry["type"] = E.type;
+		entry["loader"] = E.loader;
+		entry["bytes"] = E.bytes;
+		entry["thread_id"] = E.thread_id;
+		entry["start_usec"] = E.start_usec;
+		entry["end_usec"] = E.end_usec;
+		entry["parent"] = E.parent;
+		entry["depth"] = E.depth;
+		entry["error"] = E.error;
+		ret.push_back(entry);
+	}
+	return ret;
+}
+
+void ResourceLoader::clear_load_trace() {
+	::ResourceLoader::clear_load_trace();
+}
+
+Error ResourceLoader::save_load_trace(const String &p_path) {
+	return ::ResourceLoader::save_load_trace(p_path);
+}
+
 bool ResourceLoader::has_cached(const String &p_path) {
 	String local_path = ProjectSettings::get_singleton()->localize_path(p_path);
 	return ResourceCache::has(local_path);
@@ -136,6 +171,11 @@ void ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("has_cached", "path"), &ResourceLoader::has_cached);
 	ClassDB::bind_method(D_METHOD("exists", "path", "type_hint"), &ResourceLoader::exists, DEFVAL(""));
 	ClassDB::bind_method(D_METHOD("get_resource_uid", "path"), &ResourceLoader::get_resource_uid);
+	ClassDB::bind_method(D_METHOD("set_load_trace_enabled", "enabled"), &ResourceLoader::set_load_trace_enabled);
+	ClassDB::bind_method(D_METHOD("is_load_trace_enabled"), &ResourceLoader::is_load_trace_enabled);
+	ClassDB::bind_method(D_METHOD("get_load_trace"), &ResourceLoader::get_load_trace);
+	ClassDB::bind_method(D_METHOD("clear_load_trace"), &ResourceLoader::clear_load_trace);
+	ClassDB::bind_method(D_METHOD("save_load_trace", "path"), &ResourceLoader::save_load_trace);
 
 	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
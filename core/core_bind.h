@@ -84,6 +84,12 @@ public:
 	bool exists(const String &p_path, const String &p_type_hint = "");
 	ResourceUID::ID get_resource_uid(const String &p_path);
 
+	void set_load_trace_enabled(bool p_enabled);
+	bool is_load_trace_enabled() const;
+	TypedArray<Dictionary> get_load_trace() const;
+	void clear_load_trace();
+	Error save_load_trace(const String &p_path);
+
 	ResourceLoader() { singleton = this; }
 };
 
@@ -91,6 +91,37 @@ public:
 	}
 };
 
+class RemoteDebugger::ResourceLoaderProfiler : public EngineProfiler {
+	// Resources are loaded from any thread, so entries are buffered until the next frame.
+	Mutex mutex;
+	Array entries;
+
+public:
+	void toggle(bool p_enable, const Array &p_opts) {
+		MutexLock lock(mutex);
+		entries.clear();
+	}
+
+	void add(const Array &p_data) {
+		MutexLock lock(mutex);
+		entries.push_back(p_data);
+	}
+
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+		Array to_send;
+		{
+			MutexLock lock(mutex);
+			if (entries.is_empty()) {
+				return;
+			}
+			to_send = entries;
+			entries = Array();
+		}
+		// Each entry is [path, type, loader, bytes, thread_id, start_usec, end_usec, parent, depth, error].
+		EngineDebugger::get_singleton()->send_message("resource_loader:profile_frame", to_send);
+	}
+};
+
 Error RemoteDebugger::_put_msg(String p_message, Array p_data) {
 	Array msg;
 	msg.push_back(p_message);
@@ -584,6 +615,10 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+	// Resource loader profiler, streams per resource load timings while enabled.
+	resource_loader_profiler.instantiate();
+	resource_loader_profiler->bind("resource_loader");
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
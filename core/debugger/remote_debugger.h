@@ -51,8 +51,10 @@ private:
 	typedef DebuggerMarshalls::OutputError ErrorMessage;
 
 	class PerformanceProfiler;
+	class ResourceLoaderProfiler;
 
 	Ref<PerformanceProfiler> performance_profiler;
+	Ref<ResourceLoaderProfiler> resource_loader_profiler;
 
 	Ref<RemoteDebuggerPeer> peer;
 
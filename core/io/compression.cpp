@@ -32,9 +32,13 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
 
 #include "thirdparty/misc/fastlz.h"
 
+#include <zdict.h>
 #include <zlib.h>
 #include <zstd.h>
 
@@ -42,7 +46,49 @@
 #include <brotli/decode.h>
 #endif
 
-int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode) {
+struct ZstdDictionary {
+	SafeRefCount refcount;
+	uint32_t id = 0;
+	ZSTD_CDict *cdict = nullptr;
+	ZSTD_DDict *ddict = nullptr;
+
+	~ZstdDictionary() {
+		ZSTD_freeCDict(cdict);
+		ZSTD_freeDDict(ddict);
+	}
+};
+
+static HashMap<String, ZstdDictionary *> zstd_dictionaries;
+static Mutex zstd_dictionaries_mutex;
+
+static void _zstd_dictionary_unref(ZstdDictionary *p_dictionary) {
+	if (p_dictionary && p_dictionary->refcount.unref()) {
+		memdelete(p_dictionary);
+	}
+}
+
+// Returns a referenced dictionary, looked up by name or by ID when the name is empty.
+static ZstdDictionary *_zstd_dictionary_ref(const String &p_name, uint32_t p_id) {
+	MutexLock lock(zstd_dictionaries_mutex);
+	ZstdDictionary *dictionary = nullptr;
+	if (!p_name.is_empty()) {
+		ZstdDictionary **E = zstd_dictionaries.getptr(p_name);
+		dictionary = E ? *E : nullptr;
+	} else {
+		for (const KeyValue<String, ZstdDictionary *> &E : zstd_dictionaries) {
+			if (E.value->id == p_id) {
+				dictionary = E.value;
+				break;
+			}
+		}
+	}
+	if (dictionary) {
+		dictionary->refcount.ref();
+	}
+	return dictionary;
+}
+
+int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode, const String &p_zstd_dictionary) {
 	switch (p_mode) {
 		case MODE_BROTLI: {
 			ERR_FAIL_V_MSG(-1, "Only brotli decompression is supported.");
@@ -91,6 +137,18 @@ int Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size,
 				ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, zstd_window_log_size);
 			}
 			int max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
+			if (!p_zstd_dictionary.is_empty()) {
+				ZstdDictionary *dictionary = _zstd_dictionary_ref(p_zstd_dictionary, 0);
+				if (!dictionary) {
+					ZSTD_freeCCtx(cctx);
+					ERR_FAIL_V_MSG(-1, "Zstd dictionary is not registered: " + p_zstd_dictionary + ".");
+				}
+				ZSTD_CCtx_refCDict(cctx, dictionary->cdict);
+				size_t ret = ZSTD_compress2(cctx, p_dst, max_dst_size, p_src, p_src_size);
+				ZSTD_freeCCtx(cctx);
+				_zstd_dictionary_unref(dictionary);
+				return ZSTD_isError(ret) ? -1 : int(ret);
+			}
 			int ret = ZSTD_compressCCtx(cctx, p_dst, max_dst_size, p_src, p_src_size, zstd_level);
 			ZSTD_freeCCtx(cctx);
 			return ret;
@@ -137,7 +195,7 @@ int Compression::get_max_compressed_buffer_size(int p_src_size, Mode p_mode) {
 	ERR_FAIL_V(-1);
 }
 
-int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode) {
+int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode, const String &p_zstd_dictionary) {
 	switch (p_mode) {
 		case MODE_BROTLI: {
 #ifdef BROTLI_ENABLED
@@ -191,6 +249,19 @@ int Compression::decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p
 			if (zstd_long_distance_matching) {
 				ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 			}
+			uint32_t dictionary_id = ZSTD_getDictID_fromFrame(p_src, p_src_size);
+			if (dictionary_id != 0 || !p_zstd_dictionary.is_empty()) {
+				ZstdDictionary *dictionary = _zstd_dictionary_ref(p_zstd_dictionary, dictionary_id);
+				if (!dictionary) {
+					ZSTD_freeDCtx(dctx);
+					ERR_FAIL_V_MSG(-1, vformat("Data was compressed with a zstd dictionary (ID %d) which is not registered.", dictionary_id));
+				}
+				ZSTD_DCtx_refDDict(dctx, dictionary->ddict);
+				size_t ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
+				ZSTD_freeDCtx(dctx);
+				_zstd_dictionary_unref(dictionary);
+				return ZSTD_isError(ret) ? -1 : int(ret);
+			}
 			int ret = ZSTD_decompressDCtx(dctx, p_dst, p_dst_max_size, p_src, p_src_size);
 			ZSTD_freeDCtx(dctx);
 			return ret;
@@ -349,6 +420,88 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+Vector<uint8_t> Compression::zstd_train_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	ERR_FAIL_COND_V(p_max_size <= 0, Vector<uint8_t>());
+
+	// The trainer wants all samples in a single buffer.
+	Vector<uint8_t> samples;
+	Vector<size_t> sample_sizes;
+	uint64_t total_size = 0;
+	for (const Vector<uint8_t> &sample : p_samples) {
+		total_size += sample.size();
+	}
+	samples.resize(total_size);
+	sample_sizes.resize(p_samples.size());
+	uint64_t ofs = 0;
+	for (int i = 0; i < p_samples.size(); i++) {
+		memcpy(samples.ptrw() + ofs, p_samples[i].ptr(), p_samples[i].size());
+		sample_sizes.write[i] = p_samples[i].size();
+		ofs += p_samples[i].size();
+	}
+
+	Vector<uint8_t> dictionary;
+	dictionary.resize(p_max_size);
+	size_t ret = ZDICT_trainFromBuffer(dictionary.ptrw(), p_max_size, samples.ptr(), sample_sizes.ptr(), sample_sizes.size());
+	ERR_FAIL_COND_V_MSG(ZDICT_isError(ret), Vector<uint8_t>(), vformat("Zstd dictionary training failed: %s.", ZDICT_getErrorName(ret)));
+	dictionary.resize(ret);
+	return dictionary;
+}
+
+Error Compression::zstd_register_dictionary(const String &p_name, const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_V(p_name.is_empty(), ERR_INVALID_PARAMETER);
+	uint32_t id = ZDICT_getDictID(p_dictionary.ptr(), p_dictionary.size());
+	// Raw content dictionaries have no ID, so they couldn't be found when decompressing.
+	ERR_FAIL_COND_V_MSG(id == 0, ERR_INVALID_DATA, "Invalid zstd dictionary, it must be created with zstd_train_dictionary().");
+
+	ZstdDictionary *dictionary = memnew(ZstdDictionary);
+	dictionary->refcount.init();
+	dictionary->id = id;
+	// Both keep their own copy of the dictionary data.
+	dictionary->cdict = ZSTD_createCDict(p_dictionary.ptr(), p_dictionary.size(), zstd_level);
+	dictionary->ddict = ZSTD_createDDict(p_dictionary.ptr(), p_dictionary.size());
+	if (!dictionary->cdict || !dictionary->ddict) {
+		memdelete(dictionary);
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid zstd dictionary.");
+	}
+
+	ZstdDictionary *previous = nullptr;
+	{
+		MutexLock lock(zstd_dictionaries_mutex);
+		ZstdDictionary **E = zstd_dictionaries.getptr(p_name);
+		if (E) {
+			previous = *E;
+		}
+		zstd_dictionaries[p_name] = dictionary;
+	}
+	_zstd_dictionary_unref(previous);
+	return OK;
+}
+
+void Compression::zstd_unregister_dictionary(const String &p_name) {
+	ZstdDictionary *dictionary = nullptr;
+	{
+		MutexLock lock(zstd_dictionaries_mutex);
+		ZstdDictionary **E = zstd_dictionaries.getptr(p_name);
+		ERR_FAIL_NULL(E);
+		dictionary = *E;
+		zstd_dictionaries.erase(p_name);
+	}
+	_zstd_dictionary_unref(dictionary);
+}
+
+bool Compression::zstd_has_dictionary(const String &p_name) {
+	MutexLock lock(zstd_dictionaries_mutex);
+	return zstd_dictionaries.has(p_name);
+}
+
+void Compression::zstd_clear_dictionaries() {
+	MutexLock lock(zstd_dictionaries_mutex);
+	for (const KeyValue<String, ZstdDictionary *> &E : zstd_dictionaries) {
+		_zstd_dictionary_unref(E.value);
+	}
+	zstd_dictionaries.clear();
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
@@ -31,6 +31,7 @@
 #ifndef COMPRESSION_H
 #define COMPRESSION_H
 
+#include "core/string/ustring.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 
@@ -51,10 +52,18 @@ public:
 		MODE_BROTLI
 	};
 
-	static int compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
+	// Zstd dictionaries are registered by name and used when compressing with that name.
+	// Decompression finds the dictionary by the ID stored in the frame, so the name is optional there.
+	static int compress(uint8_t *p_dst, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD, const String &p_zstd_dictionary = String());
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
-	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
+	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD, const String &p_zstd_dictionary = String());
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	static Vector<uint8_t> zstd_train_dictionary(const Vector<Vector<uint8_t>> &p_samples, int p_max_size = 112640);
+	static Error zstd_register_dictionary(const String &p_name, const Vector<uint8_t> &p_dictionary);
+	static void zstd_unregister_dictionary(const String &p_name);
+	static bool zstd_has_dictionary(const String &p_name);
+	static void zstd_clear_dictionaries();
 };
 
 #endif // COMPRESSION_H
@@ -114,6 +114,33 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	Ref<FileAccess> ret;
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
+		// Packed files are mapped through their pack, if possible.
+		ret = PackedData::get_singleton()->try_open_path(p_path);
+		if (ret.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return ret;
+		}
+	}
+
+	ret = create_for_path(p_path);
+	ret->memory_map_requested = true;
+	Error err = ret->open_internal(p_path, READ);
+
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		ret.unref();
+	}
+
+	return ret;
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
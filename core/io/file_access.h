@@ -85,6 +85,7 @@ protected:
 	virtual Error open_internal(const String &p_path, int p_mode_flags) = 0; ///< open a file
 	virtual uint64_t _get_modified_time(const String &p_file) = 0;
 	virtual void _set_access_type(AccessType p_access);
+	bool is_memory_map_requested() const { return memory_map_requested; }
 
 	static FileCloseFailNotify close_fail_notify;
 
@@ -93,6 +94,7 @@ private:
 	thread_local static Error last_file_open_error;
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
+	bool memory_map_requested = false; // Set by open_mapped() before open_internal().
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
 	template <class T>
 	static Ref<FileAccess> _create_builtin() {
@@ -128,6 +130,7 @@ public:
 	Variant get_var(bool p_allow_objects = false) const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
+	virtual const uint8_t *get_mapped_data() const { return nullptr; } ///< if the file is memory mapped, returns a pointer to its first byte (valid while the file is open), otherwise nullptr
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
 	virtual String get_line() const;
 	virtual String get_token() const;
@@ -177,6 +180,7 @@ public:
 	static Ref<FileAccess> create_for_path(const String &p_path);
 	static Ref<FileAccess> open(const String &p_path, int p_mode_flags, Error *r_error = nullptr); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); /// Open a file read-only, memory mapping it if the platform supports it (not on the Web).
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key);
 	static Ref<FileAccess> open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, const String &p_pass);
 	static Ref<FileAccess> open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode = COMPRESSION_FASTLZ);
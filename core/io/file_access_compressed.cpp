@@ -30,14 +30,16 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
 #include "core/string/print_string.h"
 
-void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
+void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, const String &p_zstd_dictionary) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
 
 	cmode = p_mode;
 	block_size = p_block_size;
+	zstd_dictionary = p_zstd_dictionary;
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -74,19 +76,141 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return _read_block(0);
+}
+
+void FileAccessCompressed::_decompress_block(void *p_cached_block) {
+	CachedBlock *cached = (CachedBlock *)p_cached_block;
+	cached->result = Compression::decompress(cached->dst, cached->dst_max_size, cached->compressed.ptr(), cached->compressed.size(), cached->mode);
+}
+
+void FileAccessCompressed::_wait_for_readahead(CachedBlock &p_cached) const {
+	if (p_cached.task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(p_cached.task);
+		p_cached.task = WorkerThreadPool::INVALID_TASK_ID;
+		if (p_cached.result == -1) {
+			p_cached.block = UINT32_MAX;
+		}
+	}
+}
+
+FileAccessCompressed::CachedBlock *FileAccessCompressed::_get_cache_slot(uint32_t p_keep_block) const {
+	CachedBlock *oldest = nullptr;
+	for (CachedBlock &cached : block_cache) {
+		if (cached.block != p_keep_block && (!oldest || cached.last_used < oldest->last_used)) {
+			oldest = &cached;
+		}
+	}
+	_wait_for_readahead(*oldest);
+	oldest->block = UINT32_MAX;
+	oldest->data.resize(block_size);
+	return oldest;
+}
+
+Error FileAccessCompressed::_read_block(uint32_t p_block) const {
+	read_block = p_block;
+	read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+
+	CachedBlock *cached = nullptr;
+	for (CachedBlock &E : block_cache) {
+		if (E.block == p_block) {
+			_wait_for_readahead(E);
+			// A failed readahead leaves the slot empty, so it's decompressed again below and the error reported.
+			if (E.block == p_block) {
+				cached = &E;
+			}
+			break;
+		}
+	}
+
+	if (!cached) {
+		cached = _get_cache_slot(UINT32_MAX);
+		f->seek(read_blocks[p_block].offset);
+		f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+		int ret = Compression::decompress(cached->data.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+		read_ptr = cached->data.ptr();
+		ERR_FAIL_COND_V_MSG(ret == -1, ERR_FILE_CORRUPT, "Compressed file is corrupt.");
+		cached->block = p_block;
+	}
+
+	cached->last_used = ++block_cache_tick;
+	read_ptr = cached->data.ptr();
+	return OK;
+}
+
+void FileAccessCompressed::_readahead(uint32_t p_block) const {
+	if (readahead_blocks == 0 || WorkerThreadPool::get_singleton()->get_thread_index() != -1) {
+		// No readahead from pool threads, see WorkerThreadPool::get_thread_index().
+		return;
+	}
+
+	uint32_t last = MIN(p_block + readahead_blocks, read_block_count - 1);
+	for (uint32_t i = p_block + 1; i <= last; i++) {
+		bool is_cached = false;
+		for (const CachedBlock &E : block_cache) {
+			if (E.block == i) {
+				is_cached = true;
+				break;
+			}
+		}
+		if (is_cached) {
+			continue;
+		}
+
+		CachedBlock *cached = _get_cache_slot(p_block);
+		cached->block = i;
+		cached->last_used = ++block_cache_tick;
+		cached->compressed.resize(read_blocks[i].csize);
+		f->seek(read_blocks[i].offset);
+		f->get_buffer(cached->compressed.ptrw(), read_blocks[i].csize);
+		cached->dst = cached->data.ptrw();
+		cached->dst_max_size = read_blocks.size() == 1 ? read_total : block_size;
+		cached->mode = cmode;
+		cached->task = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_decompress_block, cached, false, "FileAccessCompressed readahead");
+	}
+}
+
+void FileAccessCompressed::set_read_cache(uint32_t p_cache_blocks, uint32_t p_readahead_blocks) {
+	ERR_FAIL_COND_MSG(f.is_valid(), "The read cache must be set before opening the file.");
+	readahead_blocks = p_readahead_blocks;
+	// Room for the block being read and the blocks read ahead of it.
+	block_cache.resize(MAX(p_cache_blocks, p_readahead_blocks + 2));
+}
+
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size, const String &p_zstd_dictionary) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(p_size > UINT32_MAX, Vector<uint8_t>(), "Can't compress more than 4 GiB into a single file.");
+
+	CharString mgc = (p_magic + "    ").substr(0, 4).utf8();
+	uint32_t bc = (p_size / p_block_size) + 1;
+	uint64_t header_size = 16 + bc * 4;
+
+	Vector<uint8_t> data;
+	data.resize(header_size + uint64_t(Compression::get_max_compressed_buffer_size(p_block_size, p_mode)) * bc + 4);
+	uint8_t *w = data.ptrw();
+
+	memcpy(w, mgc.get_data(), 4); //write header 4
+	encode_uint32(p_mode, w + 4); //write compression mode 4
+	encode_uint32(p_block_size, w + 8); //write block size 4
+	encode_uint32(p_size, w + 12); //max amount of data written 4
+
+	uint64_t ofs = header_size;
+	for (uint32_t i = 0; i < bc; i++) {
+		uint32_t bl = i == (bc - 1) ? p_size % p_block_size : p_block_size;
+		int s = Compression::compress(w + ofs, p_data + uint64_t(i) * p_block_size, bl, p_mode, p_zstd_dictionary);
+		ERR_FAIL_COND_V(s < 0, Vector<uint8_t>());
+		encode_uint32(s, w + 16 + i * 4); //compressed size of each block
+		ofs += s;
+	}
+
+	memcpy(w + ofs, mgc.get_data(), 4); //magic at the end too
+	data.resize(ofs + 4);
+	return data;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -132,37 +256,8 @@ void FileAccessCompressed::_close() {
 
 	if (writing) {
 		//save block table and all compressed blocks
-
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		uint32_t bc = (write_max / block_size) + 1;
-
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (uint32_t i = 0; i < bc; i++) {
-			f->store_32(block_sizes[i]);
-		}
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = compress_buffer(write_ptr, write_max, magic, cmode, block_size, zstd_dictionary);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
@@ -170,6 +265,13 @@ void FileAccessCompressed::_close() {
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
+		for (CachedBlock &cached : block_cache) {
+			_wait_for_readahead(cached);
+			cached.block = UINT32_MAX;
+			cached.data.clear();
+			cached.compressed.clear();
+		}
+		read_ptr = nullptr;
 	}
 	f.unref();
 }
@@ -211,12 +313,7 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND(_read_block(block_idx) != OK);
 			}
 
 			read_pos = p_position % block_size;
@@ -277,10 +374,8 @@ uint8_t FileAccessCompressed::get_8() const {
 
 		if (read_block < read_block_count) {
 			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			ERR_FAIL_COND_V(_read_block(read_block) != OK, 0);
+			_readahead(read_block);
 			read_pos = 0;
 
 		} else {
@@ -302,27 +397,29 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
+	uint64_t dst_pos = 0;
+	while (dst_pos < p_length) {
+		uint64_t to_copy = MIN(p_length - dst_pos, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + dst_pos, read_ptr + read_pos, to_copy);
+		dst_pos += to_copy;
+		read_pos += to_copy;
+
 		if (read_pos >= read_block_size) {
 			read_block++;
 
 			if (read_block < read_block_count) {
 				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				ERR_FAIL_COND_V(_read_block(read_block) != OK, -1);
+				_readahead(read_block);
 				read_pos = 0;
 
 			} else {
 				read_block--;
 				at_end = true;
-				if (i + 1 < p_length) {
+				if (dst_pos < p_length) {
 					read_eof = true;
 				}
-				return i + 1;
+				return dst_pos;
 			}
 		}
 	}
@@ -33,9 +33,12 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
+	String zstd_dictionary;
 	bool writing = false;
 	uint64_t write_pos = 0;
 	uint8_t *write_ptr = nullptr;
@@ -51,7 +54,7 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -59,17 +62,48 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// Recently decompressed blocks, so seeking back and forth between nearby blocks doesn't decompress them again.
+	// When reading sequentially, the next blocks can also be decompressed ahead of time on the WorkerThreadPool.
+	struct CachedBlock {
+		uint32_t block = UINT32_MAX;
+		uint64_t last_used = 0;
+		Vector<uint8_t> data;
+
+		// Readahead state, only touched by the worker while task is valid.
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+		Vector<uint8_t> compressed;
+		uint8_t *dst = nullptr;
+		int dst_max_size = 0;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+		int result = 0;
+	};
+	mutable LocalVector<CachedBlock> block_cache;
+	mutable uint64_t block_cache_tick = 0;
+	uint32_t readahead_blocks = 0;
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	static void _decompress_block(void *p_cached_block);
+	CachedBlock *_get_cache_slot(uint32_t p_keep_block) const;
+	void _wait_for_readahead(CachedBlock &p_cached) const;
+	Error _read_block(uint32_t p_block) const;
+	void _readahead(uint32_t p_block) const;
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	// Reading finds the zstd dictionary by itself, it only has to be registered in Compression.
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096, const String &p_zstd_dictionary = String());
+	// Must be called before opening. p_readahead_blocks blocks after the current one are decompressed in the background
+	// when reading sequentially; the cache is grown to hold them if needed.
+	void set_read_cache(uint32_t p_cache_blocks, uint32_t p_readahead_blocks = 0);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
+	// Returns p_data in the format written by this class, including the magic.
+	static Vector<uint8_t> compress_buffer(const uint8_t *p_data, uint64_t p_size, const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096, const String &p_zstd_dictionary = String());
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -99,7 +133,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessCompressed() {}
+	FileAccessCompressed() { block_cache.resize(4); }
 	virtual ~FileAccessCompressed();
 };
 
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
@@ -47,7 +48,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +56,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -201,7 +203,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_UNCOMPRESSED, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -209,6 +211,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 
+	// Data of files with flags this version doesn't know about can't be read correctly.
+	uint32_t known_file_flags = PACK_FILE_ENCRYPTED;
+	if (version >= PACK_FORMAT_VERSION) {
+		known_file_flags |= PACK_FILE_COMPRESSED;
+	}
+
 	for (int i = 0; i < 16; i++) {
 		//reserved
 		f->get_32();
@@ -232,6 +240,20 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
+#ifndef WEB_ENABLED
+	// Files are never mapped on the Web, there is no point in opening the pack again.
+	{
+		Ref<FileAccess> mapped_pack = FileAccess::open_mapped(p_path);
+		if (mapped_pack.is_valid() && mapped_pack->get_mapped_data()) {
+			MutexLock lock(mapped_packs_mutex);
+			mapped_packs[p_path] = mapped_pack;
+		}
+	}
+#endif
+
+	PackedData::PackedFile dictionary_file;
+	bool has_dictionary = false;
+
 	for (int i = 0; i < file_count; i++) {
 		uint32_t sl = f->get_32();
 		CharString cs;
@@ -247,14 +269,49 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		ERR_FAIL_COND_V_MSG(flags & ~known_file_flags, false, "Pack file '" + path + "' in '" + p_path + "' uses unsupported flags: " + itos(flags) + ".");
+
+		if (path == PACK_ZSTD_DICTIONARY_PATH) {
+			dictionary_file.pack = p_path;
+			dictionary_file.offset = ofs + p_offset;
+			dictionary_file.size = size;
+			memcpy(dictionary_file.md5, md5, 16);
+			dictionary_file.src = this;
+			dictionary_file.encrypted = (flags & PACK_FILE_ENCRYPTED);
+			has_dictionary = true;
+			continue;
+		}
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
+	}
+
+	if (has_dictionary) {
+		// Compressed files find the dictionary by its ID, it only has to be registered before they are opened.
+		Ref<FileAccess> df = memnew(FileAccessPack(PACK_ZSTD_DICTIONARY_PATH, dictionary_file));
+		Vector<uint8_t> dictionary;
+		dictionary.resize(df->get_length());
+		df->get_buffer(dictionary.ptrw(), dictionary.size());
+		Error err = Compression::zstd_register_dictionary("pck:" + p_path, dictionary);
+		ERR_FAIL_COND_V_MSG(err != OK, false, "Can't load the compression dictionary of pack '" + p_path + "'.");
 	}
 
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted && !p_file->compressed) {
+		Ref<FileAccess> mapped_pack;
+		{
+			MutexLock lock(mapped_packs_mutex);
+			HashMap<String, Ref<FileAccess>>::Iterator E = mapped_packs.find(p_file->pack);
+			if (E) {
+				mapped_pack = E->value;
+			}
+		}
+		if (mapped_pack.is_valid() && p_file->offset + p_file->size <= mapped_pack->get_length()) {
+			return memnew(FileAccessPack(p_path, *p_file, mapped_pack));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -282,7 +339,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!data) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -310,6 +369,9 @@ uint8_t FileAccessPack::get_8() const {
 	}
 
 	pos++;
+	if (data) {
+		return data[pos - 1];
+	}
 	return f->get_8();
 }
 
@@ -327,12 +389,16 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += p_length;
-
 	if (to_read <= 0) {
+		pos += p_length;
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += p_length;
 
 	return to_read;
 }
@@ -341,7 +407,9 @@ void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!data) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -369,6 +437,11 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	data = nullptr;
+}
+
+const uint8_t *FileAccessPack::get_mapped_data() const {
+	return data;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
@@ -395,6 +468,31 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
+
+	if (pf.compressed) {
+		uint8_t magic[4] = {};
+		f->get_buffer(magic, 4);
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		// Pack files are mostly read front to back by the resource loaders, so decompress ahead of the reader.
+		fac->set_read_cache(8, 4);
+		Error err = memcmp(magic, PACK_COMPRESSED_FILE_MAGIC, 4) == 0 ? fac->open_after_magic(f) : ERR_FILE_UNRECOGNIZED;
+		if (err != OK) {
+			f.unref();
+			ERR_FAIL_MSG("Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+		}
+		f = fac;
+		off = 0;
+	}
+	pos = 0;
+	eof = false;
+}
+
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) :
+		pf(p_file),
+		f(p_mapped_pack) {
+	data = f->get_mapped_data() + pf.offset;
+	off = pf.offset;
 	pos = 0;
 	eof = false;
 }
@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -40,17 +41,27 @@
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
-// The current packed file format version number.
-#define PACK_FORMAT_VERSION 2
+// The current packed file format version number, written when files are compressed.
+#define PACK_FORMAT_VERSION 3
+// Version written when no file is compressed, which older engines can still read.
+#define PACK_FORMAT_VERSION_UNCOMPRESSED 2
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
+// Compressed files are stored as a FileAccessCompressed stream (before encryption, if any),
+// whose block table lets FileAccessPack seek without decompressing the whole file.
+#define PACK_COMPRESSED_FILE_MAGIC "GCPF"
+#define PACK_COMPRESSION_BLOCK_SIZE 65536
+// Trained zstd dictionary the compressed files of a pack may use, stored as a regular uncompressed file.
+#define PACK_ZSTD_DICTIONARY_PATH "res://.godot/pck_zstd_dictionary"
+
 class PackSource;
 
 class PackedData {
@@ -66,6 +77,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
 	};
 
 private:
@@ -109,7 +121,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -135,6 +147,10 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Read-only mappings of the opened packs, shared by all the files read from them.
+	Mutex mapped_packs_mutex;
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -148,6 +164,7 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *data = nullptr; // Start of the file in the pack mapping, if reading from it (f is then shared, and never moved).
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint32_t _get_unix_permissions(const String &p_file) override { return 0; }
@@ -180,7 +197,10 @@ public:
 
 	virtual void close() override;
 
+	virtual const uint8_t *get_mapped_data() const override;
+
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
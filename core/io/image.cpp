@@ -35,6 +35,7 @@
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
@@ -42,6 +43,12 @@
 #include <stdio.h>
 #include <cmath>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8", //luminance
 	"LumAlpha8", //luminance-alpha
@@ -465,9 +472,48 @@ int Image::get_mipmap_count() const {
 	}
 }
 
+template <class F>
+struct ImageRowsUserdata {
+	const F *func = nullptr;
+	uint32_t rows = 0;
+	uint32_t rows_per_task = 0;
+};
+
+template <class F>
+static void _process_rows_task(void *p_userdata, uint32_t p_index) {
+	const ImageRowsUserdata<F> *ud = static_cast<const ImageRowsUserdata<F> *>(p_userdata);
+	uint32_t from = p_index * ud->rows_per_task;
+	uint32_t to = MIN(from + ud->rows_per_task, ud->rows);
+	(*ud->func)(from, to);
+}
+
+// Calls p_func(from_row, to_row) for ranges of rows spread over the worker thread pool.
+// Small images, and calls made from a pool thread (see WorkerThreadPool::get_thread_index()),
+// are processed on the calling thread.
+template <class F>
+static void _process_rows(uint32_t p_rows, uint32_t p_row_pixels, const F &p_func) {
+	const uint32_t min_pixels_per_task = 16384;
+	uint32_t rows_per_task = MAX(min_pixels_per_task / MAX(p_row_pixels, 1u), 1u);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_rows <= rows_per_task || pool == nullptr || pool->get_thread_count() < 2 || pool->get_thread_index() != -1) {
+		p_func(0, p_rows);
+		return;
+	}
+
+	ImageRowsUserdata<F> ud;
+	ud.func = &p_func;
+	ud.rows = p_rows;
+	ud.rows_per_task = rows_per_task;
+
+	uint32_t task_count = (p_rows + rows_per_task - 1) / rows_per_task;
+	WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_process_rows_task<F>, &ud, task_count, -1, true, "ImageProcessRows");
+	pool->wait_for_group_task_completion(group_task);
+}
+
 //using template generates perfectly optimized code due to constant expression reduction and unused variable removal present in all compilers
 template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
-static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+static void _convert_rows(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
 	constexpr uint32_t max_bytes = MAX(read_bytes, write_bytes);
 
 	for (int y = 0; y < p_height; y++) {
@@ -508,6 +554,16 @@ static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p
 	}
 }
 
+template <uint32_t read_bytes, bool read_alpha, uint32_t write_bytes, bool write_alpha, bool read_gray, bool write_gray>
+static void _convert(int p_width, int p_height, const uint8_t *p_src, uint8_t *p_dst) {
+	constexpr uint32_t read_size = read_bytes + (read_alpha ? 1 : 0);
+	constexpr uint32_t write_size = write_bytes + (write_alpha ? 1 : 0);
+
+	_process_rows(p_height, p_width, [&](uint32_t p_from, uint32_t p_to) {
+		_convert_rows<read_bytes, read_alpha, write_bytes, write_alpha, read_gray, write_gray>(p_width, p_to - p_from, p_src + p_from * p_width * read_size, p_dst + p_from * p_width * write_size);
+	});
+}
+
 void Image::convert(Format p_new_format) {
 	if (data.size() == 0) {
 		return;
@@ -524,11 +580,17 @@ void Image::convert(Format p_new_format) {
 		//use put/set pixel which is slower but works with non byte formats
 		Image new_img(width, height, false, p_new_format);
 
-		for (int i = 0; i < width; i++) {
-			for (int j = 0; j < height; j++) {
-				new_img.set_pixel(i, j, get_pixel(i, j));
+		const uint8_t *src_ptr = data.ptr();
+		uint8_t *dst_ptr = new_img.data.ptrw();
+
+		_process_rows(height, width, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t j = p_from; j < p_to; j++) {
+				for (int i = 0; i < width; i++) {
+					uint32_t ofs = j * width + i;
+					new_img._set_color_at_ofs(dst_ptr, ofs, _get_color_at_ofs(src_ptr, ofs));
+				}
 			}
-		}
+		});
 
 		if (has_mipmaps()) {
 			new_img.generate_mipmaps();
@@ -667,7 +729,7 @@ static double _bicubic_interp_kernel(double x) {
 }
 
 template <int CC, class T>
-static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_row_from, uint32_t p_row_to) {
 	// get source image size
 	int width = p_src_width;
 	int height = p_src_height;
@@ -682,7 +744,7 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int xmax = width - 1;
 	// temporary pointer
 
-	for (uint32_t y = 0; y < p_dst_height; y++) {
+	for (uint32_t y = p_row_from; y < p_row_to; y++) {
 		// Y coordinates
 		oy = (double)y * yfac - 0.5f;
 		oy1 = (int)oy;
@@ -754,7 +816,14 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 }
 
 template <int CC, class T>
-static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, p_dst_width, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_cubic_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, class T>
+static void _scale_bilinear_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_row_from, uint32_t p_row_to) {
 	enum {
 		FRAC_BITS = 8,
 		FRAC_LEN = (1 << FRAC_BITS),
@@ -762,7 +831,7 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 		FRAC_MASK = FRAC_LEN - 1
 	};
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+	for (uint32_t i = p_row_from; i < p_row_to; i++) {
 		// Add 0.5 in order to interpolate based on pixel center
 		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
 		// Calculate nearest src pixel center above current, and truncate to get y index
@@ -844,8 +913,15 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 }
 
 template <int CC, class T>
-static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
+static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, p_dst_width, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_bilinear_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
+template <int CC, class T>
+static void _scale_nearest_rows(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height, uint32_t p_row_from, uint32_t p_row_to) {
+	for (uint32_t i = p_row_from; i < p_row_to; i++) {
 		uint32_t src_yofs = i * p_src_height / p_dst_height;
 		uint32_t y_ofs = src_yofs * p_src_width * CC;
 
@@ -864,6 +940,13 @@ static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict
 	}
 }
 
+template <int CC, class T>
+static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	_process_rows(p_dst_height, p_dst_width, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_nearest_rows<CC, T>(p_src, p_dst, p_src_width, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
+}
+
 #define LANCZOS_TYPE 3
 
 static float _lanczos(float p_x) {
@@ -871,116 +954,123 @@ static float _lanczos(float p_x) {
 }
 
 template <int CC, class T>
-static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	int32_t src_width = p_src_width;
-	int32_t src_height = p_src_height;
-	int32_t dst_height = p_dst_height;
-	int32_t dst_width = p_dst_width;
+static void _scale_lanczos_columns(const uint8_t *__restrict p_src, float *__restrict p_buffer, int32_t p_src_width, int32_t p_src_height, int32_t p_dst_width, int32_t p_column_from, int32_t p_column_to) {
+	// FIRST PASS (horizontal), writes columns of the buffer.
 
-	uint32_t buffer_size = src_height * dst_width * CC;
-	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
+	float x_scale = float(p_src_width) / float(p_dst_width);
 
-	{ // FIRST PASS (horizontal)
+	float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
+	int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float x_scale = float(src_width) / float(dst_width);
+	float *kernel = memnew_arr(float, half_kernel * 2);
 
-		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+	for (int32_t buffer_x = p_column_from; buffer_x < p_column_to; buffer_x++) {
+		// The corresponding point on the source image
+		float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
+		int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
+		int32_t end_x = MIN(p_src_width - 1, int32_t(src_x) + half_kernel);
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// Create the kernel used by all the pixels of the column
+		for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+			kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+		}
 
-		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
-			// The corresponding point on the source image
-			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+		for (int32_t buffer_y = 0; buffer_y < p_src_height; buffer_y++) {
+			float pixel[CC] = { 0 };
+			float weight = 0;
 
-			// Create the kernel used by all the pixels of the column
 			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
-			}
-
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				float lanczos_val = kernel[target_x - start_x];
+				weight += lanczos_val;
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+				const T *__restrict src_data = ((const T *)p_src) + (buffer_y * p_src_width + target_x) * CC;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
-
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
-						}
+				for (uint32_t i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 2) { //half float
+						pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+					} else {
+						pixel[i] += src_data[i] * lanczos_val;
 					}
 				}
+			}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+			float *dst_data = p_buffer + (buffer_y * p_dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
-				}
+			for (uint32_t i = 0; i < CC; i++) {
+				dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
 			}
 		}
+	}
 
-		memdelete_arr(kernel);
-	} // End of first pass
+	memdelete_arr(kernel);
+}
 
-	{ // SECOND PASS (vertical + result)
+template <int CC, class T>
+static void _scale_lanczos_rows(const float *__restrict p_buffer, uint8_t *__restrict p_dst, int32_t p_src_height, int32_t p_dst_width, int32_t p_dst_height, int32_t p_row_from, int32_t p_row_to) {
+	// SECOND PASS (vertical + result), writes rows of the destination.
 
-		float y_scale = float(src_height) / float(dst_height);
+	float y_scale = float(p_src_height) / float(p_dst_height);
 
-		float scale_factor = MAX(y_scale, 1);
-		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
+	float scale_factor = MAX(y_scale, 1);
+	int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+	float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+	for (int32_t dst_y = p_row_from; dst_y < p_row_to; dst_y++) {
+		float buffer_y = (dst_y + 0.5f) * y_scale;
+		int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+		int32_t end_y = MIN(p_src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+		for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+			kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+		}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		for (int32_t dst_x = 0; dst_x < p_dst_width; dst_x++) {
+			float pixel[CC] = { 0 };
+			float weight = 0;
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+				float lanczos_val = kernel[target_y - start_y];
+				weight += lanczos_val;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+				const float *buffer_data = p_buffer + (target_y * p_dst_width + dst_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
-					}
+				for (uint32_t i = 0; i < CC; i++) {
+					pixel[i] += buffer_data[i] * lanczos_val;
 				}
+			}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+			T *dst_data = ((T *)p_dst) + (dst_y * p_dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
-
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) { //half float
-						dst_data[i] = Math::make_half_float(pixel[i]);
-					} else { // float
-						dst_data[i] = pixel[i];
-					}
+			for (uint32_t i = 0; i < CC; i++) {
+				pixel[i] /= weight;
+
+				if constexpr (sizeof(T) == 1) { //byte
+					dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+				} else if constexpr (sizeof(T) == 2) { //half float
+					dst_data[i] = Math::make_half_float(pixel[i]);
+				} else { // float
+					dst_data[i] = pixel[i];
 				}
 			}
 		}
+	}
+
+	memdelete_arr(kernel);
+}
+
+template <int CC, class T>
+static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
+	uint32_t buffer_size = p_src_height * p_dst_width * CC;
+	float *buffer = memnew_arr(float, buffer_size); // Store the first pass in a buffer
 
-		memdelete_arr(kernel);
-	} // End of second pass
+	_process_rows(p_dst_width, p_src_height, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_lanczos_columns<CC, T>(p_src, buffer, p_src_width, p_src_height, p_dst_width, p_from, p_to);
+	});
+
+	_process_rows(p_dst_height, p_dst_width, [&](uint32_t p_from, uint32_t p_to) {
+		_scale_lanczos_rows<CC, T>(buffer, p_dst, p_src_height, p_dst_width, p_dst_height, p_from, p_to);
+	});
 
 	memdelete_arr(buffer);
 }
@@ -1652,23 +1742,86 @@ bool Image::_can_modify(Format p_format) const {
 	return p_format <= FORMAT_RGBE9995;
 }
 
+// Averages 2x2 blocks of RGBA8 or RGBAF pixels from two rows, returning how many destination
+// pixels were written. Results are bit-identical to average_4_uint8() and average_4_float().
+template <class Component>
+static uint32_t _average_4_row_simd(const Component *p_up, const Component *p_down, Component *p_dst, uint32_t p_count) {
+	return 0;
+}
+
+static uint32_t _average_4_row_simd(const uint8_t *p_up, const uint8_t *p_down, uint8_t *p_dst, uint32_t p_count) {
+	uint32_t done = 0;
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+	for (; done + 2 <= p_count; done += 2) {
+		__m128i up = _mm_loadu_si128((const __m128i *)(p_up + done * 8));
+		__m128i down = _mm_loadu_si128((const __m128i *)(p_down + done * 8));
+		// Source pixels 0 and 1 in lo, 2 and 3 in hi, widened to 16 bits.
+		__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(up, zero), _mm_unpacklo_epi8(down, zero));
+		__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(up, zero), _mm_unpackhi_epi8(down, zero));
+		__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+		_mm_storel_epi64((__m128i *)(p_dst + done * 4), _mm_packus_epi16(sum, sum));
+	}
+#elif defined(__ARM_NEON)
+	for (; done + 2 <= p_count; done += 2) {
+		uint8x16_t up = vld1q_u8(p_up + done * 8);
+		uint8x16_t down = vld1q_u8(p_down + done * 8);
+		uint16x8_t lo = vaddl_u8(vget_low_u8(up), vget_low_u8(down));
+		uint16x8_t hi = vaddl_u8(vget_high_u8(up), vget_high_u8(down));
+		uint16x8_t sum = vaddq_u16(vcombine_u16(vget_low_u16(lo), vget_low_u16(hi)), vcombine_u16(vget_high_u16(lo), vget_high_u16(hi)));
+		vst1_u8(p_dst + done * 4, vrshrn_n_u16(sum, 2));
+	}
+#endif
+	return done;
+}
+
+static uint32_t _average_4_row_simd(const float *p_up, const float *p_down, float *p_dst, uint32_t p_count) {
+	uint32_t done = 0;
+#ifdef __SSE2__
+	const __m128 quarter = _mm_set1_ps(0.25f);
+	for (; done < p_count; done++) {
+		__m128 sum = _mm_add_ps(_mm_loadu_ps(p_up + done * 8), _mm_loadu_ps(p_up + done * 8 + 4));
+		sum = _mm_add_ps(_mm_add_ps(sum, _mm_loadu_ps(p_down + done * 8)), _mm_loadu_ps(p_down + done * 8 + 4));
+		_mm_storeu_ps(p_dst + done * 4, _mm_mul_ps(sum, quarter));
+	}
+#elif defined(__ARM_NEON)
+	for (; done < p_count; done++) {
+		float32x4_t sum = vaddq_f32(vld1q_f32(p_up + done * 8), vld1q_f32(p_up + done * 8 + 4));
+		sum = vaddq_f32(vaddq_f32(sum, vld1q_f32(p_down + done * 8)), vld1q_f32(p_down + done * 8 + 4));
+		vst1q_f32(p_dst + done * 4, vmulq_n_f32(sum, 0.25f));
+	}
+#endif
+	return done;
+}
+
 template <class Component, int CC, bool renormalize,
 		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
 		void (*renormalize_func)(Component *)>
-static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+static void _generate_po2_mipmap_rows(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height, uint32_t p_row_from, uint32_t p_row_to) {
 	//fast power of 2 mipmap generation
 	uint32_t dst_w = MAX(p_width >> 1, 1u);
-	uint32_t dst_h = MAX(p_height >> 1, 1u);
 
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
+	for (uint32_t i = p_row_from; i < p_row_to; i++) {
 		const Component *rup_ptr = &p_src[i * 2 * down_step];
 		const Component *rdown_ptr = rup_ptr + down_step;
 		Component *dst_ptr = &p_dst[i * dst_w * CC];
 		uint32_t count = dst_w;
 
+		if constexpr (CC == 4 && !renormalize) {
+			if (right_step != 0) {
+				uint32_t done = _average_4_row_simd(rup_ptr, rdown_ptr, dst_ptr, count);
+				count -= done;
+				dst_ptr += done * CC;
+				rup_ptr += done * right_step * 2;
+				rdown_ptr += done * right_step * 2;
+			}
+		}
+
 		while (count) {
 			count--;
 			for (int j = 0; j < CC; j++) {
@@ -1686,6 +1839,18 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	}
 }
 
+template <class Component, int CC, bool renormalize,
+		void (*average_func)(Component &, const Component &, const Component &, const Component &, const Component &),
+		void (*renormalize_func)(Component *)>
+static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint32_t p_width, uint32_t p_height) {
+	uint32_t dst_w = MAX(p_width >> 1, 1u);
+	uint32_t dst_h = MAX(p_height >> 1, 1u);
+
+	_process_rows(dst_h, dst_w, [&](uint32_t p_from, uint32_t p_to) {
+		_generate_po2_mipmap_rows<Component, CC, renormalize, average_func, renormalize_func>(p_src, p_dst, p_width, p_height, p_from, p_to);
+	});
+}
+
 void Image::shrink_x2() {
 	ERR_FAIL_COND(data.size() == 0);
 
@@ -3682,25 +3847,69 @@ void Image::srgb_to_linear() {
 
 	ERR_FAIL_COND(format != FORMAT_RGB8 && format != FORMAT_RGBA8);
 
+	// Pixels are processed as a flat array (mipmaps included), in chunks of 4096.
+	const uint32_t chunk_size = 4096;
+
 	if (format == FORMAT_RGBA8) {
-		int len = data.size() / 4;
+		uint32_t len = data.size() / 4;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i << 2) + 0] = srgb2lin[data_ptr[(i << 2) + 0]];
-			data_ptr[(i << 2) + 1] = srgb2lin[data_ptr[(i << 2) + 1]];
-			data_ptr[(i << 2) + 2] = srgb2lin[data_ptr[(i << 2) + 2]];
-		}
+		_process_rows((len + chunk_size - 1) / chunk_size, chunk_size, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from * chunk_size; i < MIN(p_to * chunk_size, len); i++) {
+				data_ptr[(i << 2) + 0] = srgb2lin[data_ptr[(i << 2) + 0]];
+				data_ptr[(i << 2) + 1] = srgb2lin[data_ptr[(i << 2) + 1]];
+				data_ptr[(i << 2) + 2] = srgb2lin[data_ptr[(i << 2) + 2]];
+			}
+		});
 
 	} else if (format == FORMAT_RGB8) {
-		int len = data.size() / 3;
+		uint32_t len = data.size() / 3;
 		uint8_t *data_ptr = data.ptrw();
 
-		for (int i = 0; i < len; i++) {
-			data_ptr[(i * 3) + 0] = srgb2lin[data_ptr[(i * 3) + 0]];
-			data_ptr[(i * 3) + 1] = srgb2lin[data_ptr[(i * 3) + 1]];
-			data_ptr[(i * 3) + 2] = srgb2lin[data_ptr[(i * 3) + 2]];
+		_process_rows((len + chunk_size - 1) / chunk_size, chunk_size, [&](uint32_t p_from, uint32_t p_to) {
+			for (uint32_t i = p_from * chunk_size; i < MIN(p_to * chunk_size, len); i++) {
+				data_ptr[(i * 3) + 0] = srgb2lin[data_ptr[(i * 3) + 0]];
+				data_ptr[(i * 3) + 1] = srgb2lin[data_ptr[(i * 3) + 1]];
+				data_ptr[(i * 3) + 2] = srgb2lin[data_ptr[(i * 3) + 2]];
+			}
+		});
+	}
+}
+
+static void _premultiply_alpha_rgba8(uint8_t *p_data, uint32_t p_pixel_count) {
+	uint32_t i = 0;
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i bias = _mm_set1_epi16(255);
+	const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+	for (; i + 4 <= p_pixel_count; i += 4) {
+		__m128i pixels = _mm_loadu_si128((const __m128i *)(p_data + i * 4));
+		__m128i lo = _mm_unpacklo_epi8(pixels, zero);
+		__m128i hi = _mm_unpackhi_epi8(pixels, zero);
+		__m128i lo_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(lo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i hi_alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(hi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, lo_alpha), bias), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, hi_alpha), bias), 8);
+		// Keep the original alpha.
+		__m128i result = _mm_or_si128(_mm_andnot_si128(alpha_mask, _mm_packus_epi16(lo, hi)), _mm_and_si128(alpha_mask, pixels));
+		_mm_storeu_si128((__m128i *)(p_data + i * 4), result);
+	}
+#elif defined(__ARM_NEON)
+	const uint16x8_t bias = vdupq_n_u16(255);
+	for (; i + 8 <= p_pixel_count; i += 8) {
+		uint8x8x4_t pixels = vld4_u8(p_data + i * 4);
+		for (int c = 0; c < 3; c++) {
+			pixels.val[c] = vshrn_n_u16(vaddq_u16(vmull_u8(pixels.val[c], pixels.val[3]), bias), 8);
 		}
+		vst4_u8(p_data + i * 4, pixels);
+	}
+#endif
+	for (; i < p_pixel_count; i++) {
+		uint8_t *ptr = &p_data[i * 4];
+
+		ptr[0] = (uint16_t(ptr[0]) * uint16_t(ptr[3]) + 255U) >> 8;
+		ptr[1] = (uint16_t(ptr[1]) * uint16_t(ptr[3]) + 255U) >> 8;
+		ptr[2] = (uint16_t(ptr[2]) * uint16_t(ptr[3]) + 255U) >> 8;
 	}
 }
 
@@ -3715,15 +3924,9 @@ void Image::premultiply_alpha() {
 
 	uint8_t *data_ptr = data.ptrw();
 
-	for (int i = 0; i < height; i++) {
-		for (int j = 0; j < width; j++) {
-			uint8_t *ptr = &data_ptr[(i * width + j) * 4];
-
-			ptr[0] = (uint16_t(ptr[0]) * uint16_t(ptr[3]) + 255U) >> 8;
-			ptr[1] = (uint16_t(ptr[1]) * uint16_t(ptr[3]) + 255U) >> 8;
-			ptr[2] = (uint16_t(ptr[2]) * uint16_t(ptr[3]) + 255U) >> 8;
-		}
-	}
+	_process_rows(height, width, [&](uint32_t p_from, uint32_t p_to) {
+		_premultiply_alpha_rgba8(&data_ptr[p_from * width * 4], (p_to - p_from) * width);
+	});
 }
 
 void Image::fix_alpha_edges() {
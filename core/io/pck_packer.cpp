@@ -32,10 +32,18 @@
 
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/version.h"
 
+static Vector<uint8_t> _get_md5(const Vector<uint8_t> &p_data) {
+	Vector<uint8_t> md5;
+	md5.resize(16);
+	CryptoCore::md5(p_data.ptr(), p_data.size(), md5.ptrw());
+	return md5;
+}
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -48,7 +56,8 @@ static int _get_pad(int p_alignment, int p_n) {
 
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt", "compress"), &PCKPacker::add_file, DEFVAL(false), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("train_compression_dictionary", "max_size"), &PCKPacker::train_compression_dictionary, DEFVAL(112640));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -82,6 +91,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 		key.write[i] = v;
 	}
 	enc_dir = p_encrypt_directory;
+	_clear_dictionary();
 
 	file = FileAccess::open(p_file, FileAccess::WRITE);
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, "Can't open file to write: " + String(p_file) + ".");
@@ -89,7 +99,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	file->store_32(PACK_FORMAT_VERSION_UNCOMPRESSED); // Updated by flush() if files are compressed.
 	file->store_32(VERSION_MAJOR);
 	file->store_32(VERSION_MINOR);
 	file->store_32(VERSION_PATCH);
@@ -101,69 +111,19 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment, const String &
 	file->store_32(pack_flags); // flags
 
 	files.clear();
-	ofs = 0;
 
 	return OK;
 }
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
-	if (f.is_null()) {
-		return ERR_FILE_CANT_OPEN;
-	}
-
-	File pf;
-	// Simplify path here and on every 'files' access so that paths that have extra '/'
-	// symbols in them still match to the MD5 hash for the saved path.
-	pf.path = p_file.simplify_path();
-	pf.src_path = p_src;
-	pf.ofs = ofs;
-	pf.size = f->get_length();
-
-	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_src);
-	{
-		unsigned char hash[16];
-		CryptoCore::md5(data.ptr(), data.size(), hash);
-		pf.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			pf.md5.write[i] = hash[i];
-		}
-	}
-	pf.encrypted = p_encrypt;
-
-	uint64_t _size = pf.size;
-	if (p_encrypt) { // Add encryption overhead.
-		if (_size % 16) { // Pad to encryption block size.
-			_size += 16 - (_size % 16);
-		}
-		_size += 16; // hash
-		_size += 8; // data size
-		_size += 16; // iv
-	}
-
-	int pad = _get_pad(alignment, ofs + _size);
-	ofs = ofs + _size + pad;
-
-	files.push_back(pf);
-
-	return OK;
+static Vector<uint8_t> _compress_file(const Vector<uint8_t> &p_data, const String &p_zstd_dictionary) {
+	return FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_COMPRESSED_FILE_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSION_BLOCK_SIZE, p_zstd_dictionary);
 }
 
-Error PCKPacker::flush(bool p_verbose) {
-	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
-
-	int64_t file_base_ofs = file->get_position();
-	file->store_64(0); // files base
-
-	for (int i = 0; i < 16; i++) {
-		file->store_32(0); // reserved
-	}
-
-	// write the index
-	file->store_32(files.size());
+Vector<uint8_t> PCKPacker::_get_file_data(const File &p_file) const {
+	return p_file.src_path.is_empty() ? p_file.data : FileAccess::get_file_as_bytes(p_file.src_path);
+}
 
+Error PCKPacker::_store_directory() {
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> fhead = file;
 
@@ -195,14 +155,117 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
-	if (fae.is_valid()) {
-		fhead.unref();
-		fae.unref();
+	return OK;
+}
+
+void PCKPacker::_clear_dictionary() {
+	if (!zstd_dictionary.is_empty()) {
+		Compression::zstd_unregister_dictionary(zstd_dictionary);
+		zstd_dictionary = String();
+	}
+}
+
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_encrypt, bool p_compress) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	Ref<FileAccess> f = FileAccess::open(p_src, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_FILE_CANT_OPEN;
 	}
 
+	File pf;
+	// Simplify path here and on every 'files' access so that paths that have extra '/'
+	// symbols in them still match to the MD5 hash for the saved path.
+	pf.path = p_file.simplify_path();
+	pf.src_path = p_src;
+	pf.size = f->get_length();
+	pf.md5 = _get_md5(FileAccess::get_file_as_bytes(p_src));
+	pf.encrypted = p_encrypt;
+	pf.compress = p_compress && pf.size <= UINT32_MAX;
+
+	files.push_back(pf);
+
+	return OK;
+}
+
+Error PCKPacker::train_compression_dictionary(int p_max_size) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	// Files are compressed in independent blocks, so train on blocks too.
+	// A hundred times the dictionary size is plenty, zstd recommends about that much.
+	const uint64_t max_sample_size = uint64_t(p_max_size) * 100;
+	Vector<Vector<uint8_t>> samples;
+	uint64_t sample_size = 0;
+	bool encrypted = false;
+	for (const File &pf : files) {
+		if (pf.path == PACK_ZSTD_DICTIONARY_PATH) {
+			continue;
+		}
+		encrypted = encrypted || pf.encrypted;
+		if (!pf.compress || sample_size >= max_sample_size) {
+			continue;
+		}
+		Vector<uint8_t> data = _get_file_data(pf);
+		for (int64_t i = 0; i < data.size() && sample_size < max_sample_size; i += PACK_COMPRESSION_BLOCK_SIZE) {
+			samples.push_back(data.slice(i, MIN(i + PACK_COMPRESSION_BLOCK_SIZE, data.size())));
+			sample_size += samples[samples.size() - 1].size();
+		}
+	}
+	ERR_FAIL_COND_V_MSG(samples.is_empty(), ERR_UNCONFIGURED, "No files to compress were added to the PCK.");
+
+	Vector<uint8_t> dictionary = Compression::zstd_train_dictionary(samples, p_max_size);
+	ERR_FAIL_COND_V(dictionary.is_empty(), ERR_CANT_CREATE);
+
+	_clear_dictionary();
+	const String name = "PCKPacker:" + itos(get_instance_id());
+	Error err = Compression::zstd_register_dictionary(name, dictionary);
+	ERR_FAIL_COND_V(err != OK, err);
+	zstd_dictionary = name;
+
+	File pf;
+	pf.path = PACK_ZSTD_DICTIONARY_PATH;
+	pf.size = dictionary.size();
+	pf.md5 = _get_md5(dictionary);
+	// Trained from the file contents, so keep it as private as they are.
+	pf.encrypted = encrypted;
+	pf.data = dictionary;
+
+	for (int i = 0; i < files.size(); i++) {
+		if (files[i].path == PACK_ZSTD_DICTIONARY_PATH) {
+			files.write[i] = pf;
+			return OK;
+		}
+	}
+	files.push_back(pf);
+
+	return OK;
+}
+
+Error PCKPacker::flush(bool p_verbose) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	int64_t file_base_ofs = file->get_position();
+	file->store_64(0); // files base
+
+	for (int i = 0; i < 16; i++) {
+		file->store_32(0); // reserved
+	}
+
+	// write the index
+	file->store_32(files.size());
+
+	// Offsets and compression are only known once the data is written, so the directory is
+	// written again afterwards. Its size doesn't depend on them.
+	int64_t directory_ofs = file->get_position();
+	Error err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+
 	int header_padding = _get_pad(alignment, file->get_position());
 	for (int i = 0; i < header_padding; i++) {
 		file->store_8(Math::rand() % 256);
@@ -216,21 +279,45 @@ Error PCKPacker::flush(bool p_verbose) {
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
+	bool has_compressed = false;
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
-		Ref<FileAccess> src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
+		File &pf = files.write[i];
+		pf.ofs = file->get_position() - file_base;
 
+		Vector<uint8_t> compressed;
+		if (pf.compress) {
+			compressed = _compress_file(_get_file_data(pf), zstd_dictionary);
+		}
+		// Only worth it if it saves space.
+		pf.compressed = !compressed.is_empty() && uint64_t(compressed.size()) < pf.size;
+		has_compressed = has_compressed || pf.compressed;
+
+		Ref<FileAccess> src;
+		uint64_t to_write = pf.size;
+		if (!pf.compressed && !pf.src_path.is_empty()) {
+			src = FileAccess::open(pf.src_path, FileAccess::READ);
+		}
+
+		Ref<FileAccessEncrypted> fae;
 		Ref<FileAccess> ftmp = file;
-		if (files[i].encrypted) {
+		if (pf.encrypted) {
 			fae.instantiate();
 			ERR_FAIL_COND_V(fae.is_null(), ERR_CANT_CREATE);
 
-			Error err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
+			err = fae->open_and_parse(file, key, FileAccessEncrypted::MODE_WRITE_AES256, false);
 			ERR_FAIL_COND_V(err != OK, ERR_CANT_CREATE);
 			ftmp = fae;
 		}
 
+		if (pf.compressed) {
+			ftmp->store_buffer(compressed.ptr(), compressed.size());
+			to_write = 0;
+		} else if (src.is_null()) {
+			ftmp->store_buffer(pf.data.ptr(), pf.data.size());
+			to_write = 0;
+		}
+
 		while (to_write > 0) {
 			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
 			ftmp->store_buffer(buf, read);
@@ -254,8 +341,21 @@ Error PCKPacker::flush(bool p_verbose) {
 		}
 	}
 
-	file.unref();
 	memdelete_arr(buf);
 
+	if (has_compressed) {
+		file->seek(4);
+		file->store_32(PACK_FORMAT_VERSION);
+	}
+	file->seek(directory_ofs);
+	err = _store_directory();
+	ERR_FAIL_COND_V(err != OK, err);
+
+	file.unref();
+
 	return OK;
 }
+
+PCKPacker::~PCKPacker() {
+	_clear_dictionary();
+}
@@ -40,11 +40,12 @@ class PCKPacker : public RefCounted {
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	String zstd_dictionary;
+
 	static void _bind_methods();
 
 	struct File {
@@ -53,16 +54,25 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compress = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
+		Vector<uint8_t> data; // Contents of files created by the packer, which have no source path.
 	};
 	Vector<File> files;
 
+	Vector<uint8_t> _get_file_data(const File &p_file) const;
+	Error _store_directory();
+	void _clear_dictionary();
+
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
+	Error train_compression_dictionary(int p_max_size = 112640);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
+	~PCKPacker();
 };
 
 #endif // PCK_PACKER_H
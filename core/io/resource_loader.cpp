@@ -31,7 +31,9 @@
 #include "resource_loader.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 #include "core/io/file_access.h"
+#include "core/io/json.h"
 #include "core/io/resource_importer.h"
 #include "core/os/condition_variable.h"
 #include "core/os/os.h"
@@ -238,6 +240,16 @@ ResourceLoader::LoadToken::~LoadToken() {
 }
 
 Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	bool trace = load_trace_enabled.is_set() || (EngineDebugger::is_active() && EngineDebugger::is_profiling(SNAME("resource_loader")));
+	LoadTraceEntry trace_entry;
+	if (trace) {
+		trace_entry.path = !p_original_path.is_empty() ? p_original_path : p_path;
+		trace_entry.thread_id = Thread::get_caller_id();
+		trace_entry.parent = load_paths_stack->size() ? load_paths_stack->get(load_paths_stack->size() - 1) : String();
+		trace_entry.depth = load_nesting + load_depth_offset;
+		trace_entry.start_usec = OS::get_singleton()->get_ticks_usec();
+	}
+
 	load_nesting++;
 	if (load_paths_stack->size()) {
 		thread_load_mutex.lock();
@@ -258,6 +270,13 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 		}
 		found = true;
 		res = loader[i]->load(p_path, !p_original_path.is_empty() ? p_original_path : p_path, r_error, p_use_sub_threads, r_progress, p_cache_mode);
+		if (trace) {
+			trace_entry.loader = loader[i]->get_class();
+			if (trace_entry.loader == ResourceFormatLoader::get_class_static()) {
+				// Built-in loaders don't have classes of their own, tell them apart by the format.
+				trace_entry.loader += " (" + p_path.get_extension() + ")";
+			}
+		}
 		if (!res.is_null()) {
 			break;
 		}
@@ -266,6 +285,24 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 	load_paths_stack->resize(load_paths_stack->size() - 1);
 	load_nesting--;
 
+	if (trace) {
+		trace_entry.end_usec = OS::get_singleton()->get_ticks_usec();
+		trace_entry.type = res.is_valid() ? res->get_class() : p_type_hint;
+		if (res.is_valid()) {
+			trace_entry.error = OK;
+		} else {
+			trace_entry.error = r_error && *r_error != OK ? *r_error : (found ? FAILED : ERR_FILE_UNRECOGNIZED);
+		}
+		if (found) {
+			// The size of the file the loader read from, the remapped one for imported resources.
+			Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+			if (f.is_valid()) {
+				trace_entry.bytes = f->get_length();
+			}
+		}
+		_record_load(trace_entry);
+	}
+
 	if (!res.is_null()) {
 		return res;
 	}
@@ -298,30 +335,46 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	if (load_nesting == 0) {
 		load_paths_stack = memnew(Vector<String>);
 
-		if (!load_task.dependent_path.is_empty()) {
-			load_paths_stack->push_back(load_task.dependent_path);
-		}
 		if (!Thread::is_main_thread()) {
 			mq_override = memnew(CallQueue);
 			MessageQueue::set_thread_singleton_override(mq_override);
 			set_current_thread_safe_for_nodes(true);
 		}
-	} else {
-		DEV_ASSERT(load_task.dependent_path.is_empty());
 	}
 	// --
 
+	// Requested from a load on another thread, which this one reports as its parent. A pool thread
+	// may already be in a load of its own here, if it was given this task while waiting.
+	bool has_dependent = !load_task.dependent_path.is_empty();
+	int prev_load_depth_offset = load_depth_offset;
+	if (has_dependent) {
+		load_paths_stack->push_back(load_task.dependent_path);
+		load_depth_offset = load_task.dependent_depth - load_nesting;
+	}
+
 	if (!Thread::is_main_thread()) {
 		set_current_thread_safe_for_nodes(true);
 	}
 
+	if (load_task.schedule_dependencies) {
+		_schedule_dependencies(load_task);
+	}
+
 	Ref<Resource> res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
+	if (has_dependent) {
+		load_paths_stack->resize(load_paths_stack->size() - 1);
+		load_depth_offset = prev_load_depth_offset;
+	}
 	if (mq_override) {
 		mq_override->flush();
 	}
 
 	thread_load_mutex.lock();
 
+	// Released once the lock is no longer held, as the last reference to a token clears its task.
+	Vector<Ref<LoadToken>> dependency_tokens = load_task.dependency_tokens;
+	load_task.dependency_tokens.clear();
+
 	load_task.resource = res;
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
@@ -362,6 +415,8 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 
 	thread_load_mutex.unlock();
 
+	dependency_tokens.clear();
+
 	if (load_nesting == 0) {
 		if (mq_override) {
 			memdelete(mq_override);
@@ -381,6 +436,167 @@ static String _validate_local_path(const String &p_path) {
 	}
 }
 
+void ResourceLoader::_collect_dependencies(const String &p_path, int p_depth, HashSet<String> &r_visited, Vector<ScheduledDependency> &r_dependencies) {
+	List<String> dependencies;
+	get_dependencies(p_path, &dependencies, true);
+	// Loads are traced with the path they read from, so is the one asking for these.
+	String dependent_path = _path_remap(p_path);
+
+	for (const String &E : dependencies) {
+		// Formatted as "path::type", or "uid::type::fallback_path".
+		Vector<String> parts = E.split("::");
+		String path = parts[0];
+		String type = parts.size() > 1 ? parts[1] : String();
+		if (path.begins_with("uid://")) {
+			ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(path);
+			if (ResourceUID::get_singleton()->has_id(uid)) {
+				path = ResourceUID::get_singleton()->get_id_path(uid);
+			} else if (parts.size() > 2) {
+				path = parts[2];
+			} else {
+				continue;
+			}
+		}
+		path = _validate_local_path(path);
+
+		if (r_visited.has(path)) {
+			continue;
+		}
+		r_visited.insert(path);
+		if (ResourceCache::has(path)) {
+			continue;
+		}
+
+		_collect_dependencies(path, p_depth + 1, r_visited, r_dependencies);
+
+		ScheduledDependency dependency;
+		dependency.path = path;
+		dependency.type = type;
+		dependency.dependent_path = dependent_path;
+		dependency.depth = p_depth;
+		r_dependencies.push_back(dependency);
+	}
+}
+
+// Loaders only discover the dependencies of a resource once they start loading it, so each level
+// of a deep dependency tree waits for the one above. Reading the dependency lists from the file
+// headers up front lets the whole tree load in parallel, deepest dependencies first.
+void ResourceLoader::_schedule_dependencies(ThreadLoadTask &p_load_task) {
+	HashSet<String> visited;
+	visited.insert(p_load_task.local_path);
+	Vector<ScheduledDependency> dependencies;
+	// Called right before the load of the task itself, which is one level above its dependencies.
+	_collect_dependencies(p_load_task.local_path, load_nesting + load_depth_offset + 1, visited, dependencies);
+
+	Vector<Ref<LoadToken>> tokens;
+	for (const ScheduledDependency &E : dependencies) {
+		// The loaders get the same tokens back when they reach these dependencies.
+		Ref<LoadToken> token = _load_start(E.path, E.type, LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE, false, E.dependent_path, E.depth);
+		if (token.is_valid()) {
+			tokens.push_back(token);
+		}
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	p_load_task.dependency_tokens = tokens;
+}
+
+void ResourceLoader::_record_load(const LoadTraceEntry &p_entry) {
+	if (EngineDebugger::is_active() && EngineDebugger::is_profiling(SNAME("resource_loader"))) {
+		Array data;
+		data.push_back(p_entry.path);
+		data.push_back(p_entry.type);
+		data.push_back(p_entry.loader);
+		data.push_back(p_entry.bytes);
+		data.push_back(p_entry.thread_id);
+		data.push_back(p_entry.start_usec);
+		data.push_back(p_entry.end_usec);
+		data.push_back(p_entry.parent);
+		data.push_back(p_entry.depth);
+		data.push_back(p_entry.error);
+		EngineDebugger::profiler_add_frame_data(SNAME("resource_loader"), data);
+	}
+
+	MutexLock thread_load_lock(thread_load_mutex);
+	if (load_trace_enabled.is_set()) {
+		load_trace.push_back(p_entry);
+	}
+}
+
+void ResourceLoader::set_load_trace_enabled(bool p_enabled) {
+	load_trace_enabled.set_to(p_enabled);
+}
+
+bool ResourceLoader::is_load_trace_enabled() {
+	return load_trace_enabled.is_set();
+}
+
+Vector<ResourceLoader::LoadTraceEntry> ResourceLoader::get_load_trace() {
+	MutexLock thread_load_lock(thread_load_mutex);
+	return load_trace;
+}
+
+void ResourceLoader::clear_load_trace() {
+	MutexLock thread_load_lock(thread_load_mutex);
+	load_trace.clear();
+}
+
+Error ResourceLoader::save_load_trace(const String &p_path) {
+	Vector<LoadTraceEntry> trace = get_load_trace();
+
+	// Thread IDs are opaque and large, number them in order of appearance instead.
+	HashMap<Thread::ID, int> thread_indices;
+	thread_indices[Thread::get_main_id()] = 0;
+
+	Array events;
+	for (const LoadTraceEntry &E : trace) {
+		if (!thread_indices.has(E.thread_id)) {
+			thread_indices.insert(E.thread_id, thread_indices.size());
+		}
+
+		Dictionary args;
+		args["loader"] = E.loader;
+		args["bytes"] = E.bytes;
+		args["parent"] = E.parent;
+		args["depth"] = E.depth;
+		args["error"] = E.error;
+
+		Dictionary event;
+		event["name"] = E.path;
+		event["cat"] = E.type;
+		event["ph"] = "X";
+		event["ts"] = E.start_usec;
+		event["dur"] = E.end_usec - E.start_usec;
+		event["pid"] = 0;
+		event["tid"] = thread_indices[E.thread_id];
+		event["args"] = args;
+		events.push_back(event);
+	}
+
+	for (const KeyValue<Thread::ID, int> &E : thread_indices) {
+		Dictionary args;
+		args["name"] = E.value == 0 ? String("Main thread") : vformat("Thread %d", E.value);
+
+		Dictionary event;
+		event["name"] = "thread_name";
+		event["ph"] = "M";
+		event["pid"] = 0;
+		event["tid"] = E.value;
+		event["args"] = args;
+		events.push_back(event);
+	}
+
+	Dictionary json;
+	json["traceEvents"] = events;
+	json["displayTimeUnit"] = "ms";
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Cannot save resource load trace to file '" + p_path + "'.");
+	f->store_string(JSON::stringify(json));
+	return OK;
+}
+
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
 	thread_load_mutex.lock();
 	if (user_load_tokens.has(p_path)) {
@@ -392,7 +608,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, p_use_sub_threads);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
@@ -423,7 +639,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_schedule_dependencies, const String &p_dependent_path, int p_dependent_depth) {
 	String local_path = _validate_local_path(p_path);
 
 	Ref<LoadToken> load_token;
@@ -460,6 +676,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.schedule_dependencies = p_schedule_dependencies;
 			if (p_cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -489,6 +706,14 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (run_on_current_thread) {
 			load_task_ptr->thread_id = Thread::get_caller_id();
 		} else {
+			if (!p_dependent_path.is_empty()) {
+				// Started ahead of the load that will ask for it.
+				load_task_ptr->dependent_path = p_dependent_path;
+				load_task_ptr->dependent_depth = p_dependent_depth;
+			} else if (load_nesting > 0) {
+				load_task_ptr->dependent_path = load_paths_stack->get(load_paths_stack->size() - 1);
+				load_task_ptr->dependent_depth = load_nesting + load_depth_offset;
+			}
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
 		}
 	}
@@ -1176,6 +1401,7 @@ bool ResourceLoader::timestamp_on_load = false;
 thread_local int ResourceLoader::load_nesting = 0;
 thread_local WorkerThreadPool::TaskID ResourceLoader::caller_task_id = 0;
 thread_local Vector<String> *ResourceLoader::load_paths_stack;
+thread_local int ResourceLoader::load_depth_offset = 0;
 
 template <>
 thread_local uint32_t SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::count = 0;
@@ -1185,6 +1411,9 @@ bool ResourceLoader::cleaning_tasks = false;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
+SafeFlag ResourceLoader::load_trace_enabled;
+Vector<ResourceLoader::LoadTraceEntry> ResourceLoader::load_trace;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
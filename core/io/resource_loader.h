@@ -126,7 +126,20 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
+	struct LoadTraceEntry {
+		String path;
+		String type;
+		String loader;
+		uint64_t bytes = 0;
+		Thread::ID thread_id = 0;
+		uint64_t start_usec = 0;
+		uint64_t end_usec = 0;
+		String parent; // Resource whose loader requested this one, empty for top-level loads.
+		int depth = 0;
+		Error error = OK;
+	};
+
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_schedule_dependencies = false, const String &p_dependent_path = String(), int p_dependent_depth = 0);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -166,7 +179,8 @@ private:
 		LoadToken *load_token = nullptr;
 		String local_path;
 		String remapped_path;
-		String dependent_path;
+		String dependent_path; // Load that requested this one from another thread.
+		int dependent_depth = 0; // Trace depth of the loads below dependent_path.
 		String type_hint;
 		float progress = 0.0;
 		ThreadLoadStatus status = THREAD_LOAD_IN_PROGRESS;
@@ -175,20 +189,37 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
+		bool schedule_dependencies = false;
 		HashSet<String> sub_tasks;
+		Vector<Ref<LoadToken>> dependency_tokens; // Keeps the loads started by _schedule_dependencies() alive.
+	};
+
+	struct ScheduledDependency {
+		String path;
+		String type;
+		String dependent_path; // Load that will ask for it, its parent in the load trace.
+		int depth = 0;
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _collect_dependencies(const String &p_path, int p_depth, HashSet<String> &r_visited, Vector<ScheduledDependency> &r_dependencies);
+	static void _schedule_dependencies(ThreadLoadTask &p_load_task);
 
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
 	static thread_local Vector<String> *load_paths_stack; // A pointer to avoid broken TLS implementations from double-running the destructor.
+	static thread_local int load_depth_offset; // Added to load_nesting for the trace depth of loads started from another thread.
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
 	static bool cleaning_tasks;
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
+	static SafeFlag load_trace_enabled;
+	static Vector<LoadTraceEntry> load_trace;
+
+	static void _record_load(const LoadTraceEntry &p_entry);
+
 	static float _dependency_get_progress(const String &p_path);
 
 public:
@@ -198,6 +229,14 @@ public:
 
 	static bool is_within_load() { return load_nesting > 0; };
 
+	// Records when each resource load started and finished, and on which thread.
+	// The same data is streamed to the "resource_loader" debugger profiler while it is active.
+	static void set_load_trace_enabled(bool p_enabled);
+	static bool is_load_trace_enabled();
+	static Vector<LoadTraceEntry> get_load_trace();
+	static void clear_load_trace();
+	static Error save_load_trace(const String &p_path); // Chrome trace event format.
+
 	static Ref<Resource> load(const String &p_path, const String &p_type_hint = "", ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
@@ -386,6 +386,34 @@ bool DynamicBVH::update(const ID &p_id, const AABB &p_box) {
 	return true;
 }
 
+void DynamicBVH::update_batch(const ID *p_ids, const AABB *p_boxes, uint32_t p_count) {
+	// Take out every leaf that moved before reinserting any of them, so each one is placed
+	// against the final volumes of the others instead of their stale ones.
+	LocalVector<Node *> moved;
+	moved.reserve(p_count);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		ERR_CONTINUE(!p_ids[i].is_valid());
+		Node *leaf = p_ids[i].node;
+
+		Volume volume;
+		volume.min = p_boxes[i].position;
+		volume.max = p_boxes[i].position + p_boxes[i].size;
+
+		if (leaf->volume.min.is_equal_approx(volume.min) && leaf->volume.max.is_equal_approx(volume.max)) {
+			continue;
+		}
+
+		_remove_leaf(leaf);
+		leaf->volume = volume;
+		moved.push_back(leaf);
+	}
+
+	for (Node *leaf : moved) {
+		_insert_leaf(bvh_root, leaf);
+	}
+}
+
 void DynamicBVH::remove(const ID &p_id) {
 	ERR_FAIL_COND(!p_id.is_valid());
 	Node *leaf = p_id.node;
@@ -194,6 +194,10 @@ public:
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	// Returns the index of the calling thread in the pool, or -1 if it is not a pool thread.
+	// Code that can run on a pool thread should do its work serially rather than add tasks and
+	// wait for them there: if every worker ends up blocked in such a wait, none is left to run them.
+	int get_thread_index() const;
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
@@ -43,6 +43,7 @@
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/input/shortcut.h"
+#include "core/io/compression.h"
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
@@ -422,6 +423,8 @@ void unregister_core_types() {
 
 	ResourceLoader::finalize();
 
+	Compression::zstd_clear_dictionaries();
+
 	ClassDB::cleanup_defaults();
 	ObjectDB::cleanup();
 
@@ -70,14 +70,256 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	return &sync_sems[idx];
 }
 
+SafeNumeric<uint64_t> CommandQueueMT::queue_id_counter;
+thread_local uint64_t CommandQueueMT::tls_queue_id = 0;
+thread_local CommandQueueMT::ThreadBuffer *CommandQueueMT::tls_thread_buffer = nullptr;
+thread_local CommandQueueMT::ThreadBufferOwner CommandQueueMT::tls_thread_buffer_owner;
+
+CommandQueueMT::ThreadBufferOwner::~ThreadBufferOwner() {
+	for (ThreadBuffer *tb : buffers) {
+		// Whatever the thread committed stays queued, the buffer is only recycled once that is flushed.
+		tb->state.store(ThreadBuffer::STATE_EXITED, std::memory_order_release);
+		_unref_thread_buffer(tb);
+	}
+}
+
+void CommandQueueMT::_unref_thread_buffer(ThreadBuffer *p_buffer) {
+	if (p_buffer->refcount.unref()) {
+		memdelete(p_buffer);
+	}
+}
+
+CommandQueueMT::ThreadBufferChunk *CommandQueueMT::_alloc_thread_buffer_chunk(uint32_t p_capacity) {
+	size_t header_size = (sizeof(ThreadBufferChunk) + 15) & ~15;
+	void *mem = memalloc(header_size + p_capacity);
+	ThreadBufferChunk *chunk = memnew_placement(mem, ThreadBufferChunk);
+	chunk->capacity = p_capacity;
+	return chunk;
+}
+
+CommandQueueMT::ThreadBuffer *CommandQueueMT::_find_thread_buffer(bool p_create) {
+	if (tls_queue_id == queue_id) {
+		return tls_thread_buffer;
+	}
+
+	Thread::ID thread_id = Thread::get_caller_id();
+	ThreadBuffer *tb = thread_buffers.load(std::memory_order_acquire);
+	while (tb && tb->thread_id.load(std::memory_order_relaxed) != thread_id) {
+		tb = tb->next;
+	}
+
+	if (!tb) {
+		if (!p_create) {
+			return nullptr;
+		}
+
+		// Reuse the buffer of an exited thread if one was released, so the list stays as long as
+		// the most producer threads ever alive at once.
+		for (tb = thread_buffers.load(std::memory_order_acquire); tb; tb = tb->next) {
+			Thread::ID unassigned = Thread::UNASSIGNED_ID;
+			if (tb->state.load(std::memory_order_acquire) == ThreadBuffer::STATE_FREE && tb->thread_id.compare_exchange_strong(unassigned, thread_id, std::memory_order_acq_rel)) {
+				break;
+			}
+		}
+
+		if (tb) {
+			tb->refcount.ref();
+			tb->head = _alloc_thread_buffer_chunk(THREAD_BUFFER_CHUNK_SIZE_KB * 1024);
+			tb->tail = tb->head;
+			tb->state.store(ThreadBuffer::STATE_ACTIVE, std::memory_order_release);
+		} else {
+			tb = memnew(ThreadBuffer);
+			tb->thread_id.store(thread_id, std::memory_order_relaxed);
+			tb->refcount.init(2);
+			tb->head = _alloc_thread_buffer_chunk(THREAD_BUFFER_CHUNK_SIZE_KB * 1024);
+			tb->tail = tb->head;
+
+			ThreadBuffer *first = thread_buffers.load(std::memory_order_relaxed);
+			do {
+				tb->next = first;
+			} while (!thread_buffers.compare_exchange_weak(first, tb, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		tls_thread_buffer_owner.buffers.push_back(tb);
+	}
+
+	tls_queue_id = queue_id;
+	tls_thread_buffer = tb;
+	return tb;
+}
+
+uint8_t *CommandQueueMT::_thread_buffer_reserve(ThreadBuffer *p_buffer, uint32_t p_size) {
+	ThreadBufferChunk *chunk = p_buffer->tail;
+	uint32_t pos = chunk->write_pos.load(std::memory_order_relaxed);
+
+	if (pos + p_size > chunk->capacity) {
+		const uint32_t chunk_size = THREAD_BUFFER_CHUNK_SIZE_KB * 1024;
+		ThreadBufferChunk *new_chunk = nullptr;
+		if (p_size <= chunk_size) {
+			new_chunk = p_buffer->spare.exchange(nullptr, std::memory_order_acq_rel);
+		}
+		if (!new_chunk) {
+			new_chunk = _alloc_thread_buffer_chunk(MAX(p_size, chunk_size));
+		}
+
+		// Everything in the old chunk is committed by now, the consumer can move past it once it sees this.
+		chunk->next.store(new_chunk, std::memory_order_release);
+		p_buffer->tail = new_chunk;
+		chunk = new_chunk;
+		pos = 0;
+	}
+
+	p_buffer->reserved_pos = pos + p_size;
+	return chunk->get_data() + pos;
+}
+
+void CommandQueueMT::_recycle_thread_buffer_chunk(ThreadBuffer *p_buffer, ThreadBufferChunk *p_chunk) {
+	if (p_chunk->capacity != THREAD_BUFFER_CHUNK_SIZE_KB * 1024) {
+		memfree(p_chunk);
+		return;
+	}
+
+	p_chunk->write_pos.store(0, std::memory_order_relaxed);
+	p_chunk->next.store(nullptr, std::memory_order_relaxed);
+	ThreadBufferChunk *old_spare = p_buffer->spare.exchange(p_chunk, std::memory_order_acq_rel);
+	if (old_spare) {
+		memfree(old_spare);
+	}
+}
+
+void CommandQueueMT::_flush_thread_buffer(ThreadBuffer *p_buffer, uint64_t p_up_to) {
+	while (p_buffer->consumed < p_up_to) {
+		ThreadBufferChunk *chunk = p_buffer->head;
+		uint32_t end = chunk->write_pos.load(std::memory_order_acquire);
+
+		if (p_buffer->read_pos == end) {
+			ThreadBufferChunk *next = chunk->next.load(std::memory_order_acquire);
+			if (!next) {
+				break; // Nothing else committed.
+			}
+			if (chunk->write_pos.load(std::memory_order_acquire) != end) {
+				continue; // Committed right before the producer moved to the next chunk.
+			}
+			p_buffer->head = next;
+			p_buffer->read_pos = 0;
+			_recycle_thread_buffer_chunk(p_buffer, chunk);
+			continue;
+		}
+
+		uint8_t *data = chunk->get_data();
+		uint64_t size = *(uint64_t *)&data[p_buffer->read_pos];
+		CommandBase *cmd = reinterpret_cast<CommandBase *>(&data[p_buffer->read_pos + 8]);
+
+		cmd->call();
+		cmd->~CommandBase();
+
+		p_buffer->read_pos += 8 + size;
+		p_buffer->consumed++;
+	}
+}
+
+void CommandQueueMT::_release_thread_buffer(ThreadBuffer *p_buffer) {
+	ThreadBufferChunk *chunk = p_buffer->head;
+	while (chunk) {
+		ThreadBufferChunk *next = chunk->next.load(std::memory_order_acquire);
+		memfree(chunk);
+		chunk = next;
+	}
+	ThreadBufferChunk *spare = p_buffer->spare.exchange(nullptr, std::memory_order_acq_rel);
+	if (spare) {
+		memfree(spare);
+	}
+
+	p_buffer->head = nullptr;
+	p_buffer->tail = nullptr;
+	p_buffer->reserved_pos = 0;
+	p_buffer->pushed = 0;
+	p_buffer->read_pos = 0;
+	p_buffer->consumed = 0;
+	p_buffer->markers_pushed = 0;
+	p_buffer->markers_executed = 0;
+
+	p_buffer->state.store(ThreadBuffer::STATE_FREE, std::memory_order_release);
+	p_buffer->thread_id.store(Thread::UNASSIGNED_ID, std::memory_order_release);
+}
+
+void CommandQueueMT::flush_thread_buffers() {
+	lock();
+
+	// Pairs with the fence in _thread_buffer_commit().
+	thread_buffers_pending.store(false, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	bool left_pending = false;
+	for (ThreadBuffer *tb = thread_buffers.load(std::memory_order_acquire); tb; tb = tb->next) {
+		ThreadBuffer::State state = tb->state.load(std::memory_order_acquire);
+		if (state == ThreadBuffer::STATE_FREE) {
+			continue;
+		}
+		if (tb->markers_pushed != tb->markers_executed) {
+			// Commands after the last pending marker must wait until the shared queue reaches it,
+			// everything before it will be flushed by the markers themselves.
+			left_pending = true;
+			continue;
+		}
+		_flush_thread_buffer(tb, UINT64_MAX);
+
+		if (state == ThreadBuffer::STATE_EXITED && tb->consumed == tb->pushed) {
+			_release_thread_buffer(tb);
+		}
+	}
+
+	if (left_pending) {
+		thread_buffers_pending.store(true, std::memory_order_release);
+	}
+
+	unlock();
+}
+
+uint32_t CommandQueueMT::get_thread_buffer_count() const {
+	uint32_t count = 0;
+	for (ThreadBuffer *tb = thread_buffers.load(std::memory_order_acquire); tb; tb = tb->next) {
+		count++;
+	}
+	return count;
+}
+
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	}
+	queue_id = queue_id_counter.increment();
 }
 
 CommandQueueMT::~CommandQueueMT() {
 	if (sync) {
 		memdelete(sync);
 	}
+
+	ThreadBuffer *tb = thread_buffers.load(std::memory_order_acquire);
+	while (tb) {
+		// Discard commands that were never flushed.
+		ThreadBufferChunk *chunk = tb->head;
+		uint32_t read_pos = tb->read_pos;
+		while (chunk) {
+			uint32_t end = chunk->write_pos.load(std::memory_order_acquire);
+			while (read_pos < end) {
+				uint64_t size = *(uint64_t *)&chunk->get_data()[read_pos];
+				reinterpret_cast<CommandBase *>(&chunk->get_data()[read_pos + 8])->~CommandBase();
+				read_pos += 8 + size;
+			}
+			ThreadBufferChunk *next = chunk->next.load(std::memory_order_acquire);
+			memfree(chunk);
+			chunk = next;
+			read_pos = 0;
+		}
+		ThreadBufferChunk *spare = tb->spare.load(std::memory_order_acquire);
+		if (spare) {
+			memfree(spare);
+		}
+
+		ThreadBuffer *next = tb->next;
+		_unref_thread_buffer(tb);
+		tb = next;
+	}
 }
@@ -34,11 +34,16 @@
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
 #include "core/os/semaphore.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+#include <type_traits>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -296,6 +301,21 @@
 		ss->in_use = false;                                                           \
 	}
 
+#define DECL_PUSH_BUFFERED(N)                                                         \
+	template <class T, class M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>                \
+	void push_buffered(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		ThreadBuffer *tb = thread_buffers_enabled ? _get_thread_buffer() : nullptr;   \
+		if (!tb) {                                                                    \
+			push(p_instance, p_method COMMA(N) COMMA_SEP_LIST(ARG, N));               \
+			return;                                                                   \
+		}                                                                             \
+		CMD_TYPE(N) *cmd = _thread_buffer_allocate<CMD_TYPE(N)>(tb);                  \
+		cmd->instance = p_instance;                                                   \
+		cmd->method = p_method;                                                       \
+		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
+		_thread_buffer_commit(tb);                                                    \
+	}
+
 #define MAX_CMD_PARAMS 15
 
 class CommandQueueMT {
@@ -341,6 +361,137 @@ class CommandQueueMT {
 	Mutex mutex;
 	Semaphore *sync = nullptr;
 
+	/***** THREAD BUFFERS *******/
+
+	// Commands pushed with push_buffered() from threads other than the main thread go to a
+	// buffer owned by that thread instead of the shared queue, so producers never take the mutex.
+	// Each buffer is a chain of chunks with a single producer (its thread) and a single consumer
+	// (whoever flushes the queue, always under the mutex), synchronized through atomics only.
+	// Buffered commands run when flush_thread_buffers() is called (usually at frame boundaries),
+	// before any command that returns or syncs, before any other command their own thread pushes
+	// to the shared queue and after any it pushed before, so per-thread ordering is preserved. Commands pushed while buffered
+	// commands are pending, and flush_if_pending() on the server thread, also flush them first, so
+	// whatever a thread buffered before handing work over to another thread is seen by it.
+	// Buffers of exited threads are recycled once drained, so short-lived threads don't add up.
+
+	enum {
+		THREAD_BUFFER_CHUNK_SIZE_KB = 64
+	};
+
+	struct ThreadBufferChunk {
+		std::atomic<uint32_t> write_pos = { 0 }; // Bytes committed by the producer.
+		std::atomic<ThreadBufferChunk *> next = { nullptr }; // Set once the producer moved to another chunk.
+		uint32_t capacity = 0;
+
+		_FORCE_INLINE_ uint8_t *get_data() {
+			return reinterpret_cast<uint8_t *>(this) + ((sizeof(ThreadBufferChunk) + 15) & ~15);
+		}
+	};
+
+	struct ThreadBuffer {
+		enum State {
+			STATE_ACTIVE, // Owned by a running thread.
+			STATE_EXITED, // The owning thread exited, released once drained.
+			STATE_FREE, // Drained and without chunks, can be claimed by another thread.
+		};
+
+		std::atomic<Thread::ID> thread_id = { Thread::UNASSIGNED_ID };
+		std::atomic<State> state = { STATE_ACTIVE };
+		// One reference for the queue and one for the owning thread, whichever releases it last frees it.
+		SafeRefCount refcount;
+		ThreadBuffer *next = nullptr; // Immutable once the buffer is published.
+
+		// Producer side, only touched by the owning thread.
+		ThreadBufferChunk *tail = nullptr;
+		uint32_t reserved_pos = 0;
+		uint64_t pushed = 0;
+
+		// Consumer side, only touched under the queue mutex.
+		ThreadBufferChunk *head = nullptr;
+		uint32_t read_pos = 0;
+		uint64_t consumed = 0;
+		uint32_t markers_pushed = 0;
+		uint32_t markers_executed = 0;
+
+		// Exchanged between both sides, so a chunk is reused instead of reallocated.
+		std::atomic<ThreadBufferChunk *> spare = { nullptr };
+	};
+
+	// Pushed to the shared queue before any other command coming from a thread other than main, so
+	// what it buffered before runs first, and what it buffers after is not flushed until the queue gets there.
+	struct ThreadBufferMarker : public CommandBase {
+		CommandQueueMT *queue = nullptr;
+		ThreadBuffer *buffer = nullptr;
+		uint64_t sequence = 0;
+
+		virtual void call() override {
+			queue->_flush_thread_buffer(buffer, sequence);
+			buffer->markers_executed++;
+		}
+	};
+
+	// Pushed before commands while buffered commands are pending, so they observe everything buffered so far.
+	struct ThreadBufferFlush : public CommandBase {
+		CommandQueueMT *queue = nullptr;
+
+		virtual void call() override {
+			queue->flush_thread_buffers();
+		}
+	};
+
+	// Releases the thread's reference on its buffers when it exits.
+	struct ThreadBufferOwner {
+		LocalVector<ThreadBuffer *> buffers;
+		~ThreadBufferOwner();
+	};
+
+	bool thread_buffers_enabled = false;
+	std::atomic<ThreadBuffer *> thread_buffers = { nullptr };
+	// Set after commands are buffered, cleared when all buffers are flushed.
+	std::atomic<bool> thread_buffers_pending = { false };
+	bool thread_buffer_flush_queued = false; // Under the mutex.
+	uint64_t queue_id = 0;
+
+	static SafeNumeric<uint64_t> queue_id_counter;
+	static thread_local uint64_t tls_queue_id;
+	static thread_local ThreadBuffer *tls_thread_buffer;
+	static thread_local ThreadBufferOwner tls_thread_buffer_owner;
+
+	static ThreadBufferChunk *_alloc_thread_buffer_chunk(uint32_t p_capacity);
+	static void _unref_thread_buffer(ThreadBuffer *p_buffer);
+	ThreadBuffer *_find_thread_buffer(bool p_create);
+	uint8_t *_thread_buffer_reserve(ThreadBuffer *p_buffer, uint32_t p_size);
+	void _recycle_thread_buffer_chunk(ThreadBuffer *p_buffer, ThreadBufferChunk *p_chunk);
+	void _flush_thread_buffer(ThreadBuffer *p_buffer, uint64_t p_up_to);
+	void _release_thread_buffer(ThreadBuffer *p_buffer);
+
+	_FORCE_INLINE_ ThreadBuffer *_get_thread_buffer() {
+		if (Thread::is_main_thread()) {
+			return nullptr;
+		}
+		return _find_thread_buffer(true);
+	}
+
+	template <class T>
+	T *_thread_buffer_allocate(ThreadBuffer *p_buffer) {
+		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
+		uint8_t *mem = _thread_buffer_reserve(p_buffer, alloc_size + 8);
+		*(uint64_t *)mem = alloc_size;
+		T *cmd = memnew_placement(mem + 8, T);
+		return cmd;
+	}
+
+	_FORCE_INLINE_ void _thread_buffer_commit(ThreadBuffer *p_buffer) {
+		p_buffer->tail->write_pos.store(p_buffer->reserved_pos, std::memory_order_release);
+		p_buffer->pushed++;
+		// Pairs with the fence in flush_thread_buffers(): either the flush sees this command,
+		// or this sees the cleared flag and sets it again.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (!thread_buffers_pending.load(std::memory_order_relaxed)) {
+			thread_buffers_pending.store(true, std::memory_order_relaxed);
+		}
+	}
+
 	template <class T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
@@ -352,9 +503,31 @@ class CommandQueueMT {
 		return cmd;
 	}
 
+	void _push_thread_buffer_marker() {
+		if (Thread::is_main_thread()) {
+			return;
+		}
+		// Needed even with nothing buffered yet, commands buffered after this one must not be flushed before it.
+		ThreadBuffer *tb = _find_thread_buffer(true);
+		ThreadBufferMarker *marker = allocate<ThreadBufferMarker>();
+		marker->queue = this;
+		marker->buffer = tb;
+		marker->sequence = tb->pushed;
+		tb->markers_pushed++;
+	}
+
 	template <class T>
 	T *allocate_and_lock() {
 		lock();
+		if (thread_buffers_enabled) {
+			// Goes before the marker, so this thread's buffer is left to the marker and commands it buffers
+			// later don't run ahead of this one. A single flush in the queue runs after every later push too.
+			if (!thread_buffer_flush_queued && thread_buffers_pending.load(std::memory_order_acquire)) {
+				allocate<ThreadBufferFlush>()->queue = this;
+				thread_buffer_flush_queued = true;
+			}
+			_push_thread_buffer_marker();
+		}
 		T *ret = allocate<T>();
 		return ret;
 	}
@@ -378,6 +551,7 @@ class CommandQueueMT {
 		}
 
 		command_mem.clear();
+		thread_buffer_flush_queued = false;
 		unlock();
 	}
 
@@ -399,10 +573,17 @@ public:
 	DECL_PUSH_AND_SYNC(0)
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
+	/* BUFFERED PUSH COMMANDS, FROM THREADS OTHER THAN MAIN */
+	DECL_PUSH_BUFFERED(0)
+	SPACE_SEP_LIST(DECL_PUSH_BUFFERED, 15)
+
 	_FORCE_INLINE_ void flush_if_pending() {
 		if (unlikely(command_mem.size() > 0)) {
 			_flush();
 		}
+		if (unlikely(thread_buffers_pending.load(std::memory_order_acquire))) {
+			flush_thread_buffers();
+		}
 	}
 	void flush_all() {
 		_flush();
@@ -414,6 +595,13 @@ public:
 		_flush();
 	}
 
+	// Only call before any command is pushed.
+	void set_thread_buffers_enabled(bool p_enabled) { thread_buffers_enabled = p_enabled; }
+	bool is_thread_buffers_enabled() const { return thread_buffers_enabled; }
+	void flush_thread_buffers();
+	// Buffers allocated so far, including released ones waiting to be claimed by a new thread.
+	uint32_t get_thread_buffer_count() const;
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
@@ -433,5 +621,6 @@ public:
 #undef DECL_PUSH_AND_RET
 #undef CMD_SYNC_TYPE
 #undef DECL_CMD_SYNC
+#undef DECL_PUSH_BUFFERED
 
 #endif // COMMAND_QUEUE_MT_H
@@ -35,23 +35,17 @@
 #include "core/os/keyboard.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_fill_readahead() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
-		readahead_pointer = 0;
-	} else {
-		// EOF
 		readahead_pointer = 1;
-		eof = true;
-		return 0;
+		return readahead_buffer[0];
 	}
-	return get_char();
+	// EOF
+	readahead_pointer = 1;
+	eof = true;
+	return 0;
 }
 
 bool VariantParser::Stream::is_eof() const {
@@ -155,6 +149,73 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+// Reads the characters of a number starting with p_char into r_num, leaving the first character after it in saved.
+static void _read_number(VariantParser::Stream *p_stream, char32_t p_char, StringBuffer<> &r_num, bool &r_is_float) {
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	char32_t c = p_char;
+	if (c == '-') {
+		r_num += '-';
+		c = p_stream->get_char();
+	}
+
+	bool exp_sign = false;
+	bool exp_beg = false;
+	r_is_float = false;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (is_digit(c)) {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					r_is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					r_is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (is_digit(c)) {
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (is_digit(c)) {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		r_num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -415,69 +476,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					//a number
 
 					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
 					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (is_digit(c)) {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (is_digit(c)) {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (is_digit(c)) {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					_read_number(p_stream, cchar, num, is_float);
 
 					r_token.type = TK_NUMBER;
 
@@ -545,6 +545,28 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &strings,
 	}
 }
 
+// Skips blanks and line breaks, returning the first other character (or 0 at EOF).
+static char32_t _skip_blanks(VariantParser::Stream *p_stream, int &line) {
+	while (true) {
+		char32_t c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+			if (p_stream->is_eof()) {
+				return 0;
+			}
+		}
+
+		if (c == '\n') {
+			line++;
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
 template <class T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str) {
 	Token token;
@@ -554,19 +576,50 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Packed arrays in scenes and resources can hold millions of numbers, so separators and plain
+	// numbers are scanned here directly instead of going through a Variant token each. Anything
+	// else (comments, inf/nan identifiers) is handed back to get_token.
 	bool first = true;
 	while (true) {
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
+			char32_t c = _skip_blanks(p_stream, line);
+			if (c == ',') {
 				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			} else if (c == ')') {
 				break;
 			} else {
-				r_err_str = "Expected ',' or ')' in constructor";
-				return ERR_PARSE_ERROR;
+				if (c == 0) {
+					r_err_str = "Expected ',' or ')' in constructor";
+					return ERR_PARSE_ERROR;
+				}
+				p_stream->saved = c;
+				get_token(p_stream, token, line, r_err_str);
+				if (token.type == TK_COMMA) {
+					//do none
+				} else if (token.type == TK_PARENTHESIS_CLOSE) {
+					break;
+				} else {
+					r_err_str = "Expected ',' or ')' in constructor";
+					return ERR_PARSE_ERROR;
+				}
 			}
 		}
+
+		char32_t c = _skip_blanks(p_stream, line);
+		if (c == '-' || is_digit(c)) {
+			StringBuffer<> num;
+			bool is_float = false;
+			_read_number(p_stream, c, num, is_float);
+			r_construct.push_back(is_float ? (T)num.as_double() : (T)num.as_int());
+			first = false;
+			continue;
+		}
+
+		if (c == 0) {
+			r_err_str = "Expected float in constructor";
+			return ERR_PARSE_ERROR;
+		}
+		p_stream->saved = c;
 		get_token(p_stream, token, line, r_err_str);
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
@@ -1149,17 +1202,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
@@ -1167,17 +1210,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
@@ -1185,17 +1218,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -1203,17 +1226,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
@@ -1221,17 +1234,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
@@ -50,10 +50,18 @@ public:
 		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
 		virtual bool _is_eof() const = 0;
 
+		char32_t _fill_readahead();
+
 	public:
 		char32_t saved = 0;
 
-		char32_t get_char();
+		// Inlined because the tokenizer calls it once per character; only refilling is out of line.
+		_FORCE_INLINE_ char32_t get_char() {
+			if (likely(readahead_pointer < readahead_filled)) {
+				return readahead_buffer[readahead_pointer++];
+			}
+			return _fill_readahead();
+		}
 		virtual bool is_utf8() const = 0;
 		bool is_eof() const;
 
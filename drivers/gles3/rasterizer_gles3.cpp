@@ -36,6 +36,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/os/os.h"
+#include "servers/rendering/shader_compiler.h"
 #include "storage/texture_storage.h"
 
 #define _EXT_DEBUG_OUTPUT_SYNCHRONOUS_ARB 0x8242
@@ -282,6 +283,7 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_cache_dir(shader_cache_dir);
 				}
 			}
 		}
@@ -303,6 +305,7 @@ RasterizerGLES3::RasterizerGLES3() {
 }
 
 RasterizerGLES3::~RasterizerGLES3() {
+	ShaderCompiler::set_cache_dir(String());
 }
 
 void RasterizerGLES3::prepare_for_blitting_render_targets() {
@@ -1154,6 +1154,10 @@ void TextureStorage::texture_set_detect_roughness_callback(RID p_texture, RS::Te
 	texture->detect_roughness_callback_ud = p_userdata;
 }
 
+void TextureStorage::texture_set_streaming_callback(RID p_texture, const Size2i &p_data_size, RS::TextureStreamingCallback p_callback, ObjectID p_owner) {
+	// Texture streaming is not supported by the Compatibility renderer, textures are always fully resident.
+}
+
 void TextureStorage::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 	List<RID> textures;
 	texture_owner.get_owned_list(&textures);
@@ -530,6 +530,7 @@ public:
 	void texture_set_detect_srgb_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata);
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override;
+	virtual void texture_set_streaming_callback(RID p_texture, const Size2i &p_data_size, RS::TextureStreamingCallback p_callback, ObjectID p_owner) override;
 
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override;
 
@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -146,6 +147,21 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 		fcntl(fd, F_SETFD, opts | FD_CLOEXEC);
 	}
 
+#ifndef WEB_ENABLED
+	// Not on the Web, where files live in memory already and mmap() would make a copy of them.
+	if (p_mode_flags == READ && is_memory_map_requested() && fd != -1) {
+		struct stat fst = {};
+		if (fstat(fd, &fst) == 0 && fst.st_size > 0) {
+			void *addr = mmap(nullptr, fst.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (addr != MAP_FAILED) {
+				mapped = (uint8_t *)addr;
+				mapped_size = fst.st_size;
+				mapped_pos = 0;
+			}
+		}
+	}
+#endif
+
 	last_error = OK;
 	flags = p_mode_flags;
 	return OK;
@@ -156,6 +172,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+		mapped_pos = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -191,6 +214,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
 	last_error = OK;
+	if (mapped) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -199,6 +226,11 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
 
+	if (mapped) {
+		last_error = OK;
+		mapped_pos = MAX(int64_t(mapped_size) + p_position, 0);
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -207,6 +239,9 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_pos;
+	}
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -218,6 +253,9 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_size;
+	}
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -234,6 +272,13 @@ bool FileAccessUnix::eof_reached() const {
 
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_COND_V_MSG(!f, 0, "File must be opened before use.");
+	if (mapped) {
+		if (mapped_pos >= mapped_size) {
+			last_error = ERR_FILE_EOF;
+			return 0;
+		}
+		return mapped[mapped_pos++];
+	}
 	uint8_t b;
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
@@ -246,11 +291,28 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_COND_V_MSG(!f, -1, "File must be opened before use.");
 
+	if (mapped) {
+		uint64_t available = mapped_pos < mapped_size ? mapped_size - mapped_pos : 0;
+		uint64_t read = MIN(p_length, available);
+		if (read > 0) {
+			memcpy(p_dst, mapped + mapped_pos, read);
+		}
+		mapped_pos += read;
+		if (read < p_length) {
+			last_error = ERR_FILE_EOF;
+		}
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_data() const {
+	return mapped;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Set when the file is opened read-only through open_mapped(); reads are then served from the mapping.
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_size = 0;
+	mutable uint64_t mapped_pos = 0;
+
 	void _close();
 
 public:
@@ -69,6 +74,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_data() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
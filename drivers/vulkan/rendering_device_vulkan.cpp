@@ -4128,6 +4128,19 @@ RenderingDevice::TextureSamples RenderingDeviceVulkan::framebuffer_format_get_te
 	return E->value.pass_samples[p_pass];
 }
 
+bool RenderingDeviceVulkan::framebuffer_format_get_description(FramebufferFormatID p_format, Vector<AttachmentFormat> &r_attachments, Vector<FramebufferPass> &r_passes, uint32_t &r_view_count) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<FramebufferFormatID, FramebufferFormat>::Iterator E = framebuffer_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, false);
+
+	const FramebufferFormatKey &key = E->value.E->key();
+	r_attachments = key.attachments;
+	r_passes = key.passes;
+	r_view_count = key.view_count;
+	return true;
+}
+
 /***********************/
 /**** RENDER TARGET ****/
 /***********************/
@@ -4408,6 +4421,14 @@ RenderingDevice::VertexFormatID RenderingDeviceVulkan::vertex_format_create(cons
 	return id;
 }
 
+Vector<RenderingDevice::VertexAttribute> RenderingDeviceVulkan::vertex_format_get_attributes(VertexFormatID p_vertex_format) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<VertexFormatID, VertexDescriptionCache>::Iterator E = vertex_formats.find(p_vertex_format);
+	ERR_FAIL_COND_V(!E, Vector<VertexAttribute>());
+	return E->value.vertex_formats;
+}
+
 RID RenderingDeviceVulkan::vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets) {
 	_THREAD_SAFE_METHOD_
 
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/zip_io.h"
@@ -224,7 +225,16 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	Vector<uint8_t> compressed;
+	if (pd->compress && uint64_t(p_data.size()) <= UINT32_MAX) {
+		compressed = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), PACK_COMPRESSED_FILE_MAGIC, Compression::MODE_ZSTD, PACK_COMPRESSION_BLOCK_SIZE);
+		sd.compressed = !compressed.is_empty() && compressed.size() < p_data.size();
+	}
+	if (sd.compressed) {
+		ftmp->store_buffer(compressed.ptr(), compressed.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1507,6 +1517,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	PackData pd;
 	pd.ep = &ep;
 	pd.f = ftmp;
+	pd.compress = p_preset->get_compress_pck();
 	pd.so_files = p_so_files;
 
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
@@ -1559,7 +1570,11 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	int64_t pck_start_pos = f->get_position();
 
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	bool has_compressed = false;
+	for (const SavedData &E : pd.file_ofs) {
+		has_compressed = has_compressed || E.compressed;
+	}
+	f->store_32(has_compressed ? PACK_FORMAT_VERSION : PACK_FORMAT_VERSION_UNCOMPRESSED);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1646,6 +1661,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
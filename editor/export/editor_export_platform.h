@@ -70,6 +70,7 @@ private:
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -81,6 +82,7 @@ private:
 	struct PackData {
 		Ref<FileAccess> f;
 		Vector<SavedData> file_ofs;
+		bool compress = false;
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
 	};
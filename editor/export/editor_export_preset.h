@@ -83,6 +83,8 @@ private:
 	bool enc_pck = false;
 	bool enc_directory = false;
 
+	bool compress_pck = false;
+
 	String script_key;
 
 protected:
@@ -149,6 +151,9 @@ public:
 	void set_enc_directory(bool p_enabled);
 	bool get_enc_directory() const;
 
+	void set_compress_pck(bool p_enabled);
+	bool get_compress_pck() const;
+
 	void set_script_encryption_key(const String &p_key);
 	String get_script_encryption_key() const;
 
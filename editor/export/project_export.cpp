@@ -244,6 +244,7 @@ void ProjectExportDialog::_edit_preset(int p_index) {
 	include_filters->set_text(current->get_include_filter());
 	include_label->set_text(current->get_export_filter() == EditorExportPreset::EXCLUDE_SELECTED_RESOURCES ? TTR("Resources to exclude:") : TTR("Resources to export:"));
 	exclude_filters->set_text(current->get_exclude_filter());
+	compress_pck->set_pressed(current->get_compress_pck());
 	server_strip_message->set_visible(current->get_export_filter() == EditorExportPreset::EXPORT_CUSTOMIZED);
 
 	_fill_resource_tree();
@@ -481,6 +482,19 @@ void ProjectExportDialog::_open_key_help_link() {
 	OS::get_singleton()->shell_open(vformat("%s/contributing/development/compiling/compiling_with_script_encryption_key.html", VERSION_DOCS_URL));
 }
 
+void ProjectExportDialog::_compress_pck_changed(bool p_pressed) {
+	if (updating) {
+		return;
+	}
+
+	Ref<EditorExportPreset> current = get_current_preset();
+	ERR_FAIL_COND(current.is_null());
+
+	current->set_compress_pck(p_pressed);
+
+	_update_current_preset();
+}
+
 void ProjectExportDialog::_enc_pck_changed(bool p_pressed) {
 	if (updating) {
 		return;
@@ -1238,6 +1252,12 @@ ProjectExportDialog::ProjectExportDialog() {
 			exclude_filters);
 	exclude_filters->connect("text_changed", callable_mp(this, &ProjectExportDialog::_filter_changed));
 
+	compress_pck = memnew(CheckButton);
+	compress_pck->connect("toggled", callable_mp(this, &ProjectExportDialog::_compress_pck_changed));
+	compress_pck->set_text(TTR("Compress Files in PCK"));
+	compress_pck->set_tooltip_text(TTR("Store files compressed in the exported PCK, in blocks that keep them seekable. Reduces the download size at the cost of some loading time."));
+	resources_vb->add_child(compress_pck);
+
 	// Feature tags.
 
 	VBoxContainer *feature_vb = memnew(VBoxContainer);
@@ -133,6 +133,8 @@ private:
 	CheckBox *export_debug = nullptr;
 	CheckBox *export_pck_zip_debug = nullptr;
 
+	CheckButton *compress_pck = nullptr;
+
 	CheckButton *enc_pck = nullptr;
 	CheckButton *enc_directory = nullptr;
 	LineEdit *enc_in_filters = nullptr;
@@ -155,6 +157,7 @@ private:
 
 	bool updating_script_key = false;
 	bool updating_enc_filters = false;
+	void _compress_pck_changed(bool p_pressed);
 	void _enc_pck_changed(bool p_pressed);
 	void _enc_directory_changed(bool p_pressed);
 	void _enc_filters_changed(const String &p_text);
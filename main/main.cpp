@@ -76,6 +76,7 @@
 #include "servers/physics_server_3d.h"
 #include "servers/register_server_types.h"
 #include "servers/rendering/rendering_server_default.h"
+#include "servers/rendering/shader_compiler.h"
 #include "servers/text/text_server_dummy.h"
 #include "servers/text_server.h"
 #include "servers/xr_server.h"
@@ -216,6 +217,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String resource_load_trace_path;
 #ifdef TOOLS_ENABLED
 static bool dump_gdextension_interface = false;
 static bool dump_extension_api = false;
@@ -454,6 +456,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --gpu-abort                       Abort on graphics API usage errors (usually validation layer errors). May help see the problem if your system freezes.\n");
 #endif
 	OS::get_singleton()->print("  --remote-debug <uri>              Remote debug (<protocol>://<host/IP>[:<port>], e.g. tcp://127.0.0.1:6007).\n");
+	OS::get_singleton()->print("  --resource-load-trace <file>      Record every resource load and save the timings as a Chrome trace JSON file on exit.\n");
 	OS::get_singleton()->print("  --single-threaded-scene           Scene tree runs in single-threaded mode. Sub-thread groups are disabled and run on the main thread.\n");
 #if defined(DEBUG_ENABLED)
 	OS::get_singleton()->print("  --debug-collisions                Show collision shapes when running the scene.\n");
@@ -1415,6 +1418,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing write-movie argument, aborting.\n");
 				goto error;
 			}
+		} else if (I->get() == "--resource-load-trace") {
+			if (I->next()) {
+				resource_load_trace_path = I->next()->get();
+				ResourceLoader::set_load_trace_enabled(true);
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing resource-load-trace argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--disable-vsync") {
 			disable_vsync = true;
 		} else if (I->get() == "--print-fps") {
@@ -3293,6 +3305,9 @@ bool Main::start() {
 		}
 	}
 
+	ShaderCompiler::CacheStats shader_stats = ShaderCompiler::get_cache_stats();
+	print_verbose(vformat("Shader compiler: %d shaders compiled in %.2f ms, %d loaded from cache in %.2f ms.", shader_stats.compiled, shader_stats.compile_usec / 1000.0, shader_stats.cache_hits, shader_stats.cache_load_usec / 1000.0));
+
 	OS::get_singleton()->benchmark_end_measure("startup_begin");
 	OS::get_singleton()->benchmark_dump();
 
@@ -3554,6 +3569,12 @@ void Main::cleanup(bool p_force) {
 
 	ResourceLoader::clear_thread_load_tasks();
 
+	if (!resource_load_trace_path.is_empty()) {
+		ResourceLoader::save_load_trace(resource_load_trace_path);
+		ResourceLoader::set_load_trace_enabled(false);
+		ResourceLoader::clear_load_trace();
+	}
+
 	ResourceLoader::remove_custom_loaders();
 	ResourceSaver::remove_custom_savers();
 
@@ -30,11 +30,27 @@
 
 #include "image_compress_astcenc.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include <astcenc.h>
 
+struct ASTCCompressionJob {
+	astcenc_context *context = nullptr;
+	astcenc_image *image = nullptr;
+	const astcenc_swizzle *swizzle = nullptr;
+	uint8_t *dest = nullptr;
+	size_t dest_size = 0;
+	LocalVector<astcenc_error> thread_status;
+};
+
+static void _compress_astc_thread(void *p_job, uint32_t p_index) {
+	ASTCCompressionJob *job = static_cast<ASTCCompressionJob *>(p_job);
+	job->thread_status[p_index] = astcenc_compress_image(job->context, job->image, job->swizzle, job->dest, job->dest_size, p_index);
+}
+
 void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 	uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -114,8 +130,13 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 
 	// Context allocation.
 
+	// Each mip level is compressed by all the pool threads, astcenc splits its blocks between them
+	// and produces the same output regardless of the thread count. A single thread is used when
+	// already running on a pool thread, see WorkerThreadPool::get_thread_index().
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const unsigned int thread_count = pool->get_thread_index() == -1 ? MAX(pool->get_thread_count(), 1) : 1;
+
 	astcenc_context *context;
-	const unsigned int thread_count = 1; // Godot compresses multiple images each on a thread, which is more efficient for large amount of images imported.
 	status = astcenc_context_alloc(&config, thread_count, &context);
 	ERR_FAIL_COND_MSG(status != ASTCENC_SUCCESS,
 			vformat("astcenc: Context allocation failed: %s.", astcenc_get_error_string(status)));
@@ -156,7 +177,29 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 			ASTCENC_SWZ_R, ASTCENC_SWZ_G, ASTCENC_SWZ_B, ASTCENC_SWZ_A
 		};
 
-		status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		if (thread_count > 1) {
+			ASTCCompressionJob job;
+			job.context = context;
+			job.image = &image;
+			job.swizzle = &swizzle;
+			job.dest = dest_mip_write;
+			job.dest_size = comp_len;
+			job.thread_status.resize(thread_count);
+
+			// Every thread index must be used exactly once, so run one task per element.
+			WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_compress_astc_thread, &job, thread_count, thread_count, true, SNAME("ASTCCompress"));
+			pool->wait_for_group_task_completion(group_task);
+
+			status = ASTCENC_SUCCESS;
+			for (astcenc_error thread_status : job.thread_status) {
+				if (thread_status != ASTCENC_SUCCESS) {
+					status = thread_status;
+					break;
+				}
+			}
+		} else {
+			status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		}
 
 		ERR_BREAK_MSG(status != ASTCENC_SUCCESS,
 				vformat("astcenc: ASTC image compression failed: %s.", astcenc_get_error_string(status)));
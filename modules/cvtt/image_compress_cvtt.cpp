@@ -246,8 +246,15 @@ void image_compress_cvtt(Image *p_image, Image::UsedChannels p_channels) {
 
 	job_queue.job_tasks = &tasks_rb[0];
 	job_queue.num_tasks = static_cast<uint32_t>(tasks.size());
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_job_queue, &job_queue, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("CVTT Compress"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_digest_job_queue, &job_queue, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("CVTT Compress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		// Already on a pool thread, see WorkerThreadPool::get_thread_index().
+		for (uint32_t i = 0; i < job_queue.num_tasks; i++) {
+			_digest_row_task(job_queue.job_params, job_queue.job_tasks[i]);
+		}
+	}
 
 	p_image->set_data(p_image->get_width(), p_image->get_height(), p_image->has_mipmaps(), target_format, data);
 }
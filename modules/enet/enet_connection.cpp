@@ -217,9 +217,19 @@ void ENetConnection::bandwidth_throttle() {
 	enet_host_bandwidth_throttle(host);
 }
 
-void ENetConnection::compress(CompressionMode p_mode) {
+void ENetConnection::compress(CompressionMode p_mode, const PackedByteArray &p_dictionary) {
 	ERR_FAIL_COND_MSG(!host, "The ENetConnection instance isn't currently active.");
-	Compressor::setup(host, p_mode);
+	ERR_FAIL_COND_MSG(!p_dictionary.is_empty() && p_mode != COMPRESS_ZSTD, "A compression dictionary can only be used with COMPRESS_ZSTD.");
+	Compressor::setup(host, p_mode, p_dictionary);
+}
+
+PackedByteArray ENetConnection::train_compression_dictionary(const TypedArray<PackedByteArray> &p_samples, int p_max_size) {
+	Vector<Vector<uint8_t>> samples;
+	samples.resize(p_samples.size());
+	for (int i = 0; i < p_samples.size(); i++) {
+		samples.write[i] = p_samples[i];
+	}
+	return Compression::zstd_train_dictionary(samples, p_max_size);
 }
 
 double ENetConnection::pop_statistic(HostStatistic p_stat) {
@@ -385,7 +395,8 @@ void ENetConnection::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("bandwidth_limit", "in_bandwidth", "out_bandwidth"), &ENetConnection::bandwidth_limit, DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("channel_limit", "limit"), &ENetConnection::channel_limit);
 	ClassDB::bind_method(D_METHOD("broadcast", "channel", "packet", "flags"), &ENetConnection::_broadcast);
-	ClassDB::bind_method(D_METHOD("compress", "mode"), &ENetConnection::compress);
+	ClassDB::bind_method(D_METHOD("compress", "mode", "dictionary"), &ENetConnection::compress, DEFVAL(PackedByteArray()));
+	ClassDB::bind_static_method("ENetConnection", D_METHOD("train_compression_dictionary", "samples", "max_size"), &ENetConnection::train_compression_dictionary, DEFVAL(16384));
 	ClassDB::bind_method(D_METHOD("dtls_server_setup", "server_options"), &ENetConnection::dtls_server_setup);
 	ClassDB::bind_method(D_METHOD("dtls_client_setup", "hostname", "client_options"), &ENetConnection::dtls_client_setup, DEFVAL(Ref<TLSOptions>()));
 	ClassDB::bind_method(D_METHOD("refuse_new_connections", "refuse"), &ENetConnection::refuse_new_connections);
@@ -458,7 +469,7 @@ size_t ENetConnection::Compressor::enet_compress(void *context, const ENetBuffer
 	if (compressor->dst_mem.size() < req_size) {
 		compressor->dst_mem.resize(req_size);
 	}
-	int ret = Compression::compress(compressor->dst_mem.ptrw(), compressor->src_mem.ptr(), ofs, mode);
+	int ret = Compression::compress(compressor->dst_mem.ptrw(), compressor->src_mem.ptr(), ofs, mode, compressor->zstd_dictionary);
 
 	if (ret < 0) {
 		return 0;
@@ -484,7 +495,7 @@ size_t ENetConnection::Compressor::enet_decompress(void *context, const enet_uin
 			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_DEFLATE);
 		} break;
 		case COMPRESS_ZSTD: {
-			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_ZSTD);
+			ret = Compression::decompress(outData, outLimit, inData, inLimit, Compression::MODE_ZSTD, compressor->zstd_dictionary);
 		} break;
 		default: {
 		}
@@ -496,7 +507,7 @@ size_t ENetConnection::Compressor::enet_decompress(void *context, const enet_uin
 	}
 }
 
-void ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode) {
+void ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode, const Vector<uint8_t> &p_zstd_dictionary) {
 	ERR_FAIL_COND(!p_host);
 	switch (p_mode) {
 		case COMPRESS_NONE: {
@@ -509,6 +520,15 @@ void ENetConnection::Compressor::setup(ENetHost *p_host, CompressionMode p_mode)
 		case COMPRESS_ZLIB:
 		case COMPRESS_ZSTD: {
 			Compressor *compressor = memnew(Compressor(p_mode));
+			if (!p_zstd_dictionary.is_empty()) {
+				// Each host registers its own copy, named after the compressor so it's unique.
+				String name = vformat("ENetConnection:%x", (uint64_t)compressor);
+				if (Compression::zstd_register_dictionary(name, p_zstd_dictionary) != OK) {
+					memdelete(compressor);
+					ERR_FAIL_MSG("Invalid compression dictionary, it must be created with train_compression_dictionary().");
+				}
+				compressor->zstd_dictionary = name;
+			}
 			enet_host_compress(p_host, &(compressor->enet_compressor));
 		} break;
 	}
@@ -521,3 +541,9 @@ ENetConnection::Compressor::Compressor(CompressionMode p_mode) {
 	enet_compressor.decompress = enet_decompress;
 	enet_compressor.destroy = enet_compressor_destroy;
 }
+
+ENetConnection::Compressor::~Compressor() {
+	if (!zstd_dictionary.is_empty()) {
+		Compression::zstd_unregister_dictionary(zstd_dictionary);
+	}
+}
@@ -91,6 +91,7 @@ private:
 	class Compressor {
 	private:
 		CompressionMode mode = COMPRESS_NONE;
+		String zstd_dictionary;
 		Vector<uint8_t> src_mem;
 		Vector<uint8_t> dst_mem;
 		ENetCompressor enet_compressor;
@@ -104,7 +105,9 @@ private:
 		}
 
 	public:
-		static void setup(ENetHost *p_host, CompressionMode p_mode);
+		~Compressor();
+
+		static void setup(ENetHost *p_host, CompressionMode p_mode, const Vector<uint8_t> &p_zstd_dictionary = Vector<uint8_t>());
 	};
 
 public:
@@ -120,7 +123,8 @@ public:
 	void bandwidth_limit(int p_in_bandwidth = 0, int p_out_bandwidth = 0);
 	void channel_limit(int p_max_channels);
 	void bandwidth_throttle();
-	void compress(CompressionMode p_mode);
+	void compress(CompressionMode p_mode, const PackedByteArray &p_dictionary = PackedByteArray());
+	static PackedByteArray train_compression_dictionary(const TypedArray<PackedByteArray> &p_samples, int p_max_size = 16384);
 	double pop_statistic(HostStatistic p_stat);
 	int get_max_channels() const;
 
@@ -30,12 +30,51 @@
 
 #include "image_compress_etcpak.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 #include <ProcessDxtc.hpp>
 #include <ProcessRGB.hpp>
 
+struct EtcpakCompressionTask {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakCompressionJob {
+	EtcpakType type = EtcpakType::ETCPAK_TYPE_ETC1;
+	LocalVector<EtcpakCompressionTask> tasks;
+};
+
+static void _compress_etcpak_task(void *p_job, uint32_t p_index) {
+	const EtcpakCompressionJob *job = static_cast<const EtcpakCompressionJob *>(p_job);
+	const EtcpakCompressionTask &task = job->tasks[p_index];
+
+	switch (job->type) {
+		case EtcpakType::ETCPAK_TYPE_ETC1: {
+			CompressEtc1RgbDither(task.src, task.dst, task.blocks, task.width);
+		} break;
+		case EtcpakType::ETCPAK_TYPE_ETC2: {
+			CompressEtc2Rgb(task.src, task.dst, task.blocks, task.width, true);
+		} break;
+		case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
+		case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG: {
+			CompressEtc2Rgba(task.src, task.dst, task.blocks, task.width, true);
+		} break;
+		case EtcpakType::ETCPAK_TYPE_DXT1: {
+			CompressDxt1Dither(task.src, task.dst, task.blocks, task.width);
+		} break;
+		case EtcpakType::ETCPAK_TYPE_DXT5:
+		case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG: {
+			CompressDxt5(task.src, task.dst, task.blocks, task.width);
+		} break;
+	}
+}
+
 EtcpakType _determine_etc_type(Image::UsedChannels p_channels) {
 	switch (p_channels) {
 		case Image::USED_CHANNELS_L:
@@ -177,7 +216,16 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 	uint8_t *dest_write = dest_data.ptrw();
 
 	int mip_count = mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
-	Vector<uint32_t> padded_src;
+	LocalVector<Vector<uint32_t>> padded_srcs;
+	padded_srcs.resize(mip_count + 1);
+
+	// Every block is encoded independently, so the mip levels are split into ranges of block rows
+	// which are compressed in parallel. The output does not depend on how the work is split.
+	EtcpakCompressionJob job;
+	job.type = p_compresstype;
+	const bool alpha_blocks = p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG;
+	const uint32_t block_words = alpha_blocks ? 2 : 1;
+	const uint32_t min_blocks_per_task = 1024;
 
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
@@ -198,6 +246,7 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 
 		// Pad textures to nearest block by smearing.
 		if (mip_w != orig_mip_w || mip_h != orig_mip_h) {
+			Vector<uint32_t> &padded_src = padded_srcs[i];
 			padded_src.resize(mip_w * mip_h);
 			uint32_t *ptrw = padded_src.ptrw();
 			int x = 0, y = 0;
@@ -219,18 +268,27 @@ void _compress_etcpak(EtcpakType p_compresstype, Image *r_img) {
 			// Override the src_mip_read pointer to our temporary Vector.
 			src_mip_read = padded_src.ptr();
 		}
-		if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC1) {
-			CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2) {
-			CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_ALPHA || p_compresstype == EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG) {
-			CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, mip_w, true);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT1) {
-			CompressDxt1Dither(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else if (p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5 || p_compresstype == EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG) {
-			CompressDxt5(src_mip_read, dest_mip_write, blocks, mip_w);
-		} else {
-			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+		const uint32_t blocks_per_row = mip_w / 4;
+		const uint32_t block_rows = blocks / blocks_per_row;
+		const uint32_t rows_per_task = MAX(min_blocks_per_task / blocks_per_row, 1u);
+		for (uint32_t row = 0; row < block_rows; row += rows_per_task) {
+			EtcpakCompressionTask task;
+			task.src = src_mip_read + row * 4 * mip_w;
+			task.dst = dest_mip_write + row * blocks_per_row * block_words;
+			task.blocks = MIN(rows_per_task, block_rows - row) * blocks_per_row;
+			task.width = mip_w;
+			job.tasks.push_back(task);
+		}
+	}
+
+	// Images compressed from a pool thread stay on it, see WorkerThreadPool::get_thread_index().
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (job.tasks.size() > 1 && pool->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_compress_etcpak_task, &job, job.tasks.size(), -1, true, SNAME("EtcpakCompress"));
+		pool->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < job.tasks.size(); i++) {
+			_compress_etcpak_task(&job, i);
 		}
 	}
 
@@ -0,0 +1,1171 @@
+/**************************************************************************/
+/*  lightmapper_cpu.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "lightmapper_cpu.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/image.h"
+#include "core/math/geometry_2d.h"
+
+// Same hash and sampling functions as lm_compute.glsl, so the noise pattern matches LightmapperRD.
+// https://www.reedbeta.com/blog/hash-functions-for-gpu-rendering/
+static _FORCE_INLINE_ uint32_t _lm_hash(uint32_t p_value) {
+	uint32_t state = p_value * 747796405u + 2891336453u;
+	uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+	return (word >> 22u) ^ word;
+}
+
+static _FORCE_INLINE_ uint32_t _lm_random_seed(uint32_t p_x, uint32_t p_y, uint32_t p_z) {
+	return _lm_hash(p_x ^ _lm_hash(p_y ^ _lm_hash(p_z)));
+}
+
+// Generates a random value in range [0.0, 1.0).
+static _FORCE_INLINE_ float _lm_randomize(uint32_t &r_value) {
+	r_value = _lm_hash(r_value);
+	return float(r_value / 4294967296.0);
+}
+
+// http://www.realtimerendering.com/raytracinggems/unofficial_RayTracingGems_v1.4.pdf (chapter 15)
+static _FORCE_INLINE_ Vector3 _lm_hemisphere_uniform_direction(uint32_t &r_noise) {
+	float noise1 = _lm_randomize(r_noise);
+	float noise2 = _lm_randomize(r_noise) * 2.0 * Math_PI;
+
+	float factor = Math::sqrt(1 - (noise1 * noise1));
+	return Vector3(factor * Math::cos(noise2), factor * Math::sin(noise2), noise1);
+}
+
+static _FORCE_INLINE_ Vector3 _lm_hemisphere_cosine_weighted_direction(uint32_t &r_noise) {
+	float noise1 = _lm_randomize(r_noise);
+	float noise2 = _lm_randomize(r_noise) * 2.0 * Math_PI;
+
+	return Vector3(Math::sqrt(noise1) * Math::cos(noise2), Math::sqrt(noise1) * Math::sin(noise2), Math::sqrt(1.0 - noise1));
+}
+
+static _FORCE_INLINE_ float _lm_omni_attenuation(float p_distance, float p_inv_range, float p_decay) {
+	float nd = p_distance * p_inv_range;
+	nd *= nd;
+	nd *= nd; // nd^4
+	nd = MAX(1.0 - nd, 0.0);
+	nd *= nd; // nd^2
+	return nd * Math::pow(MAX(p_distance, 0.0001f), -p_decay);
+}
+
+static _FORCE_INLINE_ Vector3 _lm_color_to_vector(const Color &p_color) {
+	return Vector3(p_color.r, p_color.g, p_color.b);
+}
+
+// Empty texels have zero alpha, which is what dilation looks for.
+static void _lm_clear_light(LocalVector<Color> &r_light, uint32_t p_size) {
+	r_light.resize(p_size);
+	for (Color &c : r_light) {
+		c = Color(0, 0, 0, 0);
+	}
+}
+
+static _FORCE_INLINE_ Color _lm_vector_to_color(const Vector3 &p_vector, float p_alpha = 1.0) {
+	return Color(p_vector.x, p_vector.y, p_vector.z, p_alpha);
+}
+
+void LightmapperCPU::add_mesh(const MeshData &p_mesh) {
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2.is_null() || p_mesh.albedo_on_uv2->is_empty());
+	ERR_FAIL_COND(p_mesh.emission_on_uv2.is_null() || p_mesh.emission_on_uv2->is_empty());
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2->get_width() != p_mesh.emission_on_uv2->get_width());
+	ERR_FAIL_COND(p_mesh.albedo_on_uv2->get_height() != p_mesh.emission_on_uv2->get_height());
+	ERR_FAIL_COND(p_mesh.points.size() == 0);
+	MeshInstance mi;
+	mi.data = p_mesh;
+	mesh_instances.push_back(mi);
+}
+
+void LightmapperCPU::add_directional_light(bool p_static, const Vector3 &p_direction, const Color &p_color, float p_energy, float p_angular_distance, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_DIRECTIONAL;
+	l.direction = p_direction;
+	l.color = _lm_color_to_vector(p_color);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = Math::tan(Math::deg_to_rad(p_angular_distance));
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_omni_light(bool p_static, const Vector3 &p_position, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_size, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_OMNI;
+	l.position = p_position;
+	l.range = p_range;
+	l.attenuation = p_attenuation;
+	l.color = _lm_color_to_vector(p_color);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = p_size;
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_spot_light(bool p_static, const Vector3 &p_position, const Vector3 p_direction, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_spot_angle, float p_spot_attenuation, float p_size, float p_shadow_blur) {
+	Light l;
+	l.type = LIGHT_TYPE_SPOT;
+	l.position = p_position;
+	l.direction = p_direction;
+	l.range = p_range;
+	l.attenuation = p_attenuation;
+	l.cos_spot_angle = Math::cos(Math::deg_to_rad(p_spot_angle));
+	l.inv_spot_attenuation = 1.0f / p_spot_attenuation;
+	l.color = _lm_color_to_vector(p_color);
+	l.energy = p_energy;
+	l.static_bake = p_static;
+	l.size = p_size;
+	l.shadow_blur = p_shadow_blur;
+	lights.push_back(l);
+}
+
+void LightmapperCPU::add_probe(const Vector3 &p_position) {
+	probe_positions.push_back(p_position);
+}
+
+template <class M>
+void LightmapperCPU::_run_tasks(M p_method, uint32_t p_elements, const String &p_description) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool->get_thread_index() != -1) {
+		// Already on a pool thread, see WorkerThreadPool::get_thread_index().
+		for (uint32_t i = 0; i < p_elements; i++) {
+			(this->*p_method)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = pool->add_template_group_task(this, p_method, (void *)nullptr, p_elements, -1, true, p_description);
+	pool->wait_for_group_task_completion(group_task);
+}
+
+Color LightmapperCPU::_sample_layer(const LocalVector<Color> &p_light, int p_layer, const Vector2 &p_pos) const {
+	// Bilinear filtering with texel centers at half coordinates, like the linear sampler used by LightmapperRD.
+	float x = CLAMP(p_pos.x - 0.5f, 0.0f, float(atlas_size.width - 1));
+	float y = CLAMP(p_pos.y - 0.5f, 0.0f, float(atlas_size.height - 1));
+	int x0 = int(x);
+	int y0 = int(y);
+	int x1 = MIN(x0 + 1, atlas_size.width - 1);
+	int y1 = MIN(y0 + 1, atlas_size.height - 1);
+	float tx = x - x0;
+	float ty = y - y0;
+
+	const Color *layer = &p_light[uint32_t(p_layer) * atlas_size.width * atlas_size.height];
+	Color top = layer[y0 * atlas_size.width + x0].lerp(layer[y0 * atlas_size.width + x1], tx);
+	Color bottom = layer[y1 * atlas_size.width + x0].lerp(layer[y1 * atlas_size.width + x1], tx);
+	return top.lerp(bottom, ty);
+}
+
+Color LightmapperCPU::_sample_hit(const LocalVector<Color> &p_light, const LightmapRaycaster::Ray &p_ray) const {
+	// The raycaster returns the UV2 of the hit in u and v, and the mesh index as geometry ID.
+	const MeshInstance &mi = mesh_instances[p_ray.geomID];
+	Vector2 pos = Vector2(p_ray.u, p_ray.v) * Vector2(mi.data.albedo_on_uv2->get_size()) + Vector2(mi.offset);
+	return _sample_layer(p_light, mi.slice, pos);
+}
+
+Color LightmapperCPU::_sample_environment(const Vector3 &p_dir) const {
+	Vector3 sky_dir = environment_transform.xform(p_dir).normalized();
+	Vector2 st = Vector2(Math::atan2(sky_dir.x, sky_dir.z), Math::acos(CLAMP(sky_dir.y, -1.0f, 1.0f)));
+	if (st.x < 0.0) {
+		st.x += Math_PI * 2.0;
+	}
+	st /= Vector2(Math_PI * 2.0, Math_PI);
+
+	float x = CLAMP(st.x * environment_size.width - 0.5f, 0.0f, float(environment_size.width - 1));
+	float y = CLAMP(st.y * environment_size.height - 0.5f, 0.0f, float(environment_size.height - 1));
+	int x0 = int(x);
+	int y0 = int(y);
+	int x1 = MIN(x0 + 1, environment_size.width - 1);
+	int y1 = MIN(y0 + 1, environment_size.height - 1);
+	Color top = environment[y0 * environment_size.width + x0].lerp(environment[y0 * environment_size.width + x1], x - x0);
+	Color bottom = environment[y1 * environment_size.width + x0].lerp(environment[y1 * environment_size.width + x1], x - x0);
+	return top.lerp(bottom, y - y0);
+}
+
+Lightmapper::BakeError LightmapperCPU::_blit_meshes_into_atlas(int p_max_texture_size, Vector<Ref<Image>> &r_albedo_images, Vector<Ref<Image>> &r_emission_images, BakeStepFunc p_step_function, void *p_bake_userdata) {
+	Vector<Size2i> sizes;
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		MeshInstance &mi = mesh_instances.write[m_i];
+		Size2i s = Size2i(mi.data.albedo_on_uv2->get_width(), mi.data.albedo_on_uv2->get_height());
+		sizes.push_back(s);
+		atlas_size.width = MAX(atlas_size.width, s.width + 2);
+		atlas_size.height = MAX(atlas_size.height, s.height + 2);
+	}
+
+	int max = nearest_power_of_2_templated(atlas_size.width);
+	max = MAX(max, nearest_power_of_2_templated(atlas_size.height));
+
+	if (max > p_max_texture_size) {
+		return BAKE_ERROR_LIGHTMAP_TOO_SMALL;
+	}
+
+	if (p_step_function) {
+		p_step_function(0.1, RTR("Determining optimal atlas size"), p_bake_userdata, true);
+	}
+
+	atlas_size = Size2i(max, max);
+
+	Size2i best_atlas_size;
+	int best_atlas_slices = 0;
+	int best_atlas_memory = 0x7FFFFFFF;
+	Vector<Vector3i> best_atlas_offsets;
+
+	// Determine best texture array atlas size by bruteforce fitting.
+	while (atlas_size.x <= p_max_texture_size && atlas_size.y <= p_max_texture_size) {
+		Vector<Vector2i> source_sizes;
+		Vector<int> source_indices;
+		source_sizes.resize(sizes.size());
+		source_indices.resize(sizes.size());
+		for (int i = 0; i < source_indices.size(); i++) {
+			source_sizes.write[i] = sizes[i] + Vector2i(2, 2); // Add padding between lightmaps.
+			source_indices.write[i] = i;
+		}
+		Vector<Vector3i> atlas_offsets;
+		atlas_offsets.resize(source_sizes.size());
+
+		int slices = 0;
+
+		while (source_sizes.size() > 0) {
+			Vector<Vector3i> offsets = Geometry2D::partial_pack_rects(source_sizes, atlas_size);
+			Vector<int> new_indices;
+			Vector<Vector2i> new_sources;
+			for (int i = 0; i < offsets.size(); i++) {
+				Vector3i ofs = offsets[i];
+				int sidx = source_indices[i];
+				if (ofs.z > 0) {
+					ofs.z = slices;
+					atlas_offsets.write[sidx] = ofs + Vector3i(1, 1, 0); // Center lightmap in the reserved oversized region.
+				} else {
+					new_indices.push_back(sidx);
+					new_sources.push_back(source_sizes[i]);
+				}
+			}
+
+			source_sizes = new_sources;
+			source_indices = new_indices;
+			slices++;
+		}
+
+		int mem_used = atlas_size.x * atlas_size.y * slices;
+		if (mem_used < best_atlas_memory) {
+			best_atlas_size = atlas_size;
+			best_atlas_offsets = atlas_offsets;
+			best_atlas_slices = slices;
+			best_atlas_memory = mem_used;
+		}
+
+		if (atlas_size.width == atlas_size.height) {
+			atlas_size.width *= 2;
+		} else {
+			atlas_size.height *= 2;
+		}
+	}
+	atlas_size = best_atlas_size;
+	atlas_slices = best_atlas_slices;
+
+	r_albedo_images.resize(atlas_slices);
+	r_emission_images.resize(atlas_slices);
+
+	if (p_step_function) {
+		p_step_function(0.2, RTR("Blitting albedo and emission"), p_bake_userdata, true);
+	}
+
+	for (int i = 0; i < atlas_slices; i++) {
+		Ref<Image> albedo_image = Image::create_empty(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBA8);
+		albedo_image->set_as_black();
+		r_albedo_images.write[i] = albedo_image;
+
+		Ref<Image> emission_image = Image::create_empty(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAH);
+		emission_image->set_as_black();
+		r_emission_images.write[i] = emission_image;
+	}
+
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		MeshInstance &mi = mesh_instances.write[m_i];
+		mi.offset.x = best_atlas_offsets[m_i].x;
+		mi.offset.y = best_atlas_offsets[m_i].y;
+		mi.slice = best_atlas_offsets[m_i].z;
+		r_albedo_images.write[mi.slice]->blit_rect(mi.data.albedo_on_uv2, Rect2i(Vector2i(), mi.data.albedo_on_uv2->get_size()), mi.offset);
+		r_emission_images.write[mi.slice]->blit_rect(mi.data.emission_on_uv2, Rect2i(Vector2i(), mi.data.emission_on_uv2->get_size()), mi.offset);
+	}
+
+	return BAKE_OK;
+}
+
+void LightmapperCPU::_compute_seams() {
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const MeshInstance &mi = mesh_instances[m_i];
+		Vector2 uv_scale = Vector2(mi.data.albedo_on_uv2->get_size());
+		Vector2 uv_offset = Vector2(mi.offset);
+
+		HashMap<Edge, EdgeUV2, EdgeHash> edges;
+
+		for (int i = 0; i < mi.data.points.size(); i += 3) {
+			for (int k = 0; k < 3; k++) {
+				int n = i + (k + 1) % 3;
+
+				Edge edge = { mi.data.points[i + k], mi.data.points[n], mi.data.normal[i + k], mi.data.normal[n] };
+				EdgeUV2 uv2 = { mi.data.uv2[i + k] * uv_scale + uv_offset, mi.data.uv2[n] * uv_scale + uv_offset };
+
+				if (edge.b == edge.a) {
+					continue; // Degenerate, somehow.
+				}
+				if (edge.b < edge.a) {
+					SWAP(edge.a, edge.b);
+					SWAP(edge.na, edge.nb);
+					SWAP(uv2.a, uv2.b);
+				}
+
+				EdgeUV2 *euv2 = edges.getptr(edge);
+				if (!euv2) {
+					edges[edge] = uv2;
+				} else {
+					if (euv2->a == uv2.a && euv2->b == uv2.b) {
+						continue; // Seam shared UV space, no need to blend.
+					}
+					if (euv2->seam_found) {
+						continue; // Bad geometry.
+					}
+
+					Seam seam;
+					seam.a[0] = uv2.a;
+					seam.a[1] = uv2.b;
+					seam.b[0] = euv2->a;
+					seam.b[1] = euv2->b;
+					seam.slice = mi.slice;
+					seams.push_back(seam);
+					euv2->seam_found = true;
+				}
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_plot_mesh(uint32_t p_mesh, void *p_userdata) {
+	// Meshes occupy disjoint regions of the atlas, so each one can be plotted by a different thread.
+	const MeshInstance &mi = mesh_instances[p_mesh];
+	const Vector2 uv_scale = Vector2(mi.data.albedo_on_uv2->get_size());
+	const Vector2 uv_offset = Vector2(mi.offset);
+	const Rect2i mesh_rect = Rect2i(mi.offset, mi.data.albedo_on_uv2->get_size());
+	const Vector3 *points = mi.data.points.ptr();
+	const Vector3 *normals = mi.data.normal.ptr();
+	const Vector2 *uv2s = mi.data.uv2.ptr();
+
+	for (int i = 0; i + 2 < mi.data.points.size(); i += 3) {
+		const Vector3 pos[3] = { points[i], points[i + 1], points[i + 2] };
+		Vector3 norm[3] = { normals[i], normals[i + 1], normals[i + 2] };
+		const Vector2 uv[3] = { uv2s[i] * uv_scale + uv_offset, uv2s[i + 1] * uv_scale + uv_offset, uv2s[i + 2] * uv_scale + uv_offset };
+
+		const Vector2 e1 = uv[1] - uv[0];
+		const Vector2 e2 = uv[2] - uv[0];
+		const float det = e1.cross(e2);
+		if (Math::abs(det) < CMP_EPSILON2) {
+			continue; // Degenerate in UV2 space.
+		}
+		const float inv_det = 1.0 / det;
+
+		const Vector3 face_normal = -(pos[0] - pos[1]).cross(pos[0] - pos[2]).normalized();
+
+		// World space size of a texel, computed from the derivatives of the position in atlas space.
+		float texel_size;
+		{
+			const Vector3 dpdx = ((pos[1] - pos[0]) * e2.y - (pos[2] - pos[0]) * e1.y) * inv_det;
+			const Vector3 dpdy = ((pos[2] - pos[0]) * e1.x - (pos[1] - pos[0]) * e2.x) * inv_det;
+			const Vector3 delta = dpdx.abs().max(dpdy.abs());
+			texel_size = MAX(delta.x, MAX(delta.y, delta.z)) * Math_SQRT2; // Expand to unit box edge length (worst case).
+		}
+
+		// Positions on curved surfaces are smoothed out by projecting them on the planes of the vertex normals,
+		// the same way lm_raster.glsl does.
+		const float flat_threshold = 0.99;
+		const bool smoothen = norm[0].dot(norm[1]) < flat_threshold || norm[0].dot(norm[2]) < flat_threshold || norm[1].dot(norm[2]) < flat_threshold;
+		float plane_d[3] = {};
+		if (smoothen) {
+			const Vector3 center = (pos[0] + pos[1] + pos[2]) * (1.0 / 3.0);
+			for (int k = 0; k < 3; k++) {
+				const Vector3 dir = (pos[k] - center).normalized();
+				const float d = dir.dot(norm[k]);
+				if (d < 0) {
+					// Pointing inwards.
+					norm[k] = (norm[k] - dir * d).normalized();
+				}
+				plane_d[k] = norm[k].dot(pos[k]);
+			}
+		}
+
+		Rect2i rect = Rect2i(uv[0].floor(), Vector2i(1, 1));
+		rect.expand_to(uv[1].floor());
+		rect.expand_to(uv[2].floor());
+		rect = rect.grow(1).intersection(mesh_rect);
+
+		for (int y = rect.position.y; y < rect.position.y + rect.size.y; y++) {
+			for (int x = rect.position.x; x < rect.position.x + rect.size.x; x++) {
+				Texel &texel = texels[_get_texel_index(mi.slice, x, y)];
+				if (texel.coverage == TEXEL_INTERIOR) {
+					continue; // Like the depth test used when rasterizing on the GPU, the first triangle wins.
+				}
+
+				Vector2 center = Vector2(x + 0.5, y + 0.5);
+				Vector2 rel = center - uv[0];
+				float b1 = rel.cross(e2) * inv_det;
+				float b2 = e1.cross(rel) * inv_det;
+				float b0 = 1.0 - b1 - b2;
+
+				TexelCoverage coverage = TEXEL_INTERIOR;
+				if (b0 < 0.0 || b1 < 0.0 || b2 < 0.0) {
+					if (texel.coverage != TEXEL_EMPTY) {
+						continue;
+					}
+
+					// Conservative rasterization: also plot texels touched by the triangle edges,
+					// using the closest point of the triangle to the texel center.
+					Vector2 closest;
+					float closest_dist = 1e20;
+					for (int k = 0; k < 3; k++) {
+						const Vector2 segment[2] = { uv[k], uv[(k + 1) % 3] };
+						Vector2 p = Geometry2D::get_closest_point_to_segment(center, segment);
+						float dist = p.distance_squared_to(center);
+						if (dist < closest_dist) {
+							closest = p;
+							closest_dist = dist;
+						}
+					}
+					if (closest_dist > 0.5) {
+						continue; // Does not touch the texel (half diagonal, squared).
+					}
+
+					rel = closest - uv[0];
+					b1 = CLAMP(rel.cross(e2) * inv_det, 0.0f, 1.0f);
+					b2 = CLAMP(e1.cross(rel) * inv_det, 0.0f, 1.0f - b1);
+					b0 = 1.0 - b1 - b2;
+					coverage = TEXEL_EDGE;
+				}
+
+				Vector3 position = pos[0] * b0 + pos[1] * b1 + pos[2] * b2;
+				if (smoothen) {
+					Vector3 smooth_position;
+					const float barycentric[3] = { b0, b1, b2 };
+					for (int k = 0; k < 3; k++) {
+						smooth_position += (position - norm[k] * (norm[k].dot(position) - plane_d[k])) * barycentric[k];
+					}
+					if (face_normal.dot(smooth_position) > face_normal.dot(position)) { // Only project outwards.
+						position = smooth_position;
+					}
+				}
+
+				texel.position = position;
+				texel.normal = (normals[i] * b0 + normals[i + 1] * b1 + normals[i + 2] * b2).normalized();
+				texel.face_normal = face_normal;
+				texel.texel_size = texel_size;
+				texel.coverage = coverage;
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_unocclude_row(uint32_t p_row, void *p_userdata) {
+	// Unocclusion technique based on:
+	// https://ndotl.wordpress.com/2018/08/29/baking-artifact-free-lightmaps/
+	Texel *row = &texels[p_row * atlas_size.width];
+	for (int x = 0; x < atlas_size.width; x++) {
+		Texel &texel = row[x];
+		if (texel.coverage == TEXEL_EMPTY) {
+			continue;
+		}
+
+		const Vector3 &face_normal = texel.face_normal;
+		Vector3 v0 = Math::abs(face_normal.z) < 0.999 ? Vector3(0.0, 0.0, 1.0) : Vector3(0.0, 1.0, 0.0);
+		Vector3 tangent = v0.cross(face_normal).normalized();
+		Vector3 bitangent = tangent.cross(face_normal).normalized();
+		Vector3 base_pos = texel.position + face_normal * bias; // Raise a bit.
+
+		const Vector3 rays[4] = { tangent, bitangent, -tangent, -bitangent };
+		float min_d = 1e20;
+		for (int i = 0; i < 4; i++) {
+			LightmapRaycaster::Ray ray(base_pos, rays[i], 0.0, texel.texel_size);
+			if (!raycaster->intersect(ray)) {
+				continue;
+			}
+			Vector3 hit_normal = ray.normal.normalized();
+			if (hit_normal.dot(rays[i]) < 0.0) {
+				continue; // Front face, not inside of geometry.
+			}
+			if (ray.tfar < min_d) {
+				// This bias needs to be greater than the regular bias, because otherwise later,
+				// rays will go the other side when pointing back.
+				texel.position = base_pos + rays[i] * ray.tfar + hit_normal * bias * 10.0;
+				min_d = ray.tfar;
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_direct_light_row(uint32_t p_row, void *p_userdata) {
+	const int slice = p_row / atlas_size.height;
+	const int y = p_row % atlas_size.height;
+
+	for (int x = 0; x < atlas_size.width; x++) {
+		const uint32_t index = _get_texel_index(slice, x, y);
+		const Texel &texel = texels[index];
+		if (texel.coverage == TEXEL_EMPTY) {
+			continue; // Empty texel, no process.
+		}
+
+		const Vector3 &position = texel.position;
+		const Vector3 &normal = texel.normal;
+
+		Vector3 static_light;
+		Vector3 dynamic_light;
+		Vector3 sh_accum[4];
+
+		for (const Light &light : lights) {
+			Vector3 light_pos;
+			float dist;
+			float attenuation;
+			float soft_shadowing_disk_size;
+			if (light.type == LIGHT_TYPE_DIRECTIONAL) {
+				light_pos = position - light.direction * world_size;
+				dist = world_size;
+				attenuation = 1.0;
+				soft_shadowing_disk_size = light.size;
+			} else {
+				light_pos = light.position;
+				dist = position.distance_to(light_pos);
+				if (dist > light.range) {
+					continue;
+				}
+				soft_shadowing_disk_size = light.size / dist;
+
+				attenuation = _lm_omni_attenuation(dist, 1.0 / light.range, light.attenuation);
+
+				if (light.type == LIGHT_TYPE_SPOT) {
+					Vector3 rel = (position - light_pos).normalized();
+					float cos_angle = rel.dot(light.direction);
+					if (cos_angle < light.cos_spot_angle) {
+						continue; // Invisible, don't try.
+					}
+
+					float scos = MAX(cos_angle, light.cos_spot_angle);
+					float spot_rim = MAX(0.0001f, (1.0f - scos) / (1.0f - light.cos_spot_angle));
+					attenuation *= 1.0 - Math::pow(spot_rim, light.inv_spot_attenuation);
+				}
+			}
+
+			Vector3 light_dir = (light_pos - position).normalized();
+			attenuation *= MAX(0.0f, normal.dot(light_dir));
+
+			if (attenuation <= 0.0001) {
+				continue; // No need to do anything.
+			}
+
+			float penumbra = 0.0;
+			if (light.size > 0.0) {
+				Vector3 light_to_point = -light_dir;
+				Vector3 aux = light_to_point.y < 0.777 ? Vector3(0.0, 1.0, 0.0) : Vector3(1.0, 0.0, 0.0);
+				Vector3 light_to_point_tan = light_to_point.cross(aux).normalized();
+				Vector3 light_to_point_bitan = light_to_point.cross(light_to_point_tan).normalized();
+
+				const uint32_t shadowing_rays_check_penumbra_denom = 2;
+				uint32_t hits = 0;
+				uint32_t noise = _lm_random_seed(x, y, 43573547 /* some prime */);
+				for (uint32_t j = 0; j < ray_count; j++) {
+					// Once already traced an important proportion of rays, if all are hits or misses,
+					// assume we're not in the penumbra so we can infer the rest would have the same result.
+					if (j == ray_count / shadowing_rays_check_penumbra_denom) {
+						if (hits == j) {
+							hits = ray_count; // Assume totally lit.
+							break;
+						} else if (hits == 0) {
+							break; // Assume totally dark.
+						}
+					}
+
+					float r = _lm_randomize(noise);
+					float a = _lm_randomize(noise) * 2.0 * Math_PI;
+					Vector2 disk_sample = (r * Vector2(Math::cos(a), Math::sin(a))) * soft_shadowing_disk_size * light.shadow_blur;
+					Vector3 light_disk_to_point = (light_to_point + disk_sample.x * light_to_point_tan + disk_sample.y * light_to_point_bitan).normalized();
+
+					LightmapRaycaster::Ray ray(position - light_disk_to_point * bias, -light_disk_to_point, 0.0, dist - bias);
+					if (!raycaster->intersect(ray)) {
+						hits++;
+					}
+				}
+				penumbra = float(hits) / float(ray_count);
+			} else {
+				LightmapRaycaster::Ray ray(position + light_dir * bias, light_dir, 0.0, MAX(dist - bias, 0.0f));
+				if (!raycaster->intersect(ray)) {
+					penumbra = 1.0;
+				}
+			}
+
+			Vector3 light_color = light.color * light.energy * attenuation * penumbra;
+			if (light.static_bake) {
+				static_light += light_color;
+				if (bake_sh) {
+					const float c[4] = {
+						0.282095f, // l0
+						0.488603f * light_dir.y, // l1n1
+						0.488603f * light_dir.z, // l1n0
+						0.488603f * light_dir.x, // l1p1
+					};
+					for (int j = 0; j < 4; j++) {
+						sh_accum[j] += light_color * c[j] * (1.0 / 3.0);
+					}
+				}
+			} else {
+				dynamic_light += light_color;
+			}
+		}
+
+		Vector3 texel_albedo = _lm_color_to_vector(albedo[index]);
+
+		dynamic_light *= texel_albedo; // If it will bounce, must multiply by albedo.
+		dynamic_light += _lm_color_to_vector(emission[index]);
+
+		// Keep for light probes.
+		light_primary_dynamic[index] = _lm_vector_to_color(dynamic_light);
+
+		dynamic_light += static_light * texel_albedo; // Send for bounces.
+		dynamic_light *= exposure_normalization;
+		(*bounce_source)[index] = _lm_vector_to_color(dynamic_light);
+
+		if (bake_sh) {
+			// Keep for adding at the end.
+			for (int j = 0; j < 4; j++) {
+				light_accum[_get_texel_index(slice * 4 + j, x, y)] = _lm_vector_to_color(sh_accum[j]);
+			}
+		} else {
+			light_accum[index] = _lm_vector_to_color(static_light * exposure_normalization);
+		}
+	}
+}
+
+void LightmapperCPU::_bounce_light_row(uint32_t p_row, void *p_userdata) {
+	const int slice = p_row / atlas_size.height;
+	const int y = p_row % atlas_size.height;
+
+	for (int x = 0; x < atlas_size.width; x++) {
+		const uint32_t index = _get_texel_index(slice, x, y);
+		const Texel &texel = texels[index];
+		if (texel.coverage == TEXEL_EMPTY) {
+			continue; // Empty texel, no process.
+		}
+
+		const Vector3 &position = texel.position;
+		const Vector3 &normal = texel.normal;
+
+		Vector3 v0 = Math::abs(normal.z) < 0.999 ? Vector3(0.0, 0.0, 1.0) : Vector3(0.0, 1.0, 0.0);
+		Vector3 tangent = v0.cross(normal).normalized();
+		Vector3 bitangent = tangent.cross(normal).normalized();
+		Basis normal_mat = Basis(tangent, bitangent, normal);
+
+		Vector3 sh_accum[4];
+		Vector3 light_total;
+		float active_rays = 0.0;
+		uint32_t noise = _lm_random_seed(0, x, y);
+		for (uint32_t i = 0; i < ray_count; i++) {
+			Vector3 ray_dir = normal_mat.xform(_lm_hemisphere_cosine_weighted_direction(noise));
+
+			Vector3 light;
+			LightmapRaycaster::Ray ray(position + ray_dir * bias, ray_dir, 0.0, world_size);
+			if (raycaster->intersect(ray)) {
+				if (ray.normal.dot(ray_dir) < 0.0) {
+					// Hit the front face of a triangle.
+					light = _lm_color_to_vector(_sample_hit(*bounce_source, ray));
+					active_rays += 1.0;
+				}
+			} else {
+				if (first_bounce) {
+					// Did not hit a triangle, reach out for the sky.
+					light = _lm_color_to_vector(_sample_environment(ray_dir));
+				}
+				active_rays += 1.0;
+			}
+
+			light_total += light;
+
+			if (bake_sh) {
+				const float c[4] = {
+					0.282095f, // l0
+					0.488603f * ray_dir.y, // l1n1
+					0.488603f * ray_dir.z, // l1n0
+					0.488603f * ray_dir.x, // l1p1
+				};
+				for (int j = 0; j < 4; j++) {
+					sh_accum[j] += light * c[j] * (8.0 / float(ray_count));
+				}
+			}
+		}
+
+		if (active_rays > 0) {
+			light_total /= active_rays;
+		}
+		(*bounce_dest)[index] = _lm_vector_to_color(light_total);
+
+		if (bake_sh) {
+			for (int j = 0; j < 4; j++) {
+				Color &accum = light_accum[_get_texel_index(slice * 4 + j, x, y)];
+				accum.r += sh_accum[j].x;
+				accum.g += sh_accum[j].y;
+				accum.b += sh_accum[j].z;
+			}
+		} else {
+			Color &accum = light_accum[index];
+			accum.r += light_total.x;
+			accum.g += light_total.y;
+			accum.b += light_total.z;
+		}
+	}
+}
+
+void LightmapperCPU::_light_probe(uint32_t p_probe, void *p_userdata) {
+	const Vector3 &position = probe_positions[p_probe];
+
+	Vector3 probe_sh_accum[9];
+
+	uint32_t noise = _lm_random_seed(0, p_probe, 49502741 /* some prime */);
+	for (uint32_t i = 0; i < ray_count; i++) {
+		Vector3 ray_dir = _lm_hemisphere_uniform_direction(noise);
+		if (i & 1) {
+			// Throw to both sides, so alternate them.
+			ray_dir.z *= -1.0;
+		}
+
+		Vector3 light;
+		LightmapRaycaster::Ray ray(position + ray_dir * bias, ray_dir, 0.0, world_size);
+		if (raycaster->intersect(ray)) {
+			if (ray.normal.dot(ray_dir) < 0.0) {
+				light = _lm_color_to_vector(_sample_hit(*bounce_dest, ray));
+				light += _lm_color_to_vector(_sample_hit(light_primary_dynamic, ray));
+			}
+		} else {
+			// Did not hit a triangle, reach out for the sky.
+			light = _lm_color_to_vector(_sample_environment(ray_dir));
+		}
+
+		const float c[9] = {
+			0.282095f, // l0
+			0.488603f * ray_dir.y, // l1n1
+			0.488603f * ray_dir.z, // l1n0
+			0.488603f * ray_dir.x, // l1p1
+			1.092548f * ray_dir.x * ray_dir.y, // l2n2
+			1.092548f * ray_dir.y * ray_dir.z, // l2n1
+			0.315392f * (3.0f * ray_dir.z * ray_dir.z - 1.0f), // l20
+			1.092548f * ray_dir.x * ray_dir.z, // l2p1
+			0.546274f * (ray_dir.x * ray_dir.x - ray_dir.y * ray_dir.y), // l2p2
+		};
+
+		for (int j = 0; j < 9; j++) {
+			probe_sh_accum[j] += light * c[j];
+		}
+	}
+
+	for (int j = 0; j < 9; j++) {
+		probe_values[p_probe * 9 + j] = _lm_vector_to_color(probe_sh_accum[j] * (4.0 / float(ray_count)), 0.0);
+	}
+}
+
+void LightmapperCPU::_dilate_row(uint32_t p_row, void *p_userdata) {
+	// Fill empty texels around the charts from their closest neighbors, in the same order as lm_compute.glsl.
+	static const Vector2i offsets[24] = {
+		// Sides first, as they are closer.
+		Vector2i(-1, 0), Vector2i(0, 1), Vector2i(1, 0), Vector2i(0, -1),
+		// Endpoints second.
+		Vector2i(-1, -1), Vector2i(-1, 1), Vector2i(1, -1), Vector2i(1, 1),
+		// Far sides third.
+		Vector2i(-2, 0), Vector2i(0, 2), Vector2i(2, 0), Vector2i(0, -2),
+		// Far-mid endpoints.
+		Vector2i(-2, -1), Vector2i(-2, 1), Vector2i(2, -1), Vector2i(2, 1),
+		Vector2i(-1, -2), Vector2i(-1, 2), Vector2i(1, -2), Vector2i(1, 2),
+		// Far endpoints.
+		Vector2i(-2, -2), Vector2i(-2, 2), Vector2i(2, -2), Vector2i(2, 2)
+	};
+
+	const int layer = p_row / atlas_size.height;
+	const int y = p_row % atlas_size.height;
+
+	for (int x = 0; x < atlas_size.width; x++) {
+		const uint32_t index = _get_texel_index(layer, x, y);
+		Color c = light_accum_copy[index];
+		for (int i = 0; i < 24 && c.a <= 0.5; i++) {
+			Vector2i pos = Vector2i(x, y) + offsets[i];
+			if (pos.x < 0 || pos.y < 0 || pos.x >= atlas_size.width || pos.y >= atlas_size.height) {
+				continue;
+			}
+			c = light_accum_copy[_get_texel_index(layer, pos.x, pos.y)];
+		}
+		light_accum[index] = c;
+	}
+}
+
+void LightmapperCPU::_dilate() {
+	light_accum_copy = light_accum;
+	_run_tasks(&LightmapperCPU::_dilate_row, atlas_layers * atlas_size.height, SNAME("LightmapperCPUDilate"));
+}
+
+void LightmapperCPU::_blend_seams_layer(uint32_t p_layer, void *p_userdata) {
+	// Average the light on both sides of each seam, sampling the lightmap before blending
+	// so the result does not depend on the order seams are processed.
+	const int slice = p_layer / (atlas_layers / atlas_slices);
+
+	for (const Seam &seam : seams) {
+		if (seam.slice != slice) {
+			continue;
+		}
+
+		float length = MAX(seam.a[0].distance_to(seam.a[1]), seam.b[0].distance_to(seam.b[1]));
+		int steps = MAX(int(Math::ceil(length * 2.0)), 1);
+		for (int i = 0; i <= steps; i++) {
+			float t = float(i) / steps;
+			Vector2 pos_a = seam.a[0].lerp(seam.a[1], t);
+			Vector2 pos_b = seam.b[0].lerp(seam.b[1], t);
+
+			Color blended = (_sample_layer(light_accum_copy, p_layer, pos_a) + _sample_layer(light_accum_copy, p_layer, pos_b)) * 0.5;
+			blended.a = 1.0;
+
+			const Vector2 positions[2] = { pos_a, pos_b };
+			for (int k = 0; k < 2; k++) {
+				int x = CLAMP(int(positions[k].x), 0, atlas_size.width - 1);
+				int y = CLAMP(int(positions[k].y), 0, atlas_size.height - 1);
+				if (texels[_get_texel_index(slice, x, y)].coverage == TEXEL_EMPTY) {
+					continue;
+				}
+				light_accum[_get_texel_index(p_layer, x, y)] = blended;
+			}
+		}
+	}
+}
+
+void LightmapperCPU::_clear_bake_state() {
+	raycaster.unref();
+	texels.clear();
+	albedo.clear();
+	emission.clear();
+	light_primary_dynamic.clear();
+	light_bounce[0].clear();
+	light_bounce[1].clear();
+	bounce_source = nullptr;
+	bounce_dest = nullptr;
+	light_accum.clear();
+	light_accum_copy.clear();
+	seams.clear();
+	environment.clear();
+}
+
+LightmapperCPU::BakeError LightmapperCPU::bake(BakeQuality p_quality, bool p_use_denoiser, int p_bounces, float p_bias, int p_max_texture_size, bool p_bake_sh, GenerateProbes p_generate_probes, const Ref<Image> &p_environment_panorama, const Basis &p_environment_transform, BakeStepFunc p_step_function, void *p_bake_userdata, float p_exposure_normalization) {
+	if (p_step_function) {
+		p_step_function(0.0, RTR("Begin Bake"), p_bake_userdata, true);
+	}
+	bake_textures.clear();
+
+	raycaster = LightmapRaycaster::create();
+	ERR_FAIL_COND_V_MSG(raycaster.is_null(), BAKE_ERROR_LIGHTMAP_CANT_PRE_BAKE_MESHES, "The CPU lightmapper requires a LightmapRaycaster (the raycast module), which is not available.");
+
+	/* STEP 1: Fetch material textures and pack them into the atlas */
+
+	atlas_size = Size2i();
+	atlas_slices = 0;
+	Vector<Ref<Image>> albedo_images;
+	Vector<Ref<Image>> emission_images;
+
+	BakeError bake_error = _blit_meshes_into_atlas(p_max_texture_size, albedo_images, emission_images, p_step_function, p_bake_userdata);
+	if (bake_error != BAKE_OK) {
+		_clear_bake_state();
+		return bake_error;
+	}
+
+	bake_sh = p_bake_sh;
+	bias = p_bias;
+	exposure_normalization = p_exposure_normalization;
+	environment_transform = p_environment_transform;
+	atlas_layers = atlas_slices * (bake_sh ? 4 : 1);
+
+	const uint32_t texel_count = atlas_size.width * atlas_size.height * atlas_slices;
+	const uint32_t slice_texel_count = atlas_size.width * atlas_size.height;
+
+	albedo.resize(texel_count);
+	emission.resize(texel_count);
+	for (int i = 0; i < atlas_slices; i++) {
+		albedo_images.write[i]->convert(Image::FORMAT_RGBAF);
+		emission_images.write[i]->convert(Image::FORMAT_RGBAF);
+		memcpy(&albedo[i * slice_texel_count], albedo_images[i]->get_data().ptr(), slice_texel_count * sizeof(Color));
+		memcpy(&emission[i * slice_texel_count], emission_images[i]->get_data().ptr(), slice_texel_count * sizeof(Color));
+	}
+	albedo_images.clear();
+	emission_images.clear();
+
+	{
+		Ref<Image> panorama;
+		if (p_environment_panorama.is_valid()) {
+			panorama = p_environment_panorama->duplicate();
+			panorama->convert(Image::FORMAT_RGBAF);
+		} else {
+			panorama = Image::create_empty(8, 8, false, Image::FORMAT_RGBAF);
+			panorama->fill(Color(0, 0, 0, 1));
+		}
+		environment_size = panorama->get_size();
+		environment.resize(environment_size.width * environment_size.height);
+		memcpy(environment.ptr(), panorama->get_data().ptr(), environment.size() * sizeof(Color));
+	}
+
+	/* STEP 2: Create the acceleration structure */
+
+	if (p_step_function) {
+		p_step_function(0.3, RTR("Creating acceleration structure"), p_bake_userdata, true);
+	}
+
+	AABB bounds;
+	for (int m_i = 0; m_i < mesh_instances.size(); m_i++) {
+		const MeshData &md = mesh_instances[m_i].data;
+		if (m_i == 0) {
+			bounds.position = md.points[0];
+		}
+		for (const Vector3 &point : md.points) {
+			bounds.expand_to(point);
+		}
+		raycaster->add_mesh(md.points, md.normal, md.uv2, m_i);
+	}
+	for (const Vector3 &probe_position : probe_positions) {
+		bounds.expand_to(probe_position);
+	}
+	bounds.grow_by(0.1); // Grow a bit to avoid numerical error.
+	world_size = bounds.size.length();
+
+	raycaster->commit();
+	_compute_seams();
+
+	/* STEP 3: Plot the geometry into the atlas texels */
+
+	if (p_step_function) {
+		p_step_function(0.4, RTR("Plotting meshes into the atlas"), p_bake_userdata, true);
+	}
+
+	texels.resize(texel_count);
+	_run_tasks(&LightmapperCPU::_plot_mesh, mesh_instances.size(), SNAME("LightmapperCPUPlotMeshes"));
+
+	if (p_step_function) {
+		p_step_function(0.49, RTR("Un-occluding geometry"), p_bake_userdata, true);
+	}
+
+	_run_tasks(&LightmapperCPU::_unocclude_row, atlas_slices * atlas_size.height, SNAME("LightmapperCPUUnocclude"));
+
+	/* STEP 4: Plot direct light */
+
+	if (p_step_function) {
+		p_step_function(0.5, RTR("Plot direct lighting"), p_bake_userdata, true);
+	}
+
+	switch (p_quality) {
+		case BAKE_QUALITY_LOW: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/low_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_MEDIUM: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/medium_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_HIGH: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/high_quality_ray_count");
+		} break;
+		case BAKE_QUALITY_ULTRA: {
+			ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/ultra_quality_ray_count");
+		} break;
+	}
+	ray_count = CLAMP(ray_count, 16u, 8192u);
+
+	_lm_clear_light(light_primary_dynamic, texel_count);
+	_lm_clear_light(light_bounce[0], texel_count);
+	_lm_clear_light(light_bounce[1], texel_count);
+	bounce_source = &light_bounce[0];
+	bounce_dest = &light_bounce[1];
+	_lm_clear_light(light_accum, slice_texel_count * atlas_layers);
+
+	_run_tasks(&LightmapperCPU::_direct_light_row, atlas_slices * atlas_size.height, SNAME("LightmapperCPUDirectLight"));
+
+	/* STEP 5: Integrate indirect light */
+
+	if (p_step_function) {
+		p_step_function(0.6, RTR("Integrate indirect lighting"), p_bake_userdata, true);
+	}
+
+	for (int b = 0; b < p_bounces; b++) {
+		if (b > 0) {
+			SWAP(bounce_source, bounce_dest);
+		}
+		// The environment only contributes to the first bounce.
+		first_bounce = b == 0;
+
+		_run_tasks(&LightmapperCPU::_bounce_light_row, atlas_slices * atlas_size.height, SNAME("LightmapperCPUBounceLight"));
+
+		if (p_step_function) {
+			float p = float(b + 1) / p_bounces * 0.1;
+			p_step_function(0.6 + p, vformat(RTR("Bounce %d/%d: Integrate indirect lighting"), b + 1, p_bounces), p_bake_userdata, false);
+		}
+	}
+
+	/* STEP 6: Light probes */
+
+	if (probe_positions.size()) {
+		if (p_step_function) {
+			p_step_function(0.7, RTR("Baking lightprobes"), p_bake_userdata, true);
+		}
+
+		switch (p_quality) {
+			case BAKE_QUALITY_LOW: {
+				ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/low_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_MEDIUM: {
+				ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/medium_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_HIGH: {
+				ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/high_quality_probe_ray_count");
+			} break;
+			case BAKE_QUALITY_ULTRA: {
+				ray_count = GLOBAL_GET("rendering/lightmapping/bake_quality/ultra_quality_probe_ray_count");
+			} break;
+		}
+		ray_count = CLAMP(ray_count, 16u, 8192u);
+
+		probe_values.resize(probe_positions.size() * 9);
+		_run_tasks(&LightmapperCPU::_light_probe, probe_positions.size(), SNAME("LightmapperCPULightProbes"));
+	}
+
+	_dilate();
+
+	/* STEP 7: Denoise */
+
+	if (p_use_denoiser) {
+		if (p_step_function) {
+			p_step_function(0.8, RTR("Denoising"), p_bake_userdata, true);
+		}
+
+		Ref<LightmapDenoiser> denoiser = LightmapDenoiser::create();
+		if (denoiser.is_valid()) {
+			for (int i = 0; i < atlas_layers; i++) {
+				Color *layer = &light_accum[i * slice_texel_count];
+
+				Vector<uint8_t> s;
+				s.resize(slice_texel_count * sizeof(Color));
+				memcpy(s.ptrw(), layer, s.size());
+				Ref<Image> img = Image::create_from_data(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAF, s);
+
+				Ref<Image> denoised = denoiser->denoise_image(img);
+				if (denoised != img) {
+					denoised->convert(Image::FORMAT_RGBAF);
+					const Color *src = (const Color *)denoised->get_data().ptr();
+					for (uint32_t j = 0; j < slice_texel_count; j++) {
+						// Restore alpha.
+						layer[j] = Color(src[j].r, src[j].g, src[j].b, layer[j].a);
+					}
+				}
+			}
+		} else {
+			WARN_PRINT("Denoising was requested, but no lightmap denoiser is available.");
+		}
+
+		_dilate();
+	}
+
+	/* STEP 8: Blend seams */
+
+	if (p_step_function) {
+		p_step_function(0.9, RTR("Blending seams"), p_bake_userdata, true);
+	}
+
+	if (seams.size()) {
+		light_accum_copy = light_accum;
+		_run_tasks(&LightmapperCPU::_blend_seams_layer, atlas_layers, SNAME("LightmapperCPUBlendSeams"));
+	}
+
+	for (int i = 0; i < atlas_layers; i++) {
+		Vector<uint8_t> s;
+		s.resize(slice_texel_count * sizeof(Color));
+		memcpy(s.ptrw(), &light_accum[i * slice_texel_count], s.size());
+		Ref<Image> img = Image::create_from_data(atlas_size.width, atlas_size.height, false, Image::FORMAT_RGBAF, s);
+		img->convert(Image::FORMAT_RGBH); // Remove alpha.
+		bake_textures.push_back(img);
+	}
+
+	_clear_bake_state();
+
+	return BAKE_OK;
+}
+
+int LightmapperCPU::get_bake_texture_count() const {
+	return bake_textures.size();
+}
+
+Ref<Image> LightmapperCPU::get_bake_texture(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, bake_textures.size(), Ref<Image>());
+	return bake_textures[p_index];
+}
+
+int LightmapperCPU::get_bake_mesh_count() const {
+	return mesh_instances.size();
+}
+
+Variant LightmapperCPU::get_bake_mesh_userdata(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), Variant());
+	return mesh_instances[p_index].data.userdata;
+}
+
+Rect2 LightmapperCPU::get_bake_mesh_uv_scale(int p_index) const {
+	ERR_FAIL_COND_V(bake_textures.size() == 0, Rect2());
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), Rect2());
+	Rect2 uv_ofs;
+	Vector2 texture_size = Vector2(bake_textures[0]->get_width(), bake_textures[0]->get_height());
+	uv_ofs.position = Vector2(mesh_instances[p_index].offset) / texture_size;
+	uv_ofs.size = Vector2(mesh_instances[p_index].data.albedo_on_uv2->get_width(), mesh_instances[p_index].data.albedo_on_uv2->get_height()) / texture_size;
+	return uv_ofs;
+}
+
+int LightmapperCPU::get_bake_mesh_texture_slice(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, mesh_instances.size(), 0);
+	return mesh_instances[p_index].slice;
+}
+
+int LightmapperCPU::get_bake_probe_count() const {
+	return probe_positions.size();
+}
+
+Vector3 LightmapperCPU::get_bake_probe_point(int p_probe) const {
+	ERR_FAIL_INDEX_V(p_probe, (int)probe_positions.size(), Vector3());
+	return probe_positions[p_probe];
+}
+
+Vector<Color> LightmapperCPU::get_bake_probe_sh(int p_probe) const {
+	ERR_FAIL_INDEX_V(p_probe, (int)probe_positions.size(), Vector<Color>());
+	Vector<Color> ret;
+	ret.resize(9);
+	memcpy(ret.ptrw(), &probe_values[p_probe * 9], sizeof(Color) * 9);
+	return ret;
+}
+
+LightmapperCPU::LightmapperCPU() {
+}
@@ -0,0 +1,196 @@
+/**************************************************************************/
+/*  lightmapper_cpu.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef LIGHTMAPPER_CPU_H
+#define LIGHTMAPPER_CPU_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "scene/3d/lightmapper.h"
+
+// Bakes lightmaps on the CPU, tracing rays through LightmapRaycaster (Embree) and spreading the work
+// over the WorkerThreadPool. It follows the same steps as LightmapperRD so both backends produce
+// comparable results, but does not need a RenderingDevice, so it can be used on headless machines.
+class LightmapperCPU : public Lightmapper {
+	GDCLASS(LightmapperCPU, Lightmapper)
+
+	struct MeshInstance {
+		MeshData data;
+		int slice = 0;
+		Vector2i offset;
+	};
+
+	struct Light {
+		Vector3 position;
+		uint32_t type = LIGHT_TYPE_DIRECTIONAL;
+		Vector3 direction;
+		float energy = 0.0;
+		Vector3 color;
+		float size = 0.0;
+		float range = 0.0;
+		float attenuation = 0.0;
+		float cos_spot_angle = 0.0;
+		float inv_spot_attenuation = 0.0;
+		float shadow_blur = 0.0;
+		bool static_bake = false;
+	};
+
+	enum TexelCoverage : uint8_t {
+		TEXEL_EMPTY,
+		TEXEL_EDGE, // Touched by a triangle edge, but its center is outside of it.
+		TEXEL_INTERIOR,
+	};
+
+	// Surface point rasterized into an atlas texel, the CPU equivalent of the position, normal and
+	// unocclude textures of LightmapperRD.
+	struct Texel {
+		Vector3 position;
+		Vector3 normal;
+		Vector3 face_normal;
+		float texel_size = 0.0;
+		TexelCoverage coverage = TEXEL_EMPTY;
+	};
+
+	struct Edge {
+		Vector3 a;
+		Vector3 b;
+		Vector3 na;
+		Vector3 nb;
+		bool operator==(const Edge &p_seam) const {
+			return a == p_seam.a && b == p_seam.b && na == p_seam.na && nb == p_seam.nb;
+		}
+	};
+
+	struct EdgeHash {
+		_FORCE_INLINE_ static uint32_t hash(const Edge &p_edge) {
+			uint32_t h = hash_murmur3_one_float(p_edge.a.x);
+			h = hash_murmur3_one_float(p_edge.a.y, h);
+			h = hash_murmur3_one_float(p_edge.a.z, h);
+			h = hash_murmur3_one_float(p_edge.b.x, h);
+			h = hash_murmur3_one_float(p_edge.b.y, h);
+			h = hash_murmur3_one_float(p_edge.b.z, h);
+			return h;
+		}
+	};
+
+	struct EdgeUV2 {
+		Vector2 a;
+		Vector2 b;
+		bool seam_found = false;
+	};
+
+	// Edge shared by two triangles that are not connected in UV2 space, in atlas texel coordinates.
+	struct Seam {
+		Vector2 a[2];
+		Vector2 b[2];
+		int slice = 0;
+	};
+
+	Vector<MeshInstance> mesh_instances;
+	LocalVector<Light> lights;
+	LocalVector<Vector3> probe_positions;
+	LocalVector<Color> probe_values;
+	Vector<Ref<Image>> bake_textures;
+
+	/* Bake state, only valid while baking */
+
+	Ref<LightmapRaycaster> raycaster;
+	Size2i atlas_size;
+	int atlas_slices = 0;
+	int atlas_layers = 0; // atlas_slices * 4 when baking SH.
+	bool bake_sh = false;
+	float bias = 0.0;
+	float world_size = 0.0;
+	float exposure_normalization = 1.0;
+	uint32_t ray_count = 0;
+	bool first_bounce = false;
+
+	LocalVector<Texel> texels;
+	LocalVector<Color> albedo;
+	LocalVector<Color> emission;
+	LocalVector<Color> light_primary_dynamic;
+	LocalVector<Color> light_bounce[2];
+	LocalVector<Color> *bounce_source = nullptr;
+	LocalVector<Color> *bounce_dest = nullptr;
+	LocalVector<Color> light_accum;
+	LocalVector<Color> light_accum_copy;
+	LocalVector<Seam> seams;
+
+	LocalVector<Color> environment;
+	Size2i environment_size;
+	Basis environment_transform;
+
+	_FORCE_INLINE_ uint32_t _get_texel_index(int p_slice, int p_x, int p_y) const {
+		return (uint32_t(p_slice) * atlas_size.height + p_y) * atlas_size.width + p_x;
+	}
+
+	Color _sample_layer(const LocalVector<Color> &p_light, int p_layer, const Vector2 &p_pos) const;
+	Color _sample_hit(const LocalVector<Color> &p_light, const LightmapRaycaster::Ray &p_ray) const;
+	Color _sample_environment(const Vector3 &p_dir) const;
+
+	template <class M>
+	void _run_tasks(M p_method, uint32_t p_elements, const String &p_description);
+
+	BakeError _blit_meshes_into_atlas(int p_max_texture_size, Vector<Ref<Image>> &r_albedo_images, Vector<Ref<Image>> &r_emission_images, BakeStepFunc p_step_function, void *p_bake_userdata);
+	void _compute_seams();
+
+	void _plot_mesh(uint32_t p_mesh, void *p_userdata);
+	void _unocclude_row(uint32_t p_row, void *p_userdata);
+	void _direct_light_row(uint32_t p_row, void *p_userdata);
+	void _bounce_light_row(uint32_t p_row, void *p_userdata);
+	void _light_probe(uint32_t p_probe, void *p_userdata);
+	void _dilate_row(uint32_t p_row, void *p_userdata);
+	void _blend_seams_layer(uint32_t p_layer, void *p_userdata);
+
+	void _dilate();
+	void _clear_bake_state();
+
+public:
+	virtual void add_mesh(const MeshData &p_mesh) override;
+	virtual void add_directional_light(bool p_static, const Vector3 &p_direction, const Color &p_color, float p_energy, float p_angular_distance, float p_shadow_blur) override;
+	virtual void add_omni_light(bool p_static, const Vector3 &p_position, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_size, float p_shadow_blur) override;
+	virtual void add_spot_light(bool p_static, const Vector3 &p_position, const Vector3 p_direction, const Color &p_color, float p_energy, float p_range, float p_attenuation, float p_spot_angle, float p_spot_attenuation, float p_size, float p_shadow_blur) override;
+	virtual void add_probe(const Vector3 &p_position) override;
+	virtual BakeError bake(BakeQuality p_quality, bool p_use_denoiser, int p_bounces, float p_bias, int p_max_texture_size, bool p_bake_sh, GenerateProbes p_generate_probes, const Ref<Image> &p_environment_panorama, const Basis &p_environment_transform, BakeStepFunc p_step_function = nullptr, void *p_bake_userdata = nullptr, float p_exposure_normalization = 1.0) override;
+
+	int get_bake_texture_count() const override;
+	Ref<Image> get_bake_texture(int p_index) const override;
+	int get_bake_mesh_count() const override;
+	Variant get_bake_mesh_userdata(int p_index) const override;
+	Rect2 get_bake_mesh_uv_scale(int p_index) const override;
+	int get_bake_mesh_texture_slice(int p_index) const override;
+	int get_bake_probe_count() const override;
+	Vector3 get_bake_probe_point(int p_probe) const override;
+	Vector<Color> get_bake_probe_sh(int p_probe) const override;
+
+	LightmapperCPU();
+};
+
+#endif // LIGHTMAPPER_CPU_H
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_lightmapper_cpu.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_LIGHTMAPPER_CPU_H
+#define TEST_LIGHTMAPPER_CPU_H
+
+#include "../lightmapper_cpu.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/image.h"
+#include "modules/raycast/lightmap_raycaster_embree.h"
+
+#include "tests/test_macros.h"
+
+namespace TestLightmapperCPU {
+
+// Horizontal quad facing up, with its UV2 covering the whole lightmap.
+static Lightmapper::MeshData create_quad(const Vector3 &p_center, float p_half_size, int p_lightmap_size) {
+	Lightmapper::MeshData md;
+	const Vector3 corners[4] = {
+		p_center + Vector3(-p_half_size, 0, -p_half_size),
+		p_center + Vector3(p_half_size, 0, -p_half_size),
+		p_center + Vector3(p_half_size, 0, p_half_size),
+		p_center + Vector3(-p_half_size, 0, p_half_size),
+	};
+	const Vector2 uvs[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+	const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i = 0; i < 6; i++) {
+		md.points.push_back(corners[indices[i]]);
+		md.uv2.push_back(uvs[indices[i]]);
+		md.normal.push_back(Vector3(0, 1, 0));
+	}
+
+	md.albedo_on_uv2 = Image::create_empty(p_lightmap_size, p_lightmap_size, false, Image::FORMAT_RGBA8);
+	md.albedo_on_uv2->fill(Color(1, 1, 1, 1));
+	md.emission_on_uv2 = Image::create_empty(p_lightmap_size, p_lightmap_size, false, Image::FORMAT_RGBAH);
+	md.emission_on_uv2->fill(Color(0, 0, 0, 1));
+	return md;
+}
+
+TEST_CASE("[LightmapperCPU] Bake direct light and shadows") {
+	LightmapRaycasterEmbree::make_default_raycaster();
+	ProjectSettings::get_singleton()->set_setting("rendering/lightmapping/bake_quality/low_quality_ray_count", 16);
+	ProjectSettings::get_singleton()->set_setting("rendering/lightmapping/bake_quality/low_quality_probe_ray_count", 64);
+
+	Ref<LightmapperCPU> lightmapper;
+	lightmapper.instantiate();
+
+	// A floor with a smaller quad above its left half, lit from straight above.
+	const int floor_size = 32;
+	lightmapper->add_mesh(create_quad(Vector3(), 1.0, floor_size));
+	lightmapper->add_mesh(create_quad(Vector3(-0.75, 1.0, 0), 0.75, 8));
+	lightmapper->add_directional_light(true, Vector3(0, -1, 0), Color(1, 1, 1), 1.0, 0.0, 1.0);
+	lightmapper->add_probe(Vector3(0.5, 0.5, 0));
+
+	Lightmapper::BakeError err = lightmapper->bake(Lightmapper::BAKE_QUALITY_LOW, false, 1, 0.005, 1024, false, Lightmapper::GENERATE_PROBES_DISABLED, Ref<Image>(), Basis());
+	REQUIRE(err == Lightmapper::BAKE_OK);
+	REQUIRE(lightmapper->get_bake_texture_count() == 1);
+
+	Ref<Image> lightmap = lightmapper->get_bake_texture(0);
+	CHECK(lightmap->get_format() == Image::FORMAT_RGBH);
+
+	const int floor_slice = lightmapper->get_bake_mesh_texture_slice(0);
+	CHECK(floor_slice == 0);
+	const Rect2 floor_rect = lightmapper->get_bake_mesh_uv_scale(0);
+	const Vector2i floor_offset = Vector2i((floor_rect.position * lightmap->get_size()).round());
+
+	const Color lit = lightmap->get_pixel(floor_offset.x + floor_size * 7 / 8, floor_offset.y + floor_size / 2);
+	const Color shadowed = lightmap->get_pixel(floor_offset.x + floor_size / 8, floor_offset.y + floor_size / 2);
+	CHECK_MESSAGE(lit.r == doctest::Approx(1.0).epsilon(0.05), "Texels facing the light should receive its full energy.");
+	CHECK_MESSAGE(shadowed.r < 0.1, "Texels under the occluder should be in shadow.");
+
+	REQUIRE(lightmapper->get_bake_probe_count() == 1);
+	CHECK(lightmapper->get_bake_probe_sh(0).size() == 9);
+}
+
+} // namespace TestLightmapperCPU
+
+#endif // TEST_LIGHTMAPPER_CPU_H
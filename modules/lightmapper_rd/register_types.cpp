@@ -37,6 +37,10 @@
 
 #ifndef _3D_DISABLED
 static Lightmapper *create_lightmapper_rd() {
+	if (!RenderingDevice::get_singleton()) {
+		// Not running on a RenderingDevice backend (e.g. headless), let the CPU lightmapper be used instead.
+		return nullptr;
+	}
 	return memnew(LightmapperRD);
 }
 #endif
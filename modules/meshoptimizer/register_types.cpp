@@ -40,6 +40,8 @@ void initialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
 	}
 
 	SurfaceTool::optimize_vertex_cache_func = meshopt_optimizeVertexCache;
+	SurfaceTool::optimize_overdraw_func = meshopt_optimizeOverdraw;
+	SurfaceTool::optimize_vertex_fetch_remap_func = meshopt_optimizeVertexFetchRemap;
 	SurfaceTool::simplify_func = meshopt_simplify;
 	SurfaceTool::simplify_with_attrib_func = meshopt_simplifyWithAttributes;
 	SurfaceTool::simplify_scale_func = meshopt_simplifyScale;
@@ -55,6 +57,8 @@ void uninitialize_meshoptimizer_module(ModuleInitializationLevel p_level) {
 	}
 
 	SurfaceTool::optimize_vertex_cache_func = nullptr;
+	SurfaceTool::optimize_overdraw_func = nullptr;
+	SurfaceTool::optimize_vertex_fetch_remap_func = nullptr;
 	SurfaceTool::simplify_func = nullptr;
 	SurfaceTool::simplify_scale_func = nullptr;
 	SurfaceTool::simplify_sloppy_func = nullptr;
@@ -51,6 +51,9 @@ void RaycastOcclusionCull::RaycastHZBuffer::clear() {
 	camera_ray_masks.clear();
 	camera_rays_tile_count = 0;
 	tile_grid_size = Size2i();
+	tile_marks.clear();
+	update_tiles.clear();
+	history_valid = false;
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::resize(const Size2i &p_size) {
@@ -78,11 +81,109 @@ void RaycastOcclusionCull::RaycastHZBuffer::resize(const Size2i &p_size) {
 
 	camera_ray_masks.resize(camera_rays_tile_count * TILE_RAYS);
 	memset(camera_ray_masks.ptr(), ~0, camera_rays_tile_count * TILE_RAYS * sizeof(uint32_t));
+
+	tile_marks.resize(camera_rays_tile_count);
+	history_valid = false;
+}
+
+void RaycastOcclusionCull::RaycastHZBuffer::_mark_tiles_for_aabb(const AABB &p_aabb, const Projection &p_cam_matrix, bool &r_all) {
+	Vector2 min = Vector2(1e20, 1e20);
+	Vector2 max = Vector2(-1e20, -1e20);
+
+	for (int i = 0; i < 8; i++) {
+		Vector3 corner = p_aabb.get_endpoint(i);
+		Vector4 clip = p_cam_matrix.xform(Vector4(corner.x, corner.y, corner.z, 1.0f));
+		if (clip.w <= CMP_EPSILON) {
+			// Crosses the camera plane, can't be bound on screen reliably.
+			r_all = true;
+			return;
+		}
+		Vector2 ndc = Vector2(clip.x, clip.y) / clip.w;
+		min = min.min(ndc);
+		max = max.max(ndc);
+	}
+
+	if (max.x < -1.0f || max.y < -1.0f || min.x > 1.0f || min.y > 1.0f) {
+		return; // Off-screen.
+	}
+
+	const Size2i &buffer_size = sizes[0];
+
+	// Convert to tile coordinates, expanding by one tile to account for rays hitting near the edges.
+	int from_x = CLAMP(int(Math::floor((min.x * 0.5f + 0.5f) * buffer_size.x / TILE_SIZE)) - 1, 0, tile_grid_size.x - 1);
+	int from_y = CLAMP(int(Math::floor((min.y * 0.5f + 0.5f) * buffer_size.y / TILE_SIZE)) - 1, 0, tile_grid_size.y - 1);
+	int to_x = CLAMP(int(Math::floor((max.x * 0.5f + 0.5f) * buffer_size.x / TILE_SIZE)) + 1, 0, tile_grid_size.x - 1);
+	int to_y = CLAMP(int(Math::floor((max.y * 0.5f + 0.5f) * buffer_size.y / TILE_SIZE)) + 1, 0, tile_grid_size.y - 1);
+
+	for (int y = from_y; y <= to_y; y++) {
+		for (int x = from_x; x <= to_x; x++) {
+			uint32_t tile_index = y * tile_grid_size.x + x;
+			if (!tile_marks[tile_index]) {
+				tile_marks[tile_index] = 1;
+				update_tiles.push_back(tile_index);
+			}
+		}
+	}
+}
+
+bool RaycastOcclusionCull::RaycastHZBuffer::compute_update_tiles(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Scenario &p_scenario) {
+	update_tiles.clear();
+
+	bool full_update = !history_valid || !raycast_singleton->temporal_reuse;
+	full_update = full_update || p_cam_transform != last_cam_transform || p_cam_projection != last_cam_projection || p_cam_orthogonal != last_cam_orthogonal;
+	// We only know what changed in the most recent scene swap, anything older requires a full update.
+	full_update = full_update || (p_scenario.version != last_scenario_version && (p_scenario.version != last_scenario_version + 1 || p_scenario.committed_all));
+	full_update = full_update || (raycast_singleton->temporal_reuse_max_frames > 0 && reused_frames >= raycast_singleton->temporal_reuse_max_frames);
+
+	if (full_update) {
+		history_valid = true;
+		last_cam_transform = p_cam_transform;
+		last_cam_projection = p_cam_projection;
+		last_cam_orthogonal = p_cam_orthogonal;
+		last_scenario_version = p_scenario.version;
+		reused_frames = 0;
+		return true; // Empty update_tiles means all tiles.
+	}
+
+	reused_frames++;
+
+	if (p_scenario.version == last_scenario_version) {
+		return false; // Nothing moved, the buffer is still valid.
+	}
+
+	last_scenario_version = p_scenario.version;
+
+	if (p_scenario.committed_aabbs.is_empty()) {
+		return false;
+	}
+
+	Projection cam_matrix = p_cam_projection * Projection(p_cam_transform.affine_inverse());
+	bool all = false;
+	for (const AABB &aabb : p_scenario.committed_aabbs) {
+		_mark_tiles_for_aabb(aabb, cam_matrix, all);
+		if (all) {
+			break;
+		}
+	}
+
+	for (const uint32_t &tile_index : update_tiles) {
+		tile_marks[tile_index] = 0;
+	}
+
+	if (all || update_tiles.size() == camera_rays_tile_count) {
+		update_tiles.clear();
+		reused_frames = 0;
+		return true;
+	}
+
+	return !update_tiles.is_empty();
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
 	CameraRayThreadData td;
 	td.thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	td.tiles = update_tiles.is_empty() ? nullptr : update_tiles.ptr();
+	td.tile_count = update_tiles.is_empty() ? camera_rays_tile_count : update_tiles.size();
 
 	td.z_near = p_cam_projection.get_z_near();
 	td.z_far = p_cam_projection.get_z_far() * 1.05f;
@@ -113,7 +214,7 @@ void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::_camera_rays_threaded(uint32_t p_thread, const CameraRayThreadData *p_data) {
-	uint32_t total_tiles = camera_rays_tile_count;
+	uint32_t total_tiles = p_data->tile_count;
 	uint32_t total_threads = p_data->thread_count;
 	uint32_t from = p_thread * total_tiles / total_threads;
 	uint32_t to = (p_thread + 1 == total_threads) ? total_tiles : ((p_thread + 1) * total_tiles / total_threads);
@@ -123,7 +224,8 @@ void RaycastOcclusionCull::RaycastHZBuffer::_camera_rays_threaded(uint32_t p_thr
 void RaycastOcclusionCull::RaycastHZBuffer::_generate_camera_rays(const CameraRayThreadData *p_data, int p_from, int p_to) {
 	const Size2i &buffer_size = sizes[0];
 
-	for (int i = p_from; i < p_to; i++) {
+	for (int k = p_from; k < p_to; k++) {
+		int i = p_data->tiles ? p_data->tiles[k] : k;
 		CameraRayTile &tile = camera_rays[i];
 		int tile_x = (i % tile_grid_size.x) * TILE_SIZE;
 		int tile_y = (i / tile_grid_size.x) * TILE_SIZE;
@@ -226,6 +328,15 @@ void RaycastOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3
 	occluder->vertices = p_vertices;
 	occluder->indices = p_indices;
 
+	occluder->aabb = AABB();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = p_vertices[i];
+		} else {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+
 	for (const InstanceID &E : occluder->users) {
 		RID scenario_rid = E.scenario;
 		RID instance_rid = E.instance;
@@ -304,6 +415,7 @@ void RaycastOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance,
 
 	if (instance.enabled != p_enabled) {
 		instance.enabled = p_enabled;
+		scenario.changed_aabbs.push_back(instance.xformed_aabb);
 		scenario.dirty = true; // The scenario needs a scene re-build, but the instance doesn't need update
 	}
 
@@ -374,6 +486,8 @@ void RaycastOcclusionCull::Scenario::_update_dirty_instance(int p_idx, RID *p_in
 
 	occ_inst->indices.resize(occ->indices.size());
 	memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+
+	occ_inst->xformed_aabb = occ_inst->xform.xform(occ->aabb);
 }
 
 void RaycastOcclusionCull::Scenario::_transform_vertices_thread(uint32_t p_thread, TransformThreadData *p_data) {
@@ -408,6 +522,10 @@ bool RaycastOcclusionCull::Scenario::update() {
 		if (commit_done) {
 			commit_thread->wait_to_finish();
 			current_scene_idx = 1 - current_scene_idx;
+
+			committed_aabbs = committing_aabbs;
+			committed_all = committing_all;
+			version++;
 		} else {
 			return false;
 		}
@@ -428,9 +546,21 @@ bool RaycastOcclusionCull::Scenario::update() {
 	}
 
 	for (const RID &scenario : removed_instances) {
+		const OccluderInstance *occ_inst = instances.getptr(scenario);
+		if (occ_inst && occ_inst->enabled) {
+			changed_aabbs.push_back(occ_inst->xformed_aabb);
+		}
 		instances.erase(scenario);
 	}
 
+	// Both the old and new bounds of updated instances are invalidated.
+	for (const RID &instance : dirty_instances_array) {
+		const OccluderInstance *occ_inst = instances.getptr(instance);
+		if (occ_inst && occ_inst->enabled) {
+			changed_aabbs.push_back(occ_inst->xformed_aabb);
+		}
+	}
+
 	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
 		// Lots of instances, use per-instance threading
 		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance_thread, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RaycastOcclusionCullUpdate"));
@@ -443,10 +573,22 @@ bool RaycastOcclusionCull::Scenario::update() {
 		}
 	}
 
+	for (const RID &instance : dirty_instances_array) {
+		const OccluderInstance *occ_inst = instances.getptr(instance);
+		if (occ_inst && occ_inst->enabled) {
+			changed_aabbs.push_back(occ_inst->xformed_aabb);
+		}
+	}
+
 	dirty_instances.clear();
 	dirty_instances_array.clear();
 	removed_instances.clear();
 
+	committing_aabbs = changed_aabbs;
+	committing_all = changed_all;
+	changed_aabbs.clear();
+	changed_all = false;
+
 	if (raycast_singleton->ebr_device == nullptr) {
 		raycast_singleton->_init_embree();
 	}
@@ -488,10 +630,11 @@ void RaycastOcclusionCull::Scenario::_raycast(uint32_t p_idx, const RaycastThrea
 	rtcInitIntersectContext(&ctx);
 	ctx.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
 
-	rtcIntersect16((const int *)&p_raycast_data->masks[p_idx * TILE_RAYS], ebr_scene[current_scene_idx], &ctx, &p_raycast_data->rays[p_idx]);
+	uint32_t tile_index = p_raycast_data->tiles ? p_raycast_data->tiles[p_idx] : p_idx;
+	rtcIntersect16((const int *)&p_raycast_data->masks[tile_index * TILE_RAYS], ebr_scene[current_scene_idx], &ctx, &p_raycast_data->rays[tile_index]);
 }
 
-void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const {
+void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count, const uint32_t *p_tiles) const {
 	ERR_FAIL_COND(singleton == nullptr);
 	if (raycast_singleton->ebr_device == nullptr) {
 		return; // Embree is initialized on demand when there is some scenario with occluders in it.
@@ -504,6 +647,7 @@ void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32
 	RaycastThreadData td;
 	td.rays = r_rays;
 	td.masks = p_valid_masks;
+	td.tiles = p_tiles;
 
 	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_raycast, &td, p_tile_count, -1, true, SNAME("RaycastOcclusionCullRaycast"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
@@ -525,6 +669,7 @@ void RaycastOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
 	ERR_FAIL_COND(!buffers.has(p_buffer));
 	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
 	buffers[p_buffer].scenario_rid = p_scenario;
+	buffers[p_buffer].invalidate_history();
 }
 
 void RaycastOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
@@ -552,9 +697,17 @@ void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_
 		return;
 	}
 
+	if (!buffer.compute_update_tiles(p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario)) {
+		return; // Last frame's buffer is still valid.
+	}
+
 	buffer.update_camera_rays(p_cam_transform, p_cam_projection, p_cam_orthogonal);
 
-	scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.camera_rays_tile_count);
+	if (buffer.update_tiles.is_empty()) {
+		scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.camera_rays_tile_count);
+	} else {
+		scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.update_tiles.size(), buffer.update_tiles.ptr());
+	}
 	buffer.sort_rays(-p_cam_transform.basis.get_column(2), p_cam_orthogonal);
 	buffer.update_mips();
 }
@@ -582,6 +735,7 @@ void RaycastOcclusionCull::set_build_quality(RS::ViewportOcclusionCullingBuildQu
 
 	for (KeyValue<RID, Scenario> &K : scenarios) {
 		K.value.dirty = true;
+		K.value.changed_all = true;
 	}
 }
 
@@ -599,6 +753,8 @@ RaycastOcclusionCull::RaycastOcclusionCull() {
 	raycast_singleton = this;
 	int default_quality = GLOBAL_GET("rendering/occlusion_culling/bvh_build_quality");
 	build_quality = RS::ViewportOcclusionCullingBuildQuality(default_quality);
+	temporal_reuse = GLOBAL_GET("rendering/occlusion_culling/temporal_reuse");
+	temporal_reuse_max_frames = GLOBAL_GET("rendering/occlusion_culling/temporal_reuse_max_frames");
 }
 
 RaycastOcclusionCull::~RaycastOcclusionCull() {
@@ -45,6 +45,8 @@
 class RaycastOcclusionCull : public RendererSceneOcclusionCull {
 	typedef RTCRayHit16 CameraRayTile;
 
+	struct Scenario;
+
 public:
 	class RaycastHZBuffer : public HZBuffer {
 	private:
@@ -52,6 +54,8 @@ public:
 
 		struct CameraRayThreadData {
 			int thread_count;
+			uint32_t tile_count;
+			const uint32_t *tiles = nullptr;
 			float z_near;
 			float z_far;
 			Vector3 camera_dir;
@@ -65,16 +69,29 @@ public:
 
 		void _camera_rays_threaded(uint32_t p_thread, const CameraRayThreadData *p_data);
 		void _generate_camera_rays(const CameraRayThreadData *p_data, int p_from, int p_to);
+		void _mark_tiles_for_aabb(const AABB &p_aabb, const Projection &p_cam_matrix, bool &r_all);
+
+		// Temporal coherence: state of the last trace, used to re-trace only invalidated tiles.
+		bool history_valid = false;
+		Transform3D last_cam_transform;
+		Projection last_cam_projection;
+		bool last_cam_orthogonal = false;
+		uint64_t last_scenario_version = 0;
+		uint32_t reused_frames = 0;
+		LocalVector<uint8_t> tile_marks;
 
 	public:
 		unsigned int camera_rays_tile_count = 0;
 		uint8_t *camera_rays_unaligned_buffer = nullptr;
 		CameraRayTile *camera_rays = nullptr;
 		LocalVector<uint32_t> camera_ray_masks;
+		LocalVector<uint32_t> update_tiles;
 		RID scenario_rid;
 
 		virtual void clear() override;
 		virtual void resize(const Size2i &p_size) override;
+		void invalidate_history() { history_valid = false; }
+		bool compute_update_tiles(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const Scenario &p_scenario);
 		void sort_rays(const Vector3 &p_camera_dir, bool p_orthogonal);
 		void update_camera_rays(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
 
@@ -103,6 +120,7 @@ private:
 	struct Occluder {
 		PackedVector3Array vertices;
 		PackedInt32Array indices;
+		AABB aabb;
 		HashSet<InstanceID, InstanceID> users;
 	};
 
@@ -110,6 +128,7 @@ private:
 		RID occluder;
 		LocalVector<uint32_t> indices;
 		LocalVector<Vector3> xformed_vertices;
+		AABB xformed_aabb;
 		Transform3D xform;
 		bool enabled = true;
 		bool removed = false;
@@ -119,6 +138,7 @@ private:
 		struct RaycastThreadData {
 			CameraRayTile *rays = nullptr;
 			const uint32_t *masks;
+			const uint32_t *tiles = nullptr;
 		};
 
 		struct TransformThreadData {
@@ -142,6 +162,16 @@ private:
 		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
 		LocalVector<RID> removed_instances;
 
+		// World-space bounds of geometry changed since the last build, plus the set belonging to
+		// the scene being committed and the one that became current in the last swap.
+		LocalVector<AABB> changed_aabbs;
+		LocalVector<AABB> committing_aabbs;
+		LocalVector<AABB> committed_aabbs;
+		bool changed_all = false;
+		bool committing_all = false;
+		bool committed_all = false;
+		uint64_t version = 0;
+
 		void _update_dirty_instance_thread(int p_idx, RID *p_instances);
 		void _update_dirty_instance(int p_idx, RID *p_instances);
 		void _transform_vertices_thread(uint32_t p_thread, TransformThreadData *p_data);
@@ -150,7 +180,7 @@ private:
 		bool update();
 
 		void _raycast(uint32_t p_thread, const RaycastThreadData *p_raycast_data) const;
-		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const;
+		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count, const uint32_t *p_tiles = nullptr) const;
 	};
 
 	static RaycastOcclusionCull *raycast_singleton;
@@ -163,6 +193,8 @@ private:
 	HashMap<RID, Scenario> scenarios;
 	HashMap<RID, RaycastHZBuffer> buffers;
 	RS::ViewportOcclusionCullingBuildQuality build_quality;
+	bool temporal_reuse = true;
+	uint32_t temporal_reuse_max_frames = 0;
 
 	void _init_embree();
 
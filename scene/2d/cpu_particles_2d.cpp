@@ -31,6 +31,7 @@
 #include "cpu_particles_2d.h"
 
 #include "core/core_string_names.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/2d/gpu_particles_2d.h"
 #include "scene/resources/particle_process_material.h"
 
@@ -629,6 +630,11 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	Particle *parray = w;
 
+	if (particle_steps.size() != uint32_t(pcount)) {
+		particle_steps.resize(pcount);
+	}
+	ParticleStep *steps = particle_steps.ptr();
+
 	double prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -650,8 +656,12 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	// Restarting particles consumes the global random number generator, so it is done serially
+	// and in order to keep emission deterministic. Everything else is processed in parallel below.
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.state = PARTICLE_STEP_SKIP;
 
 		if (!emitting && !p.active) {
 			continue;
@@ -716,6 +726,7 @@ void CPUParticles2D::_particles_process(double p_delta) {
 				continue;
 			}
 			p.active = true;
+			step.state = PARTICLE_STEP_RESTART;
 
 			/*real_t tex_linear_velocity = 0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
@@ -813,108 +824,158 @@ void CPUParticles2D::_particles_process(double p_delta) {
 
 		} else if (!p.active) {
 			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
 		} else {
-			uint32_t alt_seed = p.seed;
+			step.state = PARTICLE_STEP_UPDATE;
+		}
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
-			tv = p.time / p.lifetime;
+		step.delta = local_delta;
+	}
 
-			real_t tex_linear_velocity = 1.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
-			}
+	// Gradients sort their points lazily, make sure this happens before sampling them from several threads.
+	if (color_ramp.is_valid()) {
+		(void)color_ramp->get_color_at_offset(0.0);
+	}
 
-			real_t tex_orbit_velocity = 1.0;
-			if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-				tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
-			}
+	ParticleProcessData process_data;
+	process_data.particles = parray;
+	process_data.steps = steps;
+	process_data.emission_xform = emission_xform;
+	process_data.count = pcount;
+
+	// Serial on pool threads (sub-thread process groups), see WorkerThreadPool::get_thread_index().
+	int task_count = (pcount + PARTICLES_PER_PROCESS_TASK - 1) / PARTICLES_PER_PROCESS_TASK;
+	if (task_count > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_particles_process_group, &process_data, task_count, -1, true, SNAME("CPUParticles2DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_particles_process_range(process_data, 0, pcount);
+	}
+}
 
-			real_t tex_angular_velocity = 1.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
-			}
+void CPUParticles2D::_particles_process_group(uint32_t p_index, const ParticleProcessData *p_data) {
+	int from = p_index * PARTICLES_PER_PROCESS_TASK;
+	int to = MIN(from + PARTICLES_PER_PROCESS_TASK, p_data->count);
+	_particles_process_range(*p_data, from, to);
+}
 
-			real_t tex_linear_accel = 1.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
-			}
+void CPUParticles2D::_particles_process_range(const ParticleProcessData &p_data, int p_from, int p_to) {
+	const Transform2D &emission_xform = p_data.emission_xform;
 
-			real_t tex_tangential_accel = 1.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
-			}
+	for (int i = p_from; i < p_to; i++) {
+		const ParticleStep &step = p_data.steps[i];
+		if (step.state == PARTICLE_STEP_SKIP) {
+			continue;
+		}
 
-			real_t tex_radial_accel = 1.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
-			}
+		Particle &p = p_data.particles[i];
+		double local_delta = step.delta;
+		float tv = 0.0;
 
-			real_t tex_damping = 1.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
-			}
+		if (step.state == PARTICLE_STEP_UPDATE) {
+			if (p.time > p.lifetime) {
+				p.active = false;
+				tv = 1.0;
+			} else {
+				uint32_t alt_seed = p.seed;
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
-			real_t tex_anim_speed = 1.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
-			}
+				p.time += local_delta;
+				p.custom[1] = p.time / lifetime;
+				tv = p.time / p.lifetime;
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
-			}
+				real_t tex_linear_velocity = 1.0;
+				if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+					tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
+				}
 
-			Vector2 force = gravity;
-			Vector2 pos = p.transform[2];
-
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply radial acceleration
-			Vector2 org = emission_xform[2];
-			Vector2 diff = pos - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
-			//apply tangential acceleration;
-			Vector2 yx = Vector2(diff.y, diff.x);
-			force += yx.length() > 0.0 ? yx.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
-			if (orbit_amount != 0.0) {
-				real_t ang = orbit_amount * local_delta * Math_TAU;
-				// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
-				// but we use -ang here to reproduce its behavior.
-				Transform2D rot = Transform2D(-ang, Vector2());
-				p.transform[2] -= diff;
-				p.transform[2] += rot.basis_xform(diff);
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+				real_t tex_orbit_velocity = 1.0;
+				if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+					tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
+				}
+
+				real_t tex_angular_velocity = 1.0;
+				if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+					tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
+				}
+
+				real_t tex_linear_accel = 1.0;
+				if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+					tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+				}
+
+				real_t tex_tangential_accel = 1.0;
+				if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+					tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+				}
+
+				real_t tex_radial_accel = 1.0;
+				if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+					tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
+				}
 
-			if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
-				real_t v = p.velocity.length();
-				real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector2();
-				} else {
-					p.velocity = p.velocity.normalized() * v;
+				real_t tex_damping = 1.0;
+				if (curve_parameters[PARAM_DAMPING].is_valid()) {
+					tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
 				}
+
+				real_t tex_angle = 1.0;
+				if (curve_parameters[PARAM_ANGLE].is_valid()) {
+					tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+				}
+				real_t tex_anim_speed = 1.0;
+				if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+					tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
+				}
+
+				real_t tex_anim_offset = 1.0;
+				if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+					tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
+				}
+
+				Vector2 force = gravity;
+				Vector2 pos = p.transform[2];
+
+				//apply linear acceleration
+				force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+				//apply radial acceleration
+				Vector2 org = emission_xform[2];
+				Vector2 diff = pos - org;
+				force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector2();
+				//apply tangential acceleration;
+				Vector2 yx = Vector2(diff.y, diff.x);
+				force += yx.length() > 0.0 ? yx.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector2();
+				//apply attractor forces
+				p.velocity += force * local_delta;
+				//orbit velocity
+				real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
+				if (orbit_amount != 0.0) {
+					real_t ang = orbit_amount * local_delta * Math_TAU;
+					// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
+					// but we use -ang here to reproduce its behavior.
+					Transform2D rot = Transform2D(-ang, Vector2());
+					p.transform[2] -= diff;
+					p.transform[2] += rot.basis_xform(diff);
+				}
+				if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+					p.velocity = p.velocity.normalized() * tex_linear_velocity;
+				}
+
+				if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
+					real_t v = p.velocity.length();
+					real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
+					v -= damp * local_delta;
+					if (v < 0.0) {
+						p.velocity = Vector2();
+					} else {
+						p.velocity = p.velocity.normalized() * v;
+					}
+				}
+				real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+				base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
+				p.rotation = Math::deg_to_rad(base_angle); //angle
+				p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
 			}
-			real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
-			p.rotation = Math::deg_to_rad(base_angle); //angle
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed));
 		}
+
 		//apply color
 		//apply hue rotation
 
@@ -1007,7 +1068,6 @@ void CPUParticles2D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1023,42 +1083,18 @@ void CPUParticles2D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
-
-		Transform2D t = r[idx].transform;
+	ParticleBufferData buffer_data;
+	buffer_data.particles = r;
+	buffer_data.order = order;
+	buffer_data.data = w;
+	buffer_data.count = pc;
 
-		if (!local_coords) {
-			t = inv_emission_transform * t;
-		}
-
-		if (r[idx].active) {
-			ptr[0] = t.columns[0][0];
-			ptr[1] = t.columns[1][0];
-			ptr[2] = 0;
-			ptr[3] = t.columns[2][0];
-			ptr[4] = t.columns[0][1];
-			ptr[5] = t.columns[1][1];
-			ptr[6] = 0;
-			ptr[7] = t.columns[2][1];
-
-		} else {
-			memset(ptr, 0, sizeof(float) * 8);
-		}
-
-		Color c = r[idx].color;
-
-		ptr[8] = c.r;
-		ptr[9] = c.g;
-		ptr[10] = c.b;
-		ptr[11] = c.a;
-
-		ptr[12] = r[idx].custom[0];
-		ptr[13] = r[idx].custom[1];
-		ptr[14] = r[idx].custom[2];
-		ptr[15] = r[idx].custom[3];
-
-		ptr += 16;
+	int task_count = (pc + PARTICLES_PER_BUFFER_TASK - 1) / PARTICLES_PER_BUFFER_TASK;
+	if (task_count > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles2D::_update_particle_data_group, &buffer_data, task_count, -1, true, SNAME("CPUParticles2DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_update_particle_data_range(buffer_data, 0, pc);
 	}
 }
 
@@ -1089,6 +1125,52 @@ void CPUParticles2D::_set_do_redraw(bool p_do_redraw) {
 	queue_redraw(); // redraw to update render list
 }
 
+void CPUParticles2D::_update_particle_data_group(uint32_t p_index, const ParticleBufferData *p_data) {
+	int from = p_index * PARTICLES_PER_BUFFER_TASK;
+	int to = MIN(from + PARTICLES_PER_BUFFER_TASK, p_data->count);
+	_update_particle_data_range(*p_data, from, to);
+}
+
+void CPUParticles2D::_update_particle_data_range(const ParticleBufferData &p_data, int p_from, int p_to) {
+	for (int i = p_from; i < p_to; i++) {
+		int idx = p_data.order ? p_data.order[i] : i;
+		float *ptr = p_data.data + i * 16;
+		const Particle &particle = p_data.particles[idx];
+
+		Transform2D t = particle.transform;
+
+		if (!local_coords) {
+			t = inv_emission_transform * t;
+		}
+
+		if (particle.active) {
+			ptr[0] = t.columns[0][0];
+			ptr[1] = t.columns[1][0];
+			ptr[2] = 0;
+			ptr[3] = t.columns[2][0];
+			ptr[4] = t.columns[0][1];
+			ptr[5] = t.columns[1][1];
+			ptr[6] = 0;
+			ptr[7] = t.columns[2][1];
+
+		} else {
+			memset(ptr, 0, sizeof(float) * 8);
+		}
+
+		Color c = particle.color;
+
+		ptr[8] = c.r;
+		ptr[9] = c.g;
+		ptr[10] = c.b;
+		ptr[11] = c.a;
+
+		ptr[12] = particle.custom[0];
+		ptr[13] = particle.custom[1];
+		ptr[14] = particle.custom[2];
+		ptr[15] = particle.custom[3];
+	}
+}
+
 void CPUParticles2D::_update_render_thread() {
 	MutexLock lock(update_mutex);
 
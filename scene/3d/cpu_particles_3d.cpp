@@ -30,6 +30,7 @@
 
 #include "cpu_particles_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/camera_3d.h"
 #include "scene/3d/gpu_particles_3d.h"
 #include "scene/main/viewport.h"
@@ -650,6 +651,11 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 	Particle *parray = w;
 
+	if (particle_steps.size() != uint32_t(pcount)) {
+		particle_steps.resize(pcount);
+	}
+	ParticleStep *steps = particle_steps.ptr();
+
 	double prev_time = time;
 	time += p_delta;
 	if (time > lifetime) {
@@ -670,8 +676,12 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 	double system_phase = time / lifetime;
 
+	// Restarting particles consumes the global random number generator, so it is done serially
+	// and in order to keep emission deterministic. Everything else is processed in parallel below.
 	for (int i = 0; i < pcount; i++) {
 		Particle &p = parray[i];
+		ParticleStep &step = steps[i];
+		step.state = PARTICLE_STEP_SKIP;
 
 		if (!emitting && !p.active) {
 			continue;
@@ -736,6 +746,7 @@ void CPUParticles3D::_particles_process(double p_delta) {
 				continue;
 			}
 			p.active = true;
+			step.state = PARTICLE_STEP_RESTART;
 
 			/*real_t tex_linear_velocity = 0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
@@ -895,121 +906,171 @@ void CPUParticles3D::_particles_process(double p_delta) {
 
 		} else if (!p.active) {
 			continue;
-		} else if (p.time > p.lifetime) {
-			p.active = false;
-			tv = 1.0;
 		} else {
-			uint32_t alt_seed = p.seed;
+			step.state = PARTICLE_STEP_UPDATE;
+		}
 
-			p.time += local_delta;
-			p.custom[1] = p.time / lifetime;
-			tv = p.time / p.lifetime;
+		step.delta = local_delta;
+	}
 
-			real_t tex_linear_velocity = 1.0;
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
-			}
+	// Gradients sort their points lazily, make sure this happens before sampling them from several threads.
+	if (color_ramp.is_valid()) {
+		(void)color_ramp->get_color_at_offset(0.0);
+	}
 
-			real_t tex_orbit_velocity = 1.0;
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
-					tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
+	ParticleProcessData process_data;
+	process_data.particles = parray;
+	process_data.steps = steps;
+	process_data.emission_xform = emission_xform;
+	process_data.count = pcount;
+
+	// Serial on pool threads (sub-thread process groups), see WorkerThreadPool::get_thread_index().
+	int task_count = (pcount + PARTICLES_PER_PROCESS_TASK - 1) / PARTICLES_PER_PROCESS_TASK;
+	if (task_count > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_particles_process_group, &process_data, task_count, -1, true, SNAME("CPUParticles3DProcess"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_particles_process_range(process_data, 0, pcount);
+	}
+}
+
+void CPUParticles3D::_particles_process_group(uint32_t p_index, const ParticleProcessData *p_data) {
+	int from = p_index * PARTICLES_PER_PROCESS_TASK;
+	int to = MIN(from + PARTICLES_PER_PROCESS_TASK, p_data->count);
+	_particles_process_range(*p_data, from, to);
+}
+
+void CPUParticles3D::_particles_process_range(const ParticleProcessData &p_data, int p_from, int p_to) {
+	const Transform3D &emission_xform = p_data.emission_xform;
+
+	for (int i = p_from; i < p_to; i++) {
+		const ParticleStep &step = p_data.steps[i];
+		if (step.state == PARTICLE_STEP_SKIP) {
+			continue;
+		}
+
+		Particle &p = p_data.particles[i];
+		double local_delta = step.delta;
+		float tv = 0.0;
+
+		if (step.state == PARTICLE_STEP_UPDATE) {
+			if (p.time > p.lifetime) {
+				p.active = false;
+				tv = 1.0;
+			} else {
+				uint32_t alt_seed = p.seed;
+
+				p.time += local_delta;
+				p.custom[1] = p.time / lifetime;
+				tv = p.time / p.lifetime;
+
+				real_t tex_linear_velocity = 1.0;
+				if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+					tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->sample(tv);
 				}
-			}
 
-			real_t tex_angular_velocity = 1.0;
-			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
-			}
+				real_t tex_orbit_velocity = 1.0;
+				if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+					if (curve_parameters[PARAM_ORBIT_VELOCITY].is_valid()) {
+						tex_orbit_velocity = curve_parameters[PARAM_ORBIT_VELOCITY]->sample(tv);
+					}
+				}
 
-			real_t tex_linear_accel = 1.0;
-			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
-			}
+				real_t tex_angular_velocity = 1.0;
+				if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
+					tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->sample(tv);
+				}
 
-			real_t tex_tangential_accel = 1.0;
-			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
-			}
+				real_t tex_linear_accel = 1.0;
+				if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
+					tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->sample(tv);
+				}
 
-			real_t tex_radial_accel = 1.0;
-			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
-			}
+				real_t tex_tangential_accel = 1.0;
+				if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
+					tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->sample(tv);
+				}
 
-			real_t tex_damping = 1.0;
-			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
-			}
+				real_t tex_radial_accel = 1.0;
+				if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
+					tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->sample(tv);
+				}
 
-			real_t tex_angle = 1.0;
-			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
-			}
-			real_t tex_anim_speed = 1.0;
-			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
-			}
+				real_t tex_damping = 1.0;
+				if (curve_parameters[PARAM_DAMPING].is_valid()) {
+					tex_damping = curve_parameters[PARAM_DAMPING]->sample(tv);
+				}
 
-			real_t tex_anim_offset = 1.0;
-			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
-			}
+				real_t tex_angle = 1.0;
+				if (curve_parameters[PARAM_ANGLE].is_valid()) {
+					tex_angle = curve_parameters[PARAM_ANGLE]->sample(tv);
+				}
+				real_t tex_anim_speed = 1.0;
+				if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
+					tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->sample(tv);
+				}
 
-			Vector3 force = gravity;
-			Vector3 position = p.transform.origin;
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				position.z = 0.0;
-			}
-			//apply linear acceleration
-			force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
-			//apply radial acceleration
-			Vector3 org = emission_xform.origin;
-			Vector3 diff = position - org;
-			force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				Vector2 yx = Vector2(diff.y, diff.x);
-				Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
-				force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
+				real_t tex_anim_offset = 1.0;
+				if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
+					tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->sample(tv);
+				}
 
-			} else {
-				Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
-				force += crossDiff.length() > 0.0 ? crossDiff.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
-			}
-			//apply attractor forces
-			p.velocity += force * local_delta;
-			//orbit velocity
-			if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
-				real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
-				if (orbit_amount != 0.0) {
-					real_t ang = orbit_amount * local_delta * Math_TAU;
-					// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
-					// but we use -ang here to reproduce its behavior.
-					Transform2D rot = Transform2D(-ang, Vector2());
-					Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
-					p.transform.origin -= Vector3(diff.x, diff.y, 0);
-					p.transform.origin += Vector3(rotv.x, rotv.y, 0);
+				Vector3 force = gravity;
+				Vector3 position = p.transform.origin;
+				if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+					position.z = 0.0;
 				}
-			}
-			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				p.velocity = p.velocity.normalized() * tex_linear_velocity;
-			}
+				//apply linear acceleration
+				force += p.velocity.length() > 0.0 ? p.velocity.normalized() * tex_linear_accel * Math::lerp(parameters_min[PARAM_LINEAR_ACCEL], parameters_max[PARAM_LINEAR_ACCEL], rand_from_seed(alt_seed)) : Vector3();
+				//apply radial acceleration
+				Vector3 org = emission_xform.origin;
+				Vector3 diff = position - org;
+				force += diff.length() > 0.0 ? diff.normalized() * (tex_radial_accel)*Math::lerp(parameters_min[PARAM_RADIAL_ACCEL], parameters_max[PARAM_RADIAL_ACCEL], rand_from_seed(alt_seed)) : Vector3();
+				if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+					Vector2 yx = Vector2(diff.y, diff.x);
+					Vector2 yx2 = (yx * Vector2(-1.0, 1.0)).normalized();
+					force += yx.length() > 0.0 ? Vector3(yx2.x, yx2.y, 0.0) * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
 
-			if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
-				real_t v = p.velocity.length();
-				real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
-				v -= damp * local_delta;
-				if (v < 0.0) {
-					p.velocity = Vector3();
 				} else {
-					p.velocity = p.velocity.normalized() * v;
+					Vector3 crossDiff = diff.normalized().cross(gravity.normalized());
+					force += crossDiff.length() > 0.0 ? crossDiff.normalized() * (tex_tangential_accel * Math::lerp(parameters_min[PARAM_TANGENTIAL_ACCEL], parameters_max[PARAM_TANGENTIAL_ACCEL], rand_from_seed(alt_seed))) : Vector3();
+				}
+				//apply attractor forces
+				p.velocity += force * local_delta;
+				//orbit velocity
+				if (particle_flags[PARTICLE_FLAG_DISABLE_Z]) {
+					real_t orbit_amount = tex_orbit_velocity * Math::lerp(parameters_min[PARAM_ORBIT_VELOCITY], parameters_max[PARAM_ORBIT_VELOCITY], rand_from_seed(alt_seed));
+					if (orbit_amount != 0.0) {
+						real_t ang = orbit_amount * local_delta * Math_TAU;
+						// Not sure why the ParticleProcessMaterial code uses a clockwise rotation matrix,
+						// but we use -ang here to reproduce its behavior.
+						Transform2D rot = Transform2D(-ang, Vector2());
+						Vector2 rotv = rot.basis_xform(Vector2(diff.x, diff.y));
+						p.transform.origin -= Vector3(diff.x, diff.y, 0);
+						p.transform.origin += Vector3(rotv.x, rotv.y, 0);
+					}
 				}
+				if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
+					p.velocity = p.velocity.normalized() * tex_linear_velocity;
+				}
+
+				if (parameters_max[PARAM_DAMPING] + tex_damping > 0.0) {
+					real_t v = p.velocity.length();
+					real_t damp = tex_damping * Math::lerp(parameters_min[PARAM_DAMPING], parameters_max[PARAM_DAMPING], rand_from_seed(alt_seed));
+					v -= damp * local_delta;
+					if (v < 0.0) {
+						p.velocity = Vector3();
+					} else {
+						p.velocity = p.velocity.normalized() * v;
+					}
+				}
+				real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
+				base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
+				p.custom[0] = Math::deg_to_rad(base_angle); //angle
+				p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed)); //angle
 			}
-			real_t base_angle = (tex_angle)*Math::lerp(parameters_min[PARAM_ANGLE], parameters_max[PARAM_ANGLE], p.angle_rand);
-			base_angle += p.custom[1] * lifetime * tex_angular_velocity * Math::lerp(parameters_min[PARAM_ANGULAR_VELOCITY], parameters_max[PARAM_ANGULAR_VELOCITY], rand_from_seed(alt_seed));
-			p.custom[0] = Math::deg_to_rad(base_angle); //angle
-			p.custom[2] = tex_anim_offset * Math::lerp(parameters_min[PARAM_ANIM_OFFSET], parameters_max[PARAM_ANIM_OFFSET], p.anim_offset_rand) + tv * tex_anim_speed * Math::lerp(parameters_min[PARAM_ANIM_SPEED], parameters_max[PARAM_ANIM_SPEED], rand_from_seed(alt_seed)); //angle
 		}
+
 		//apply color
 		//apply hue rotation
 
@@ -1149,7 +1210,6 @@ void CPUParticles3D::_update_particle_data_buffer() {
 
 	float *w = particle_data.ptrw();
 	const Particle *r = particles.ptr();
-	float *ptr = w;
 
 	if (draw_order != DRAW_ORDER_INDEX) {
 		ow = particle_order.ptrw();
@@ -1184,16 +1244,42 @@ void CPUParticles3D::_update_particle_data_buffer() {
 		}
 	}
 
-	for (int i = 0; i < pc; i++) {
-		int idx = order ? order[i] : i;
+	ParticleBufferData buffer_data;
+	buffer_data.particles = r;
+	buffer_data.order = order;
+	buffer_data.data = w;
+	buffer_data.count = pc;
 
-		Transform3D t = r[idx].transform;
+	int task_count = (pc + PARTICLES_PER_BUFFER_TASK - 1) / PARTICLES_PER_BUFFER_TASK;
+	if (task_count > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &CPUParticles3D::_update_particle_data_group, &buffer_data, task_count, -1, true, SNAME("CPUParticles3DUpdateBuffer"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_update_particle_data_range(buffer_data, 0, pc);
+	}
+
+	can_update.set();
+}
+
+void CPUParticles3D::_update_particle_data_group(uint32_t p_index, const ParticleBufferData *p_data) {
+	int from = p_index * PARTICLES_PER_BUFFER_TASK;
+	int to = MIN(from + PARTICLES_PER_BUFFER_TASK, p_data->count);
+	_update_particle_data_range(*p_data, from, to);
+}
+
+void CPUParticles3D::_update_particle_data_range(const ParticleBufferData &p_data, int p_from, int p_to) {
+	for (int i = p_from; i < p_to; i++) {
+		int idx = p_data.order ? p_data.order[i] : i;
+		float *ptr = p_data.data + i * 20;
+		const Particle &particle = p_data.particles[idx];
+
+		Transform3D t = particle.transform;
 
 		if (!local_coords) {
 			t = inv_emission_transform * t;
 		}
 
-		if (r[idx].active) {
+		if (particle.active) {
 			ptr[0] = t.basis.rows[0][0];
 			ptr[1] = t.basis.rows[0][1];
 			ptr[2] = t.basis.rows[0][2];
@@ -1210,22 +1296,18 @@ void CPUParticles3D::_update_particle_data_buffer() {
 			memset(ptr, 0, sizeof(float) * 12);
 		}
 
-		Color c = r[idx].color;
+		Color c = particle.color;
 
 		ptr[12] = c.r;
 		ptr[13] = c.g;
 		ptr[14] = c.b;
 		ptr[15] = c.a;
 
-		ptr[16] = r[idx].custom[0];
-		ptr[17] = r[idx].custom[1];
-		ptr[18] = r[idx].custom[2];
-		ptr[19] = r[idx].custom[3];
-
-		ptr += 20;
+		ptr[16] = particle.custom[0];
+		ptr[17] = particle.custom[1];
+		ptr[18] = particle.custom[2];
+		ptr[19] = particle.custom[3];
 	}
-
-	can_update.set();
 }
 
 void CPUParticles3D::_set_redraw(bool p_redraw) {
@@ -31,6 +31,7 @@
 #ifndef CPU_PARTICLES_3D_H
 #define CPU_PARTICLES_3D_H
 
+#include "core/templates/local_vector.h"
 #include "scene/3d/visual_instance_3d.h"
 
 class CPUParticles3D : public GeometryInstance3D {
@@ -185,9 +186,44 @@ private:
 
 	Vector3 gravity = Vector3(0, -9.8, 0);
 
+	enum ParticleStepState : uint8_t {
+		PARTICLE_STEP_SKIP,
+		PARTICLE_STEP_RESTART,
+		PARTICLE_STEP_UPDATE,
+	};
+
+	struct ParticleStep {
+		double delta = 0.0;
+		ParticleStepState state = PARTICLE_STEP_SKIP;
+	};
+
+	LocalVector<ParticleStep> particle_steps;
+
+	struct ParticleProcessData {
+		Particle *particles = nullptr;
+		const ParticleStep *steps = nullptr;
+		Transform3D emission_xform;
+		int count = 0;
+	};
+
+	struct ParticleBufferData {
+		const Particle *particles = nullptr;
+		const int *order = nullptr;
+		float *data = nullptr;
+		int count = 0;
+	};
+
+	// Particle ranges handed to each worker thread task.
+	static constexpr int PARTICLES_PER_PROCESS_TASK = 256;
+	static constexpr int PARTICLES_PER_BUFFER_TASK = 1024;
+
 	void _update_internal();
 	void _particles_process(double p_delta);
+	void _particles_process_group(uint32_t p_index, const ParticleProcessData *p_data);
+	void _particles_process_range(const ParticleProcessData &p_data, int p_from, int p_to);
 	void _update_particle_data_buffer();
+	void _update_particle_data_group(uint32_t p_index, const ParticleBufferData *p_data);
+	void _update_particle_data_range(const ParticleBufferData &p_data, int p_from, int p_to);
 
 	Mutex update_mutex;
 
@@ -38,6 +38,7 @@
 #include "scene/resources/camera_attributes.h"
 #include "scene/resources/environment.h"
 #include "scene/resources/sky.h"
+#include "servers/display_server.h"
 
 void LightmapGIData::add_user(const NodePath &p_path, const Rect2 &p_uv_scale, int p_slice_index, int32_t p_sub_instance) {
 	User user;
@@ -781,6 +782,19 @@ LightmapGI::BakeError LightmapGI::bake(Node *p_from_node, String p_image_data_pa
 			}
 			TypedArray<Image> images = RS::get_singleton()->bake_render_uv2(mf.mesh->get_rid(), overrides, lightmap_size);
 
+			if (images.is_empty() && DisplayServer::get_singleton()->get_name() == "headless") {
+				// Materials can't be rendered without a GPU, bake with a white albedo and no emission
+				// so CPU lightmappers can still be used (e.g. on build servers).
+				WARN_PRINT_ONCE("Baking lightmaps without a renderer, materials are replaced by a white albedo.");
+				images.resize(RS::BAKE_CHANNEL_EMISSION + 1);
+				for (int i = 0; i < images.size(); i++) {
+					images[i] = Image::create_empty(lightmap_size.width, lightmap_size.height, false, Image::FORMAT_RGBA8);
+				}
+				Ref<Image>(images[RS::BAKE_CHANNEL_ALBEDO_ALPHA])->fill(Color(1, 1, 1, 1));
+				Ref<Image>(images[RS::BAKE_CHANNEL_ORM])->fill(Color(1, 1, 0, 1));
+				Ref<Image>(images[RS::BAKE_CHANNEL_EMISSION])->fill(Color(0, 0, 0, 1));
+			}
+
 			ERR_FAIL_COND_V(images.is_empty(), BAKE_ERROR_CANT_CREATE_IMAGE);
 
 			Ref<Image> albedo = images[RS::BAKE_CHANNEL_ALBEDO_ALPHA];
@@ -0,0 +1,291 @@
+/**************************************************************************/
+/*  vertex_animation_baker.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "vertex_animation_baker.h"
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/resources/material.h"
+
+static const char *vertex_animation_shader_code = R"(
+// Generated by VertexAnimationBaker.
+shader_type spatial;
+
+uniform sampler2D position_texture : filter_nearest, repeat_disable;
+uniform sampler2D normal_texture : filter_nearest, repeat_disable;
+uniform int frame_count = 1;
+uniform int rows_per_frame = 1;
+uniform float fps = 30.0;
+uniform vec4 albedo : source_color = vec4(1.0);
+uniform sampler2D albedo_texture : source_color, filter_linear_mipmap, repeat_enable;
+
+void vertex() {
+	// INSTANCE_CUSTOM.x offsets the animation of each MultiMesh instance, so crowds don't move in lockstep.
+	float frame = mod(floor(TIME * fps + INSTANCE_CUSTOM.x * float(frame_count)), float(frame_count));
+	ivec2 texel = ivec2(UV2 * vec2(textureSize(position_texture, 0)));
+	texel.y += int(frame) * rows_per_frame;
+	VERTEX = texelFetch(position_texture, texel, 0).xyz;
+	NORMAL = texelFetch(normal_texture, texel, 0).xyz;
+}
+
+void fragment() {
+	vec4 albedo_tex = texture(albedo_texture, UV);
+	ALBEDO = albedo.rgb * albedo_tex.rgb;
+}
+)";
+
+Error VertexAnimationBaker::bake(MeshInstance3D *p_mesh_instance, AnimationPlayer *p_player, const StringName &p_animation, float p_fps) {
+	ERR_FAIL_NULL_V(p_mesh_instance, ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_player, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_fps <= 0.0, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_player->is_playing(), ERR_BUSY, "Stop the AnimationPlayer before baking its animations.");
+
+	Ref<Mesh> source_mesh = p_mesh_instance->get_mesh();
+	ERR_FAIL_COND_V_MSG(source_mesh.is_null(), ERR_INVALID_PARAMETER, "The MeshInstance3D has no mesh to bake.");
+	Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(p_mesh_instance->get_node_or_null(p_mesh_instance->get_skeleton_path()));
+	ERR_FAIL_NULL_V_MSG(skeleton, ERR_INVALID_PARAMETER, "The MeshInstance3D is not bound to a Skeleton3D.");
+	Ref<Animation> animation = p_player->get_animation(p_animation);
+	ERR_FAIL_COND_V_MSG(animation.is_null(), ERR_INVALID_PARAMETER, vformat("Animation not found: %s.", p_animation));
+
+	// Without an explicit skin, the skeleton binds every bone to its rest pose.
+	Ref<Skin> skin = p_mesh_instance->get_skin();
+	Ref<SkinReference> skin_ref;
+	if (skin.is_null()) {
+		skin_ref = skeleton->register_skin(Ref<Skin>());
+		skin = skin_ref->get_skin();
+	}
+	ERR_FAIL_COND_V(skin.is_null(), ERR_BUG);
+
+	LocalVector<int> bind_bones;
+	bind_bones.resize(skin->get_bind_count());
+	for (int i = 0; i < skin->get_bind_count(); i++) {
+		int bone = skin->get_bind_bone(i);
+		if (bone < 0) {
+			bone = skeleton->find_bone(skin->get_bind_name(i));
+		}
+		bind_bones[i] = bone;
+	}
+
+	int surface_count = source_mesh->get_surface_count();
+	LocalVector<Array> surface_arrays;
+	surface_arrays.resize(surface_count);
+	int total_vertices = 0;
+	for (int i = 0; i < surface_count; i++) {
+		surface_arrays[i] = source_mesh->surface_get_arrays(i);
+		total_vertices += PackedVector3Array(surface_arrays[i][Mesh::ARRAY_VERTEX]).size();
+	}
+	ERR_FAIL_COND_V_MSG(total_vertices == 0, ERR_INVALID_PARAMETER, "The mesh has no vertices to bake.");
+
+	int new_frame_count = MAX(1, int(Math::ceil(animation->get_length() * p_fps)));
+	int width = MIN(total_vertices, int(MAX_TEXTURE_WIDTH));
+	int new_rows_per_frame = (total_vertices + width - 1) / width;
+	int height = new_rows_per_frame * new_frame_count;
+	ERR_FAIL_COND_V_MSG(height > MAX_TEXTURE_HEIGHT, ERR_OUT_OF_MEMORY, vformat("Baking %d frames of %d vertices needs a texture taller than %d pixels. Lower the FPS or split the mesh.", new_frame_count, total_vertices, MAX_TEXTURE_HEIGHT));
+
+	Vector<uint8_t> position_data;
+	position_data.resize(width * height * 4 * sizeof(float));
+	memset(position_data.ptrw(), 0, position_data.size());
+	Vector<uint8_t> normal_data;
+	normal_data.resize(width * height * 4 * sizeof(float));
+	memset(normal_data.ptrw(), 0, normal_data.size());
+	float *positions = (float *)position_data.ptrw();
+	float *normals = (float *)normal_data.ptrw();
+
+	String previous_animation = p_player->get_assigned_animation();
+	double previous_position = previous_animation.is_empty() ? 0.0 : p_player->get_current_animation_position();
+	p_player->set_assigned_animation(p_animation);
+
+	LocalVector<Transform3D> bone_transforms;
+	bone_transforms.resize(bind_bones.size());
+	AABB aabb;
+	bool first_vertex = true;
+
+	for (int frame = 0; frame < new_frame_count; frame++) {
+		p_player->seek(frame / p_fps, true);
+
+		for (uint32_t i = 0; i < bind_bones.size(); i++) {
+			bone_transforms[i] = bind_bones[i] >= 0 ? skeleton->get_bone_global_pose(bind_bones[i]) * skin->get_bind_pose(i) : Transform3D();
+		}
+
+		int vertex_index = 0;
+		for (int i = 0; i < surface_count; i++) {
+			const Array &arrays = surface_arrays[i];
+			PackedVector3Array vertices = arrays[Mesh::ARRAY_VERTEX];
+			PackedVector3Array vertex_normals = arrays[Mesh::ARRAY_NORMAL];
+			PackedInt32Array bones = arrays[Mesh::ARRAY_BONES];
+			Vector<float> weights = arrays[Mesh::ARRAY_WEIGHTS];
+			int weights_per_vertex = (source_mesh->surface_get_format(i) & Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS) ? 8 : 4;
+			bool skinned = bones.size() == vertices.size() * weights_per_vertex && weights.size() == bones.size();
+
+			for (int j = 0; j < vertices.size(); j++) {
+				Vector3 vertex = vertices[j];
+				Vector3 normal = j < vertex_normals.size() ? vertex_normals[j] : Vector3(0, 1, 0);
+
+				if (skinned) {
+					Vector3 skinned_vertex;
+					Vector3 skinned_normal;
+					float total_weight = 0.0;
+					for (int k = 0; k < weights_per_vertex; k++) {
+						float weight = weights[j * weights_per_vertex + k];
+						int bind = bones[j * weights_per_vertex + k];
+						if (weight <= 0.0 || bind < 0 || bind >= int(bone_transforms.size())) {
+							continue;
+						}
+						skinned_vertex += bone_transforms[bind].xform(vertex) * weight;
+						skinned_normal += bone_transforms[bind].basis.xform(normal) * weight;
+						total_weight += weight;
+					}
+					if (total_weight > 0.0) {
+						vertex = skinned_vertex / total_weight;
+						normal = skinned_normal.normalized();
+					}
+				}
+
+				if (first_vertex) {
+					aabb.position = vertex;
+					first_vertex = false;
+				} else {
+					aabb.expand_to(vertex);
+				}
+
+				int x = vertex_index % width;
+				int y = frame * new_rows_per_frame + vertex_index / width;
+				float *position = &positions[(y * width + x) * 4];
+				position[0] = vertex.x;
+				position[1] = vertex.y;
+				position[2] = vertex.z;
+				position[3] = 1.0;
+				float *texel_normal = &normals[(y * width + x) * 4];
+				texel_normal[0] = normal.x;
+				texel_normal[1] = normal.y;
+				texel_normal[2] = normal.z;
+				texel_normal[3] = 0.0;
+
+				vertex_index++;
+			}
+		}
+	}
+
+	if (!previous_animation.is_empty()) {
+		p_player->set_assigned_animation(previous_animation);
+		p_player->seek(previous_position, true);
+	}
+
+	position_texture = ImageTexture::create_from_image(Image::create_from_data(width, height, false, Image::FORMAT_RGBAF, position_data));
+	normal_texture = ImageTexture::create_from_image(Image::create_from_data(width, height, false, Image::FORMAT_RGBAF, normal_data));
+	frame_count = new_frame_count;
+	rows_per_frame = new_rows_per_frame;
+	fps = p_fps;
+
+	Ref<Shader> shader;
+	shader.instantiate();
+	shader->set_code(vertex_animation_shader_code);
+
+	// One material per surface, sharing the shader, so each keeps the look of its source material.
+	Vector<Ref<ShaderMaterial>> surface_materials;
+	for (int i = 0; i < surface_count; i++) {
+		Ref<ShaderMaterial> surface_material;
+		surface_material.instantiate();
+		surface_material->set_shader(shader);
+		surface_material->set_shader_parameter("position_texture", position_texture);
+		surface_material->set_shader_parameter("normal_texture", normal_texture);
+		surface_material->set_shader_parameter("frame_count", frame_count);
+		surface_material->set_shader_parameter("rows_per_frame", rows_per_frame);
+		surface_material->set_shader_parameter("fps", fps);
+
+		Ref<BaseMaterial3D> source_material = p_mesh_instance->get_active_material(i);
+		if (source_material.is_valid()) {
+			surface_material->set_shader_parameter("albedo", source_material->get_albedo());
+			surface_material->set_shader_parameter("albedo_texture", source_material->get_texture(BaseMaterial3D::TEXTURE_ALBEDO));
+		}
+		surface_materials.push_back(surface_material);
+	}
+	material = surface_materials.is_empty() ? Ref<ShaderMaterial>() : surface_materials[0];
+
+	// The static mesh drops the skinning arrays and stores where each vertex lives in the textures in UV2.
+	mesh.instantiate();
+	int vertex_index = 0;
+	for (int i = 0; i < surface_count; i++) {
+		Array arrays = surface_arrays[i].duplicate();
+		int vertex_count = PackedVector3Array(arrays[Mesh::ARRAY_VERTEX]).size();
+
+		PackedVector2Array uv2;
+		uv2.resize(vertex_count);
+		for (int j = 0; j < vertex_count; j++) {
+			uv2.write[j] = Vector2((vertex_index % width + 0.5) / width, (vertex_index / width + 0.5) / height);
+			vertex_index++;
+		}
+		arrays[Mesh::ARRAY_TEX_UV2] = uv2;
+		arrays[Mesh::ARRAY_BONES] = Variant();
+		arrays[Mesh::ARRAY_WEIGHTS] = Variant();
+
+		mesh->add_surface_from_arrays(source_mesh->surface_get_primitive_type(i), arrays);
+		mesh->surface_set_material(i, surface_materials[i]);
+	}
+	mesh->set_custom_aabb(aabb);
+
+	return OK;
+}
+
+Ref<ImageTexture> VertexAnimationBaker::get_position_texture() const {
+	return position_texture;
+}
+
+Ref<ImageTexture> VertexAnimationBaker::get_normal_texture() const {
+	return normal_texture;
+}
+
+Ref<ArrayMesh> VertexAnimationBaker::get_mesh() const {
+	return mesh;
+}
+
+Ref<ShaderMaterial> VertexAnimationBaker::get_material() const {
+	return material;
+}
+
+int VertexAnimationBaker::get_frame_count() const {
+	return frame_count;
+}
+
+float VertexAnimationBaker::get_fps() const {
+	return fps;
+}
+
+void VertexAnimationBaker::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("bake", "mesh_instance", "animation_player", "animation", "fps"), &VertexAnimationBaker::bake, DEFVAL(30.0));
+
+	ClassDB::bind_method(D_METHOD("get_position_texture"), &VertexAnimationBaker::get_position_texture);
+	ClassDB::bind_method(D_METHOD("get_normal_texture"), &VertexAnimationBaker::get_normal_texture);
+	ClassDB::bind_method(D_METHOD("get_mesh"), &VertexAnimationBaker::get_mesh);
+	ClassDB::bind_method(D_METHOD("get_material"), &VertexAnimationBaker::get_material);
+	ClassDB::bind_method(D_METHOD("get_frame_count"), &VertexAnimationBaker::get_frame_count);
+	ClassDB::bind_method(D_METHOD("get_fps"), &VertexAnimationBaker::get_fps);
+}
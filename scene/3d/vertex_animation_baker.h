@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  vertex_animation_baker.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef VERTEX_ANIMATION_BAKER_H
+#define VERTEX_ANIMATION_BAKER_H
+
+#include "core/object/ref_counted.h"
+#include "scene/resources/mesh.h"
+#include "scene/resources/texture.h"
+
+class AnimationPlayer;
+class MeshInstance3D;
+class ShaderMaterial;
+
+// Bakes a skinned animation into textures holding every vertex position and normal for every frame,
+// so the animation can be played back by the vertex shader without skeletons or skinning.
+class VertexAnimationBaker : public RefCounted {
+	GDCLASS(VertexAnimationBaker, RefCounted);
+
+public:
+	enum {
+		MAX_TEXTURE_WIDTH = 4096,
+		MAX_TEXTURE_HEIGHT = 16384,
+	};
+
+private:
+	Ref<ImageTexture> position_texture;
+	Ref<ImageTexture> normal_texture;
+	Ref<ArrayMesh> mesh;
+	Ref<ShaderMaterial> material;
+	int frame_count = 0;
+	int rows_per_frame = 0;
+	float fps = 0.0;
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error bake(MeshInstance3D *p_mesh_instance, AnimationPlayer *p_player, const StringName &p_animation, float p_fps = 30.0);
+
+	Ref<ImageTexture> get_position_texture() const;
+	Ref<ImageTexture> get_normal_texture() const;
+	Ref<ArrayMesh> get_mesh() const;
+	Ref<ShaderMaterial> get_material() const;
+	int get_frame_count() const;
+	float get_fps() const;
+};
+
+#endif // VERTEX_ANIMATION_BAKER_H
@@ -269,6 +269,303 @@ void ImporterMesh::set_surface_material(int p_surface, const Ref<Material> &p_ma
 	}                                                                                                              \
 	write_array[vert_idx] = transformed_vert;
 
+template <typename T>
+static void _interleave_vertex_array(const Variant &p_array, uint32_t p_vertex_count, LocalVector<uint8_t> &r_stream, uint32_t p_stream_stride, uint32_t &r_offset) {
+	T array = p_array;
+	if (array.is_empty() || array.size() % p_vertex_count != 0) {
+		return;
+	}
+	uint32_t size = (array.size() / p_vertex_count) * sizeof(array[0]);
+	const uint8_t *src = reinterpret_cast<const uint8_t *>(array.ptr());
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		memcpy(&r_stream[i * p_stream_stride + r_offset], &src[i * size], size);
+	}
+	r_offset += size;
+}
+
+template <typename T>
+static Variant _remap_vertex_array(const Variant &p_array, const LocalVector<uint32_t> &p_remap, uint32_t p_new_vertex_count) {
+	T array = p_array;
+	uint32_t vertex_count = p_remap.size();
+	if (array.is_empty() || array.size() % vertex_count != 0) {
+		return p_array;
+	}
+	uint32_t components = array.size() / vertex_count;
+	T remapped;
+	remapped.resize(p_new_vertex_count * components);
+	const auto *src = array.ptr();
+	auto *dst = remapped.ptrw();
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		if (p_remap[i] == UINT32_MAX) {
+			continue;
+		}
+		for (uint32_t j = 0; j < components; j++) {
+			dst[p_remap[i] * components + j] = src[i * components + j];
+		}
+	}
+	return remapped;
+}
+
+// Returns the size in bytes of one vertex of the given array, or 0 if it isn't a per-vertex array.
+static uint32_t _get_vertex_array_stride(const Variant &p_array, uint32_t p_vertex_count) {
+	int64_t size = 0;
+	int64_t element_size = 0;
+	switch (p_array.get_type()) {
+		case Variant::PACKED_BYTE_ARRAY: {
+			size = PackedByteArray(p_array).size();
+			element_size = sizeof(uint8_t);
+		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			size = PackedInt32Array(p_array).size();
+			element_size = sizeof(int32_t);
+		} break;
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			size = PackedFloat32Array(p_array).size();
+			element_size = sizeof(float);
+		} break;
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			size = PackedFloat64Array(p_array).size();
+			element_size = sizeof(double);
+		} break;
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			size = PackedVector2Array(p_array).size();
+			element_size = sizeof(Vector2);
+		} break;
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			size = PackedVector3Array(p_array).size();
+			element_size = sizeof(Vector3);
+		} break;
+		case Variant::PACKED_COLOR_ARRAY: {
+			size = PackedColorArray(p_array).size();
+			element_size = sizeof(Color);
+		} break;
+		default: {
+		}
+	}
+	if (size == 0 || size % p_vertex_count != 0) {
+		return 0;
+	}
+	return (size / p_vertex_count) * element_size;
+}
+
+static void _interleave_vertex_arrays(const Array &p_arrays, uint32_t p_vertex_count, LocalVector<uint8_t> &r_stream, uint32_t p_stream_stride, uint32_t &r_offset) {
+	for (int i = 0; i < p_arrays.size(); i++) {
+		if (i == Mesh::ARRAY_INDEX) {
+			continue;
+		}
+		switch (p_arrays[i].get_type()) {
+			case Variant::PACKED_BYTE_ARRAY: {
+				_interleave_vertex_array<PackedByteArray>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				_interleave_vertex_array<PackedInt32Array>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				_interleave_vertex_array<PackedFloat32Array>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_FLOAT64_ARRAY: {
+				_interleave_vertex_array<PackedFloat64Array>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_VECTOR2_ARRAY: {
+				_interleave_vertex_array<PackedVector2Array>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_VECTOR3_ARRAY: {
+				_interleave_vertex_array<PackedVector3Array>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			case Variant::PACKED_COLOR_ARRAY: {
+				_interleave_vertex_array<PackedColorArray>(p_arrays[i], p_vertex_count, r_stream, p_stream_stride, r_offset);
+			} break;
+			default: {
+			}
+		}
+	}
+}
+
+static Array _remap_vertex_arrays(const Array &p_arrays, const LocalVector<uint32_t> &p_remap, uint32_t p_new_vertex_count) {
+	Array remapped;
+	remapped.resize(p_arrays.size());
+	for (int i = 0; i < p_arrays.size(); i++) {
+		if (i == Mesh::ARRAY_INDEX) {
+			remapped[i] = p_arrays[i];
+			continue;
+		}
+		switch (p_arrays[i].get_type()) {
+			case Variant::PACKED_BYTE_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedByteArray>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedInt32Array>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedFloat32Array>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_FLOAT64_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedFloat64Array>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_VECTOR2_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedVector2Array>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_VECTOR3_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedVector3Array>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			case Variant::PACKED_COLOR_ARRAY: {
+				remapped[i] = _remap_vertex_array<PackedColorArray>(p_arrays[i], p_remap, p_new_vertex_count);
+			} break;
+			default: {
+				remapped[i] = p_arrays[i];
+			}
+		}
+	}
+	return remapped;
+}
+
+// Average cache miss ratio (vertex shader invocations per triangle) for a FIFO post-transform cache.
+static float _calculate_acmr(const LocalVector<uint32_t> &p_indices, uint32_t p_index_count, uint32_t p_vertex_count) {
+	const uint32_t cache_size = 16;
+	if (p_index_count < 3) {
+		return 0.0;
+	}
+
+	LocalVector<uint32_t> timestamps;
+	timestamps.resize(p_vertex_count);
+	memset(timestamps.ptr(), 0, p_vertex_count * sizeof(uint32_t));
+	uint32_t time = cache_size + 1;
+	uint32_t misses = 0;
+	for (uint32_t i = 0; i < p_index_count; i++) {
+		uint32_t index = p_indices[i];
+		if (time - timestamps[index] > cache_size) {
+			timestamps[index] = time++;
+			misses++;
+		}
+	}
+	return float(misses) / float(p_index_count / 3);
+}
+
+void ImporterMesh::optimize_surfaces(float p_overdraw_threshold) {
+	if (!SurfaceTool::optimize_vertex_cache_func || !SurfaceTool::optimize_overdraw_func || !SurfaceTool::optimize_vertex_fetch_remap_func || !SurfaceTool::generate_remap_func || !SurfaceTool::remap_index_func) {
+		return;
+	}
+
+	for (int i = 0; i < surfaces.size(); i++) {
+		Surface &surface = surfaces.write[i];
+		if (surface.primitive != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		PackedInt32Array src_indices = surface.arrays[RS::ARRAY_INDEX];
+		Vector<Vector3> src_vertices = surface.arrays[RS::ARRAY_VERTEX];
+		uint32_t index_count = src_indices.size();
+		uint32_t vertex_count = src_vertices.size();
+		if (index_count < 3 || index_count % 3 != 0 || vertex_count == 0) {
+			continue;
+		}
+
+		// The indices of the LODs follow the ones of the surface, so vertices only they use are kept too.
+		uint32_t total_index_count = index_count;
+		for (const Surface::LOD &lod : surface.lods) {
+			total_index_count += lod.indices.size();
+		}
+		LocalVector<uint32_t> indices;
+		indices.resize(total_index_count);
+		bool valid = true;
+		uint32_t index_offset = 0;
+		for (int j = -1; valid && j < surface.lods.size(); j++) {
+			const PackedInt32Array &lod_indices = j < 0 ? src_indices : surface.lods[j].indices;
+			for (int k = 0; k < lod_indices.size(); k++) {
+				if (lod_indices[k] < 0 || uint32_t(lod_indices[k]) >= vertex_count) {
+					valid = false;
+					break;
+				}
+				indices[index_offset++] = lod_indices[k];
+			}
+		}
+		ERR_CONTINUE_MSG(!valid, vformat("Surface %d of mesh '%s' has out of range indices, skipping optimization.", i, get_name()));
+
+		// Merge vertices that are identical in every attribute, blend shapes included.
+		uint32_t vertex_stride = 0;
+		for (int j = 0; j < surface.arrays.size(); j++) {
+			if (j != Mesh::ARRAY_INDEX) {
+				vertex_stride += _get_vertex_array_stride(surface.arrays[j], vertex_count);
+			}
+		}
+		uint32_t stream_stride = vertex_stride;
+		for (const Surface::BlendShape &blend_shape : surface.blend_shape_data) {
+			for (int j = 0; j < blend_shape.arrays.size(); j++) {
+				stream_stride += _get_vertex_array_stride(blend_shape.arrays[j], vertex_count);
+			}
+		}
+
+		LocalVector<uint8_t> stream;
+		stream.resize(vertex_count * stream_stride);
+		uint32_t offset = 0;
+		_interleave_vertex_arrays(surface.arrays, vertex_count, stream, stream_stride, offset);
+		for (const Surface::BlendShape &blend_shape : surface.blend_shape_data) {
+			_interleave_vertex_arrays(blend_shape.arrays, vertex_count, stream, stream_stride, offset);
+		}
+		ERR_CONTINUE(offset != stream_stride);
+
+		float acmr_before = _calculate_acmr(indices, index_count, vertex_count);
+
+		LocalVector<uint32_t> unique_remap;
+		unique_remap.resize(vertex_count);
+		uint32_t unique_count = SurfaceTool::generate_remap_func(unique_remap.ptr(), indices.ptr(), total_index_count, stream.ptr(), vertex_count, stream_stride);
+		SurfaceTool::remap_index_func(indices.ptr(), indices.ptr(), total_index_count, unique_remap.ptr());
+
+		LocalVector<float> positions;
+		positions.resize(unique_count * 3);
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			if (unique_remap[j] != UINT32_MAX) {
+				positions[unique_remap[j] * 3 + 0] = src_vertices[j].x;
+				positions[unique_remap[j] * 3 + 1] = src_vertices[j].y;
+				positions[unique_remap[j] * 3 + 2] = src_vertices[j].z;
+			}
+		}
+
+		SurfaceTool::optimize_vertex_cache_func(indices.ptr(), indices.ptr(), index_count, unique_count);
+		SurfaceTool::optimize_overdraw_func(indices.ptr(), indices.ptr(), index_count, positions.ptr(), unique_count, sizeof(float) * 3, p_overdraw_threshold);
+
+		LocalVector<uint32_t> fetch_remap;
+		fetch_remap.resize(unique_count);
+		// Vertices only used by LODs go after the ones of the surface.
+		uint32_t new_vertex_count = SurfaceTool::optimize_vertex_fetch_remap_func(fetch_remap.ptr(), indices.ptr(), total_index_count, unique_count);
+		SurfaceTool::remap_index_func(indices.ptr(), indices.ptr(), total_index_count, fetch_remap.ptr());
+
+		// Compose both remaps so the original arrays are only rewritten once.
+		LocalVector<uint32_t> remap;
+		remap.resize(vertex_count);
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			remap[j] = unique_remap[j] == UINT32_MAX ? UINT32_MAX : fetch_remap[unique_remap[j]];
+		}
+
+		Array arrays = _remap_vertex_arrays(surface.arrays, remap, new_vertex_count);
+		PackedInt32Array new_indices;
+		new_indices.resize(index_count);
+		int *new_indices_ptr = new_indices.ptrw();
+		for (uint32_t j = 0; j < index_count; j++) {
+			new_indices_ptr[j] = indices[j];
+		}
+		arrays[RS::ARRAY_INDEX] = new_indices;
+		surface.arrays = arrays;
+
+		for (Surface::BlendShape &blend_shape : surface.blend_shape_data) {
+			blend_shape.arrays = _remap_vertex_arrays(blend_shape.arrays, remap, new_vertex_count);
+		}
+
+		index_offset = index_count;
+		for (Surface::LOD &lod : surface.lods) {
+			int *lod_indices_ptr = lod.indices.ptrw();
+			for (int j = 0; j < lod.indices.size(); j++) {
+				lod_indices_ptr[j] = indices[index_offset++];
+			}
+		}
+
+		float acmr_after = _calculate_acmr(indices, index_count, new_vertex_count);
+		print_verbose(vformat("Mesh '%s' surface %d: ACMR %.3f -> %.3f, vertices %d -> %d, vertex data %s -> %s.", get_name(), i, acmr_before, acmr_after, vertex_count, new_vertex_count, String::humanize_size(uint64_t(vertex_count) * stream_stride), String::humanize_size(uint64_t(new_vertex_count) * stream_stride)));
+	}
+
+	mesh.unref();
+}
+
 void ImporterMesh::generate_lods(float p_normal_merge_angle, float p_normal_split_angle, Array p_bone_transform_array) {
 	if (!SurfaceTool::simplify_scale_func) {
 		return;
@@ -1345,6 +1642,7 @@ void ImporterMesh::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_surface_name", "surface_idx", "name"), &ImporterMesh::set_surface_name);
 	ClassDB::bind_method(D_METHOD("set_surface_material", "surface_idx", "material"), &ImporterMesh::set_surface_material);
 
+	ClassDB::bind_method(D_METHOD("optimize_surfaces", "overdraw_threshold"), &ImporterMesh::optimize_surfaces, DEFVAL(1.05));
 	ClassDB::bind_method(D_METHOD("generate_lods", "normal_merge_angle", "normal_split_angle", "bone_transform_array"), &ImporterMesh::generate_lods);
 	ClassDB::bind_method(D_METHOD("get_mesh", "base_mesh"), &ImporterMesh::get_mesh, DEFVAL(Ref<ArrayMesh>()));
 	ClassDB::bind_method(D_METHOD("clear"), &ImporterMesh::clear);
@@ -75,6 +75,23 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 }
 
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && use_instantiation_plan && !Engine::get_singleton()->is_editor_hint()) {
+		if (instantiation_plan_status.get() == PLAN_NOT_COMPILED) {
+			MutexLock lock(instantiation_plan_mutex);
+			if (instantiation_plan_status.get() == PLAN_NOT_COMPILED) {
+				if (_compile_instantiation_plan(instantiation_plan)) {
+					instantiation_plan_status.set(PLAN_COMPILED);
+				} else {
+					instantiation_plan = InstantiationPlan();
+					instantiation_plan_status.set(PLAN_UNSUPPORTED);
+				}
+			}
+		}
+		if (instantiation_plan_status.get() == PLAN_COMPILED) {
+			return _instantiate_from_plan(instantiation_plan);
+		}
+	}
+
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
 
@@ -439,25 +456,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		}
 	}
 
-	for (const DeferredNodePathProperties &dnp : deferred_node_paths) {
-		// Replace properties stored as NodePaths with actual Nodes.
-		if (dnp.value.get_type() == Variant::ARRAY) {
-			Array paths = dnp.value;
-
-			bool valid;
-			Array array = dnp.base->get(dnp.property, &valid);
-			ERR_CONTINUE(!valid);
-			array = array.duplicate();
-
-			array.resize(paths.size());
-			for (int i = 0; i < array.size(); i++) {
-				array.set(i, dnp.base->get_node_or_null(paths[i]));
-			}
-			dnp.base->set(dnp.property, array);
-		} else {
-			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
-		}
-	}
+	_set_deferred_node_paths(deferred_node_paths);
 
 	for (KeyValue<Ref<Resource>, Ref<Resource>> &E : resources_local_to_scene) {
 		if (E.value->get_local_scene() == ret_nodes[0]) {
@@ -522,6 +521,324 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+void SceneState::_set_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths) {
+	for (const DeferredNodePathProperties &dnp : p_deferred_node_paths) {
+		// Replace properties stored as NodePaths with actual Nodes.
+		if (dnp.value.get_type() == Variant::ARRAY) {
+			Array paths = dnp.value;
+
+			bool valid;
+			Array array = dnp.base->get(dnp.property, &valid);
+			ERR_CONTINUE(!valid);
+			array = array.duplicate();
+
+			array.resize(paths.size());
+			for (int i = 0; i < array.size(); i++) {
+				array.set(i, dnp.base->get_node_or_null(paths[i]));
+			}
+			dnp.base->set(dnp.property, array);
+		} else {
+			dnp.base->set(dnp.property, dnp.base->get_node_or_null(dnp.value));
+		}
+	}
+}
+
+bool SceneState::_compile_instantiation_plan(InstantiationPlan &r_plan) const {
+	int nc = nodes.size();
+	if (nc == 0 || base_scene_idx >= 0 || !editable_instances.is_empty()) {
+		return false;
+	}
+
+	const StringName *snames = names.ptr();
+	int sname_count = names.size();
+	const Variant *props = variants.ptr();
+	int prop_count = variants.size();
+
+	r_plan.nodes.resize(nc);
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodeInfo &info = r_plan.nodes.write[i];
+
+		if (n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+		info.name = snames[n.name];
+		info.index = n.index;
+
+		// Node paths are only needed to reach into sub-scenes, everything else refers to earlier nodes.
+		if (i == 0) {
+			if (n.parent != -1 || n.type == TYPE_INSTANTIATED) {
+				return false;
+			}
+		} else if (n.parent < 0 || n.parent >= i) {
+			return false;
+		}
+		info.parent = n.parent;
+		if (n.owner >= i) {
+			return false;
+		}
+		info.owner = n.owner;
+
+		// Only native classes resolve the same property setters on every instance.
+		bool native_setters = false;
+		if (n.instance >= 0) {
+			if (n.instance & FLAG_INSTANCE_IS_PLACEHOLDER) {
+				return false;
+			}
+			int instance = n.instance & FLAG_MASK;
+			if (instance >= prop_count || Ref<PackedScene>(props[instance]).is_null()) {
+				return false;
+			}
+			info.instance = instance;
+		} else if (n.type != TYPE_INSTANTIATED) {
+			if (n.type < 0 || n.type >= sname_count) {
+				return false;
+			}
+			const StringName &type = snames[n.type];
+			if (!ClassDB::can_instantiate(type) || !ClassDB::is_parent_class(type, SNAME("Node"))) {
+				return false;
+			}
+			ClassDB::APIType api = ClassDB::get_api_type(type);
+			native_setters = api != ClassDB::API_EXTENSION && api != ClassDB::API_EDITOR_EXTENSION;
+			info.type = type;
+		}
+
+		for (const NodeData::Property &prop : n.properties) {
+			uint32_t name_idx = prop.name & FLAG_PROP_NAME_MASK;
+			if (name_idx >= (uint32_t)sname_count || prop.value < 0 || prop.value >= prop_count) {
+				return false;
+			}
+
+			InstantiationPlan::Property plan_prop;
+			plan_prop.name = snames[name_idx];
+			plan_prop.value = prop.value;
+
+			if (prop.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				info.node_path_properties.push_back(plan_prop);
+				r_plan.node_path_property_count++;
+				continue;
+			}
+
+			if (plan_prop.name == CoreStringNames::get_singleton()->_script) {
+				if (info.type == StringName()) {
+					// Replacing the script of an existing node needs to carry over its state.
+					return false;
+				}
+				// From here on the script may handle any property itself.
+				native_setters = false;
+				info.properties.push_back(plan_prop);
+				continue;
+			}
+
+			if (plan_prop.name == SNAME("metadata/_edit_pinned_properties_")) {
+				// Removed right after being set by the generic path.
+				continue;
+			}
+
+			const Variant &value = props[prop.value];
+			if (value.get_type() == Variant::OBJECT) {
+				Ref<Resource> res = value;
+				if (res.is_valid() && (res->is_local_to_scene() || Object::cast_to<MissingResource>(res.ptr()))) {
+					return false;
+				}
+			}
+
+			if (native_setters) {
+				// Same lookup as Object::set(), which tries the class properties first.
+				const ClassDB::PropertySetGet *psg = ClassDB::get_property_setget(info.type, plan_prop.name);
+				if (psg) {
+					if (!psg->setter) {
+						// Read-only, setting it would do nothing.
+						continue;
+					}
+					plan_prop.setter = psg->_setptr;
+					plan_prop.index = psg->index;
+				}
+			}
+			info.properties.push_back(plan_prop);
+		}
+
+		for (int group : n.groups) {
+			if (group < 0 || group >= sname_count) {
+				return false;
+			}
+			info.groups.push_back(snames[group]);
+		}
+	}
+
+	for (const ConnectionData &c : connections) {
+		if (c.from < 0 || c.from >= nc || c.to < 0 || c.to >= nc || c.signal < 0 || c.signal >= sname_count || c.method < 0 || c.method >= sname_count) {
+			return false;
+		}
+
+		InstantiationPlan::ConnectionInfo info;
+		info.from = c.from;
+		info.to = c.to;
+		info.signal = snames[c.signal];
+		info.method = snames[c.method];
+		info.flags = CONNECT_PERSIST | c.flags | CONNECT_INHERITED;
+		info.unbinds = c.unbinds;
+		for (int bind : c.binds) {
+			if (bind < 0 || bind >= prop_count) {
+				return false;
+			}
+			info.binds.push_back(props[bind]);
+		}
+		r_plan.connections.push_back(info);
+	}
+
+	return true;
+}
+
+Node *SceneState::_instantiate_from_plan(const InstantiationPlan &p_plan) const {
+	int nc = p_plan.nodes.size();
+	const InstantiationPlan::NodeInfo *infos = p_plan.nodes.ptr();
+	const Variant *props = variants.ptr();
+
+	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
+
+	// Nodes whose parent from a sub-scene has vanished.
+	LocalVector<Node *> stray_instances;
+
+	LocalVector<DeferredNodePathProperties> deferred_node_paths;
+	deferred_node_paths.reserve(p_plan.node_path_property_count);
+
+	for (int i = 0; i < nc; i++) {
+		const InstantiationPlan::NodeInfo &info = infos[i];
+		Node *parent = i > 0 ? ret_nodes[info.parent] : nullptr;
+		bool existing = info.type == StringName() && info.instance < 0;
+
+		Node *node = nullptr;
+		if (info.instance >= 0) {
+			Ref<PackedScene> sdata = props[info.instance];
+			node = sdata->instantiate(PackedScene::GEN_EDIT_STATE_DISABLED);
+			ERR_FAIL_NULL_V(node, nullptr);
+		} else if (existing) {
+			if (parent) {
+				node = parent->_get_child_by_name(info.name);
+#ifdef DEBUG_ENABLED
+				if (!node) {
+					WARN_PRINT(String("Node '" + String(ret_nodes[0]->get_path_to(parent)) + "/" + String(info.name) + "' was modified from inside an instance, but it has vanished.").ascii().get_data());
+				}
+#endif
+			}
+		} else {
+			node = Object::cast_to<Node>(ClassDB::instantiate(info.type));
+			ERR_FAIL_NULL_V(node, nullptr);
+		}
+
+		if (node) {
+			for (const InstantiationPlan::Property &prop : info.properties) {
+				const Variant *value = &props[prop.value];
+
+				Variant typed_array;
+				if (value->get_type() == Variant::ARRAY) {
+					Array set_array = *value;
+					bool is_get_valid = false;
+					Variant get_value = node->get(prop.name, &is_get_valid);
+					if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+						Array get_array = get_value;
+						if (!set_array.is_same_typed(get_array)) {
+							typed_array = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+							value = &typed_array;
+						}
+					}
+				}
+
+				if (prop.setter) {
+					Callable::CallError ce;
+					if (prop.index >= 0) {
+						Variant index = prop.index;
+						const Variant *args[2] = { &index, value };
+						prop.setter->call(node, args, 2, ce);
+					} else {
+						prop.setter->call(node, &value, 1, ce);
+					}
+				} else {
+					node->set(prop.name, *value);
+				}
+			}
+
+			for (const InstantiationPlan::Property &prop : info.node_path_properties) {
+				DeferredNodePathProperties dnp;
+				dnp.value = props[prop.value];
+				dnp.base = node;
+				dnp.property = prop.name;
+				deferred_node_paths.push_back(dnp);
+			}
+
+			for (const StringName &group : info.groups) {
+				node->add_to_group(group, true);
+			}
+
+			if (!existing) {
+				if (i > 0) {
+					if (parent) {
+						parent->_add_child_nocheck(node, info.name);
+						if (info.index >= 0 && info.index < parent->get_child_count() - 1) {
+							parent->move_child(node, info.index);
+						}
+					} else {
+						stray_instances.push_back(node);
+					}
+				} else {
+					node->_set_name_nocheck(info.name);
+				}
+			}
+
+			if (info.owner >= 0) {
+				Node *owner = ret_nodes[info.owner];
+				if (owner) {
+					node->_set_owner_nocheck(owner);
+					if (node->data.unique_name_in_owner) {
+						node->_acquire_unique_name_in_owner();
+					}
+				}
+			}
+		}
+
+		ret_nodes[i] = node;
+	}
+
+	_set_deferred_node_paths(deferred_node_paths);
+
+	for (const InstantiationPlan::ConnectionInfo &c : p_plan.connections) {
+		Node *cfrom = ret_nodes[c.from];
+		Node *cto = ret_nodes[c.to];
+		if (!cfrom || !cto) {
+			continue;
+		}
+
+		Callable callable(cto, c.method);
+		if (c.unbinds > 0) {
+			callable = callable.unbind(c.unbinds);
+		} else if (!c.binds.is_empty()) {
+			const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * c.binds.size());
+			for (int j = 0; j < c.binds.size(); j++) {
+				argptrs[j] = &c.binds[j];
+			}
+			callable = callable.bindp(argptrs, c.binds.size());
+		}
+
+		cfrom->connect(c.signal, callable, c.flags);
+	}
+
+	for (Node *E : stray_instances) {
+		memdelete(E);
+	}
+
+	return ret_nodes[0];
+}
+
+void SceneState::_clear_instantiation_plan() {
+	if (instantiation_plan_status.get() == PLAN_NOT_COMPILED) {
+		return;
+	}
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan = InstantiationPlan();
+	instantiation_plan_status.set(PLAN_NOT_COMPILED);
+}
+
 static int _nm_get_string(const String &p_string, HashMap<StringName, int> &name_map) {
 	if (name_map.has(p_string)) {
 		return name_map[p_string];
@@ -1076,6 +1393,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1131,6 +1449,8 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
 
+	_clear_instantiation_plan();
+
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
 			if (!(nd.instance & FLAG_INSTANCE_IS_PLACEHOLDER)) {
@@ -1242,6 +1562,16 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::use_instantiation_plan = true;
+
+void SceneState::set_use_instantiation_plan(bool p_enable) {
+	use_instantiation_plan = p_enable;
+}
+
+bool SceneState::is_using_instantiation_plan() {
+	return use_instantiation_plan;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1284,6 +1614,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1730,21 +2062,25 @@ Vector<NodePath> SceneState::get_editable_instances() const {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
 
 int SceneState::add_node_path(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	node_paths.push_back(p_path);
 	return (node_paths.size() - 1) | FLAG_ID_IS_PATH;
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_plan();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1763,6 +2099,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_clear_instantiation_plan();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	if (p_deferred_node_path) {
@@ -1775,11 +2113,15 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 void SceneState::add_node_group(int p_node, int p_group) {
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
+
+	_clear_instantiation_plan();
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -1790,6 +2132,9 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	for (int i = 0; i < p_binds.size(); i++) {
 		ERR_FAIL_INDEX(p_binds[i], variants.size());
 	}
+
+	_clear_instantiation_plan();
+
 	ConnectionData c;
 	c.from = p_from;
 	c.to = p_to;
@@ -1802,6 +2147,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 }
 
 void SceneState::add_editable_instance(const NodePath &p_path) {
+	_clear_instantiation_plan();
 	editable_instances.push_back(p_path);
 }
 
@@ -1852,7 +2198,305 @@ SceneState::SceneState() {
 
 ////////////////
 
+void PackedScene::_get_instance_nodes(Node *p_root, LocalVector<Node *> &r_nodes) {
+	r_nodes.push_back(p_root);
+	for (int i = 0; i < p_root->get_child_count(); i++) {
+		_get_instance_nodes(p_root->get_child(i), r_nodes);
+	}
+}
+
+PackedScene::InstancePoolTemplate::Connection PackedScene::_get_pool_connection(const Object::Connection &p_connection, int p_to) {
+	InstancePoolTemplate::Connection connection;
+	connection.signal = p_connection.signal.get_name();
+	connection.to = p_to;
+	connection.method = p_connection.callable.get_method();
+	connection.flags = p_connection.flags;
+
+	// Same as pack(), binds and unbinds are kept apart from the method they apply to.
+	Callable base_callable = p_connection.callable;
+	if (p_connection.callable.is_custom()) {
+		CallableCustomBind *ccb = dynamic_cast<CallableCustomBind *>(p_connection.callable.get_custom());
+		if (ccb) {
+			connection.binds = ccb->get_binds();
+			base_callable = ccb->get_callable();
+		}
+
+		CallableCustomUnbind *ccu = dynamic_cast<CallableCustomUnbind *>(p_connection.callable.get_custom());
+		if (ccu) {
+			connection.unbinds = ccu->get_unbinds();
+			base_callable = ccu->get_callable();
+		}
+	}
+	connection.by_name = base_callable.is_standard();
+	return connection;
+}
+
+void PackedScene::_build_instance_pool_template(Node *p_root, InstancePoolTemplate &r_template) {
+	LocalVector<Node *> nodes;
+	_get_instance_nodes(p_root, nodes);
+	HashMap<Node *, int> indices;
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		indices[nodes[i]] = i;
+	}
+
+	r_template.nodes.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		Node *node = nodes[i];
+		InstancePoolTemplate::NodeState &node_state = r_template.nodes.write[i];
+		node_state.name = node->get_name();
+		node_state.type = node->get_class_name();
+		node_state.child_count = node->get_child_count();
+
+		HashMap<Object *, StringName> held_objects;
+
+		List<PropertyInfo> plist;
+		node->get_property_list(&plist);
+		for (const PropertyInfo &E : plist) {
+			if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
+				continue;
+			}
+
+			InstancePoolTemplate::Property prop;
+			prop.name = E.name;
+			Variant value = node->get(E.name);
+			if (value.get_type() == Variant::OBJECT) {
+				Node *target = Object::cast_to<Node>(value);
+				Ref<Resource> res = value;
+				if (!target && value.get_validated_object()) {
+					held_objects.insert(value.get_validated_object(), E.name);
+				}
+				if (target) {
+					if (!indices.has(target)) {
+						continue;
+					}
+					prop.value = node->get_path_to(target);
+					prop.is_node = true;
+				} else if (res.is_valid() && res->is_local_to_scene()) {
+					// Each instance keeps its own copy.
+					continue;
+				} else {
+					prop.value = value;
+				}
+			} else {
+				prop.value = value.duplicate(true);
+			}
+			node_state.properties.push_back(prop);
+		}
+
+		List<StringName> metas;
+		node->get_meta_list(&metas);
+		for (const StringName &E : metas) {
+			node_state.metas.push_back(E);
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (const Node::GroupInfo &E : groups) {
+			node_state.groups.push_back(E);
+		}
+
+		List<Object::Connection> connections;
+		node->get_all_signal_connections(&connections);
+		for (const Object::Connection &E : connections) {
+			HashMap<Node *, int>::Iterator target = indices.find(Object::cast_to<Node>(E.callable.get_object()));
+			if (target) {
+				node_state.connections.push_back(_get_pool_connection(E, target->value));
+			}
+		}
+
+		// Connections from outside the instance, made by setters to the objects they are given or by the
+		// node itself when created, which stay across resets.
+		connections.clear();
+		node->get_signals_connected_to_this(&connections);
+		for (const Object::Connection &E : connections) {
+			Object *source = E.signal.get_object();
+			Node *source_node = Object::cast_to<Node>(source);
+			if (!source || (source_node && indices.has(source_node))) {
+				continue;
+			}
+			HashMap<Object *, StringName>::Iterator held = held_objects.find(source);
+			if (held) {
+				InstancePoolTemplate::HeldConnection connection;
+				connection.property = held->value;
+				connection.signal = E.signal.get_name();
+				connection.method = E.callable.get_method();
+				node_state.held_connections.push_back(connection);
+			} else {
+				InstancePoolTemplate::ExternalConnection connection;
+				connection.source = source->get_instance_id();
+				connection.signal = E.signal.get_name();
+				connection.method = E.callable.get_method();
+				node_state.external_connections.push_back(connection);
+			}
+		}
+	}
+}
+
+bool PackedScene::_reset_pooled_instance(Node *p_root, const InstancePoolTemplate &p_template) {
+	LocalVector<Node *> nodes;
+	_get_instance_nodes(p_root, nodes);
+	if (nodes.size() != (uint32_t)p_template.nodes.size()) {
+		return false;
+	}
+	HashMap<Node *, int> indices;
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		const InstancePoolTemplate::NodeState &node_state = p_template.nodes[i];
+		// The root may have been renamed when added next to other instances.
+		if ((i > 0 && nodes[i]->get_name() != node_state.name) || nodes[i]->get_class_name() != node_state.type || nodes[i]->get_child_count() != node_state.child_count) {
+			return false;
+		}
+		indices[nodes[i]] = i;
+	}
+
+	if (p_root->get_parent()) {
+		p_root->get_parent()->remove_child(p_root);
+	}
+	p_root->set_name(p_template.nodes[0].name);
+
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		Node *node = nodes[i];
+		const InstancePoolTemplate::NodeState &node_state = p_template.nodes[i];
+
+		for (const InstancePoolTemplate::Property &E : node_state.properties) {
+			Variant value = E.is_node ? Variant(node->get_node_or_null(E.value)) : E.value;
+			if (node->get(E.name) != value) {
+				node->set(E.name, value.get_type() == Variant::OBJECT ? value : value.duplicate(true));
+			}
+		}
+
+		List<StringName> metas;
+		node->get_meta_list(&metas);
+		for (const StringName &E : metas) {
+			if (!node_state.metas.has(E)) {
+				node->remove_meta(E);
+			}
+		}
+
+		List<Node::GroupInfo> groups;
+		node->get_groups(&groups);
+		for (const Node::GroupInfo &E : groups) {
+			bool found = false;
+			for (const Node::GroupInfo &F : node_state.groups) {
+				if (F.name == E.name) {
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				node->remove_from_group(E.name);
+			}
+		}
+		for (const Node::GroupInfo &E : node_state.groups) {
+			if (!node->is_in_group(E.name)) {
+				node->add_to_group(E.name, E.persistent);
+			}
+		}
+
+		// Keep the connections of the template, drop every other one so listeners don't carry
+		// over to the next use, whatever they are connected to.
+		LocalVector<const InstancePoolTemplate::Connection *> expected;
+		for (const InstancePoolTemplate::Connection &E : node_state.connections) {
+			expected.push_back(&E);
+		}
+		List<Object::Connection> connections;
+		node->get_all_signal_connections(&connections);
+		for (const Object::Connection &E : connections) {
+			Node *target = Object::cast_to<Node>(E.callable.get_object());
+			const int *target_index = target ? indices.getptr(target) : nullptr;
+			bool keep = false;
+			if (target_index) {
+				InstancePoolTemplate::Connection connection = _get_pool_connection(E, *target_index);
+				for (uint32_t j = 0; j < expected.size(); j++) {
+					const InstancePoolTemplate::Connection &F = *expected[j];
+					if (F.to == connection.to && F.signal == connection.signal && F.method == connection.method && F.unbinds == connection.unbinds && F.binds == connection.binds) {
+						expected.remove_at_unordered(j);
+						keep = true;
+						break;
+					}
+				}
+			}
+			if (!keep) {
+				node->disconnect(E.signal.get_name(), E.callable);
+			}
+		}
+
+		// Connect again the ones that were removed since.
+		for (const InstancePoolTemplate::Connection *E : expected) {
+			if (!E->by_name) {
+				return false; // Made by the engine with a method pointer, which can't be made again.
+			}
+			Callable callable(nodes[E->to], E->method);
+			if (E->unbinds > 0) {
+				callable = callable.unbind(E->unbinds);
+			} else if (!E->binds.is_empty()) {
+				const Variant **argptrs = (const Variant **)alloca(sizeof(Variant *) * E->binds.size());
+				for (int j = 0; j < E->binds.size(); j++) {
+					argptrs[j] = &E->binds[j];
+				}
+				callable = callable.bindp(argptrs, E->binds.size());
+			}
+			node->connect(E->signal, callable, E->flags);
+		}
+
+		// Only the ones made since the template was taken are dropped.
+		LocalVector<const InstancePoolTemplate::HeldConnection *> held;
+		for (const InstancePoolTemplate::HeldConnection &E : node_state.held_connections) {
+			held.push_back(&E);
+		}
+		LocalVector<const InstancePoolTemplate::ExternalConnection *> external;
+		for (const InstancePoolTemplate::ExternalConnection &E : node_state.external_connections) {
+			external.push_back(&E);
+		}
+		connections.clear();
+		node->get_signals_connected_to_this(&connections);
+		for (const Object::Connection &E : connections) {
+			Object *source = E.signal.get_object();
+			Node *source_node = Object::cast_to<Node>(source);
+			if (!source || (source_node && indices.has(source_node))) {
+				continue; // Checked above from the side of the source.
+			}
+			bool keep = false;
+			for (uint32_t j = 0; j < held.size(); j++) {
+				const InstancePoolTemplate::HeldConnection &F = *held[j];
+				if (F.signal == E.signal.get_name() && F.method == E.callable.get_method() && node->get(F.property).get_validated_object() == source) {
+					held.remove_at_unordered(j);
+					keep = true;
+					break;
+				}
+			}
+			for (uint32_t j = 0; !keep && j < external.size(); j++) {
+				const InstancePoolTemplate::ExternalConnection &F = *external[j];
+				if (F.source == source->get_instance_id() && F.signal == E.signal.get_name() && F.method == E.callable.get_method()) {
+					external.remove_at_unordered(j);
+					keep = true;
+				}
+			}
+			if (!keep) {
+				source->disconnect(E.signal.get_name(), E.callable);
+			}
+		}
+	}
+
+	return true;
+}
+
+void PackedScene::_clear_instance_pool() {
+	Vector<Node *> pool;
+	{
+		MutexLock lock(instance_pool_mutex);
+		pool = instance_pool;
+		instance_pool.clear();
+		instance_pool_template = InstancePoolTemplate();
+		instance_pool_version++;
+	}
+	// Freed outside of the lock, destructors may run scripts.
+	for (Node *E : pool) {
+		memdelete(E);
+	}
+}
+
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
+	_clear_instance_pool();
 	state->set_bundled_scene(p_scene);
 }
 
@@ -1861,10 +2505,12 @@ Dictionary PackedScene::_get_bundled_scene() const {
 }
 
 Error PackedScene::pack(Node *p_scene) {
+	_clear_instance_pool();
 	return state->pack(p_scene);
 }
 
 void PackedScene::clear() {
+	_clear_instance_pool();
 	state->clear();
 }
 
@@ -1888,6 +2534,7 @@ void PackedScene::reload_from_file() {
 	copy_from(s);
 	// Then, we copy the backed-up loaded_state to state
 	state->copy_from(loaded_state);
+	_clear_instance_pool();
 }
 
 bool PackedScene::can_instantiate() const {
@@ -1899,6 +2546,27 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	ERR_FAIL_COND_V_MSG(p_edit_state != GEN_EDIT_STATE_DISABLED, nullptr, "Edit state is only for editors, does not work without tools compiled.");
 #endif
 
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && instance_pool_size > 0) {
+		Node *pooled = nullptr;
+		{
+			MutexLock lock(instance_pool_mutex);
+			if (!instance_pool.is_empty()) {
+				pooled = instance_pool[instance_pool.size() - 1];
+				instance_pool.remove_at(instance_pool.size() - 1);
+			}
+		}
+		if (pooled) {
+			// Behave like a new instance, which gets _ready() when entering the tree.
+			LocalVector<Node *> nodes;
+			_get_instance_nodes(pooled, nodes);
+			for (Node *E : nodes) {
+				E->request_ready();
+			}
+			pooled->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
+			return pooled;
+		}
+	}
+
 	Node *s = state->instantiate((SceneState::GenEditState)p_edit_state);
 	if (!s) {
 		return nullptr;
@@ -1914,10 +2582,92 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 
 	s->notification(Node::NOTIFICATION_SCENE_INSTANTIATED);
 
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && instance_pool_size > 0) {
+		bool needs_template;
+		uint32_t version;
+		{
+			MutexLock lock(instance_pool_mutex);
+			needs_template = instance_pool_template.nodes.is_empty();
+			version = instance_pool_version;
+		}
+		if (needs_template) {
+			// Built outside of the lock, property getters may run scripts.
+			InstancePoolTemplate pool_template;
+			_build_instance_pool_template(s, pool_template);
+			MutexLock lock(instance_pool_mutex);
+			if (instance_pool_template.nodes.is_empty() && instance_pool_version == version) {
+				instance_pool_template = pool_template;
+			}
+		}
+	}
+
 	return s;
 }
 
+void PackedScene::set_instance_pool_size(int p_size) {
+	ERR_FAIL_COND(p_size < 0);
+	instance_pool_size = p_size;
+	if (p_size == 0) {
+		_clear_instance_pool();
+		return;
+	}
+
+	Vector<Node *> excess;
+	{
+		MutexLock lock(instance_pool_mutex);
+		while (instance_pool.size() > p_size) {
+			excess.push_back(instance_pool[instance_pool.size() - 1]);
+			instance_pool.remove_at(instance_pool.size() - 1);
+		}
+	}
+	for (Node *E : excess) {
+		memdelete(E);
+	}
+}
+
+int PackedScene::get_instance_pool_size() const {
+	return instance_pool_size;
+}
+
+int PackedScene::get_pooled_instance_count() const {
+	MutexLock lock(instance_pool_mutex);
+	return instance_pool.size();
+}
+
+void PackedScene::release_instance(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release a node that is queued for deletion.");
+
+	InstancePoolTemplate pool_template;
+	uint32_t version;
+	{
+		MutexLock lock(instance_pool_mutex);
+		ERR_FAIL_COND_MSG(instance_pool.has(p_node), "This instance was already released.");
+		if (instance_pool.size() < instance_pool_size) {
+			pool_template = instance_pool_template;
+		}
+		version = instance_pool_version;
+	}
+
+	// Reset outside of the lock, setters and disconnections may run scripts.
+	if (!pool_template.nodes.is_empty() && _reset_pooled_instance(p_node, pool_template)) {
+		MutexLock lock(instance_pool_mutex);
+		if (instance_pool.size() < instance_pool_size && instance_pool_version == version && !instance_pool.has(p_node)) {
+			instance_pool.push_back(p_node);
+			return;
+		}
+	}
+
+	// Not an instance of this scene as it was instantiated, or no room left for it.
+	p_node->queue_free();
+}
+
+void PackedScene::clear_instance_pool() {
+	_clear_instance_pool();
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	_clear_instance_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1926,6 +2676,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	_clear_instance_pool();
 	state = Ref<SceneState>(memnew(SceneState));
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -1952,6 +2703,11 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
+	ClassDB::bind_method(D_METHOD("set_instance_pool_size", "size"), &PackedScene::set_instance_pool_size);
+	ClassDB::bind_method(D_METHOD("get_instance_pool_size"), &PackedScene::get_instance_pool_size);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &PackedScene::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("release_instance", "node"), &PackedScene::release_instance);
+	ClassDB::bind_method(D_METHOD("clear_instance_pool"), &PackedScene::clear_instance_pool);
 
 	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "_bundled"), "_set_bundled_scene", "_get_bundled_scene");
 
@@ -1964,3 +2720,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+PackedScene::~PackedScene() {
+	_clear_instance_pool();
+}
@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +90,62 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Instantiating at runtime runs a plan compiled from the data above the first time it's needed,
+	// with property setters and connections resolved once instead of for every node created.
+	// Scenes using features the plan doesn't cover (inheritance, placeholders, node paths into
+	// sub-scenes, resources local to scene) keep using the generic path.
+	struct InstantiationPlan {
+		struct Property {
+			StringName name;
+			MethodBind *setter = nullptr; // If null, set through Object::set().
+			int index = -1;
+			int value = 0;
+		};
+
+		struct NodeInfo {
+			StringName type; // Empty when instantiated from a sub-scene or already existing in one.
+			int instance = -1; // Index of the sub-scene in the variants.
+			StringName name;
+			int parent = -1;
+			int owner = -1;
+			int index = -1;
+			Vector<Property> properties;
+			Vector<Property> node_path_properties; // Resolved to nodes once all nodes exist.
+			Vector<StringName> groups;
+		};
+
+		struct ConnectionInfo {
+			int from = 0;
+			int to = 0;
+			StringName signal;
+			StringName method;
+			uint32_t flags = 0;
+			int unbinds = 0;
+			Vector<Variant> binds;
+		};
+
+		Vector<NodeInfo> nodes;
+		Vector<ConnectionInfo> connections;
+		int node_path_property_count = 0;
+	};
+
+	enum InstantiationPlanStatus {
+		PLAN_NOT_COMPILED,
+		PLAN_COMPILED,
+		PLAN_UNSUPPORTED,
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable SafeNumeric<uint32_t> instantiation_plan_status;
+	mutable BinaryMutex instantiation_plan_mutex;
+
+	static bool use_instantiation_plan;
+
+	bool _compile_instantiation_plan(InstantiationPlan &r_plan) const;
+	Node *_instantiate_from_plan(const InstantiationPlan &p_plan) const;
+	void _clear_instantiation_plan();
+	static void _set_deferred_node_paths(const LocalVector<DeferredNodePathProperties> &p_deferred_node_paths);
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -136,6 +193,8 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_use_instantiation_plan(bool p_enable);
+	static bool is_using_instantiation_plan();
 
 	int find_node_by_path(const NodePath &p_node) const;
 	Variant get_property_value(int p_node, const StringName &p_property, bool &found) const;
@@ -224,6 +283,66 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	// Instances handed back with release_instance() are reset to how they were right after
+	// instantiation, before entering the tree, and given out again by instantiate().
+	struct InstancePoolTemplate {
+		struct Property {
+			StringName name;
+			Variant value;
+			bool is_node = false; // The value is the path to a node of the same instance.
+		};
+
+		struct Connection {
+			StringName signal;
+			int to = -1;
+			StringName method;
+			uint32_t flags = 0;
+			int unbinds = 0;
+			Vector<Variant> binds;
+			bool by_name = false; // Made with a method name, so it can be connected again.
+		};
+
+		// Signal of an object held in a property, such as the "changed" signal of a resource.
+		struct HeldConnection {
+			StringName property;
+			StringName signal;
+			StringName method;
+		};
+
+		// Signal of any other object outside the instance, such as a server the node connected to when created.
+		struct ExternalConnection {
+			ObjectID source;
+			StringName signal;
+			StringName method;
+		};
+
+		struct NodeState {
+			StringName name;
+			StringName type;
+			int child_count = 0;
+			Vector<Property> properties;
+			Vector<StringName> metas;
+			Vector<Node::GroupInfo> groups;
+			Vector<Connection> connections; // Between nodes of the instance.
+			Vector<HeldConnection> held_connections;
+			Vector<ExternalConnection> external_connections;
+		};
+
+		Vector<NodeState> nodes;
+	};
+
+	int instance_pool_size = 0;
+	mutable Vector<Node *> instance_pool;
+	mutable InstancePoolTemplate instance_pool_template; // Built from the first instance once pooling is enabled.
+	mutable uint32_t instance_pool_version = 0; // Changes when the pool is cleared, so resets against an older template are dropped.
+	mutable Mutex instance_pool_mutex;
+
+	static void _get_instance_nodes(Node *p_root, LocalVector<Node *> &r_nodes);
+	static InstancePoolTemplate::Connection _get_pool_connection(const Object::Connection &p_connection, int p_to);
+	static void _build_instance_pool_template(Node *p_root, InstancePoolTemplate &r_template);
+	static bool _reset_pooled_instance(Node *p_root, const InstancePoolTemplate &p_template);
+	void _clear_instance_pool();
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -247,6 +366,12 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void set_instance_pool_size(int p_size);
+	int get_instance_pool_size() const;
+	int get_pooled_instance_count() const;
+	void release_instance(Node *p_node);
+	void clear_instance_pool();
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -263,6 +388,7 @@ public:
 	Ref<SceneState> get_state() const;
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -30,6 +30,7 @@
 
 #include "texture.h"
 
+#include "core/config/project_settings.h"
 #include "core/core_string_names.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
@@ -669,7 +670,7 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
-			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
+			if (p_size_limit > 0 && i < mipmaps && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
@@ -740,21 +741,15 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				}
 			}
 
-			image->set_data(w, h, true, mipmap_images[0]->get_format(), img_data);
+			image->set_data(mipmap_images[0]->get_width(), mipmap_images[0]->get_height(), true, mipmap_images[0]->get_format(), img_data);
 			return image;
 		}
 
 	} else if (data_format == DATA_FORMAT_BASIS_UNIVERSAL) {
 		int sw = w;
 		int sh = h;
+		// All mipmaps are in a single Basis Universal blob, so the size limit can't be applied.
 		uint32_t size = f->get_32();
-		if (p_size_limit > 0 && (sw > p_size_limit || sh > p_size_limit)) {
-			//can't load this due to size limit
-			sw = MAX(sw >> 1, 1);
-			sh = MAX(sh >> 1, 1);
-			f->seek(f->get_position() + size);
-			return Ref<Image>();
-		}
 		Vector<uint8_t> pv;
 		pv.resize(size);
 		{
@@ -777,13 +772,14 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 			int tw, th;
 			int ofs = Image::get_image_mipmap_offset_and_dimensions(w, h, format, i, tw, th);
 
-			if (p_size_limit > 0 && i < mipmaps && (p_size_limit > tw || p_size_limit > th)) {
-				if (ofs) {
-					f->seek(f->get_position() + ofs);
-				}
+			if (p_size_limit > 0 && i < mipmaps && (tw > p_size_limit || th > p_size_limit)) {
 				continue; //oops, size limit enforced, go to next
 			}
 
+			if (ofs) {
+				f->seek(f->get_position() + ofs);
+			}
+
 			Vector<uint8_t> data;
 			data.resize(size - ofs);
 
@@ -830,6 +826,86 @@ void CompressedTexture2D::_requested_normal(void *p_ud) {
 	request_normal_callback(ctex);
 }
 
+void CompressedTexture2D::_requested_stream(ObjectID p_owner, int p_size) {
+	// Called from the rendering thread, the texture may be gone or on its way out by now.
+	Ref<CompressedTexture2D> ct = Object::cast_to<CompressedTexture2D>(ObjectDB::get_instance(p_owner));
+	if (ct.is_null()) {
+		return;
+	}
+	MutexLock lock(ct->stream_mutex);
+
+	ct->stream_requested_size = p_size;
+	if (ct->stream_task_active) {
+		return; // The running task picks up the new size before finishing.
+	}
+
+	if (ct->stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(ct->stream_task);
+	}
+	ct->stream_task_active = true;
+	ct->stream_task = WorkerThreadPool::get_singleton()->add_template_task(ct.ptr(), &CompressedTexture2D::_stream_task, (void *)nullptr, false, SNAME("CompressedTexture2DStream"));
+}
+
+void CompressedTexture2D::_stream_task(void *p_userdata) {
+	while (true) {
+		int size;
+		String path;
+		{
+			MutexLock lock(stream_mutex);
+			if (stream_requested_size == stream_loaded_size) {
+				stream_task_active = false;
+				return;
+			}
+			size = stream_requested_size;
+			path = path_to_file;
+		}
+
+		int lw, lh;
+		bool request_3d;
+		bool request_normal;
+		bool request_roughness;
+		int mipmap_limit;
+		Ref<Image> image;
+		image.instantiate();
+
+		Error err = _load_data(path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, size);
+
+		// Textures are replaced on the main thread, so this is serialized with load() and freeing.
+		if (err != OK) {
+			MutexLock lock(stream_mutex);
+			stream_task_active = false;
+			callable_mp(this, &CompressedTexture2D::_stream_failed).call_deferred(path);
+			return;
+		}
+
+		{
+			MutexLock lock(stream_mutex);
+			stream_loaded_size = size;
+		}
+
+		callable_mp(this, &CompressedTexture2D::_stream_apply).call_deferred(image);
+	}
+}
+
+void CompressedTexture2D::_stream_apply(const Ref<Image> &p_image) {
+	if (texture.is_null()) {
+		return;
+	}
+
+	RID new_texture = RS::get_singleton()->texture_2d_create(p_image);
+	RS::get_singleton()->texture_replace(texture, new_texture);
+	RS::get_singleton()->texture_set_size_override(texture, w, h);
+}
+
+void CompressedTexture2D::_stream_failed(const String &p_path) {
+	if (texture.is_null() || p_path != path_to_file) {
+		return; // Reloaded in the meantime.
+	}
+
+	// Stop streaming and keep the mipmaps that are loaded, this also clears the size the renderer is waiting for.
+	RS::get_singleton()->texture_set_streaming_callback(texture, Size2i(), nullptr, ObjectID());
+}
+
 CompressedTexture2D::TextureFormatRequestCallback CompressedTexture2D::request_3d_callback = nullptr;
 CompressedTexture2D::TextureFormatRoughnessRequestCallback CompressedTexture2D::request_roughness_callback = nullptr;
 CompressedTexture2D::TextureFormatRequestCallback CompressedTexture2D::request_normal_callback = nullptr;
@@ -838,9 +914,7 @@ Image::Format CompressedTexture2D::get_format() const {
 	return format;
 }
 
-Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit) {
-	alpha_cache.unref();
-
+Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit, Size2i *r_data_size) {
 	ERR_FAIL_COND_V(image.is_null(), ERR_INVALID_PARAMETER);
 
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
@@ -881,10 +955,19 @@ Error CompressedTexture2D::_load_data(const String &p_path, int &r_width, int &r
 	r_request_normal = false;
 
 #endif
-	if (!(df & FORMAT_BIT_STREAM)) {
+	// Any texture with mipmaps can skip its largest ones, so streaming doesn't need the file to be flagged.
+	if (!(df & (FORMAT_BIT_STREAM | FORMAT_BIT_HAS_MIPMAPS))) {
 		p_size_limit = 0;
 	}
 
+	if (r_data_size) {
+		uint64_t data_pos = f->get_position();
+		f->get_32(); // Data format.
+		r_data_size->width = f->get_16();
+		r_data_size->height = f->get_16();
+		f->seek(data_pos);
+	}
+
 	image = load_image_from_file(f, p_size_limit);
 
 	if (image.is_null() || image->is_empty()) {
@@ -904,7 +987,16 @@ Error CompressedTexture2D::load(const String &p_path) {
 	bool request_roughness;
 	int mipmap_limit;
 
-	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit);
+	// Start with only the lowest mipmaps, the renderer streams in the rest when needed.
+	int size_limit = 0;
+	if (GLOBAL_GET("rendering/textures/streaming/enabled") && RS::get_singleton()->get_rendering_device() && !Engine::get_singleton()->is_editor_hint()) {
+		size_limit = MAX(int(GLOBAL_GET("rendering/textures/streaming/min_size")), 1);
+	}
+	Size2i data_size;
+
+	alpha_cache.unref();
+
+	Error err = _load_data(p_path, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit, size_limit, &data_size);
 	if (err) {
 		return err;
 	}
@@ -929,6 +1021,19 @@ Error CompressedTexture2D::load(const String &p_path) {
 		RenderingServer::get_singleton()->texture_set_path(texture, p_path);
 	}
 
+	{
+		MutexLock lock(stream_mutex);
+		stream_requested_size = 0;
+		stream_loaded_size = 0;
+		stream_enabled = size_limit > 0 && image->has_mipmaps() && (image->get_width() < data_size.width || image->get_height() < data_size.height);
+	}
+
+	if (stream_enabled) {
+		RS::get_singleton()->texture_set_streaming_callback(texture, data_size, _requested_stream, get_instance_id());
+	} else {
+		RS::get_singleton()->texture_set_streaming_callback(texture, Size2i(), nullptr, ObjectID());
+	}
+
 #ifdef TOOLS_ENABLED
 
 	if (request_3d) {
@@ -1007,6 +1112,24 @@ bool CompressedTexture2D::has_alpha() const {
 
 Ref<Image> CompressedTexture2D::get_image() const {
 	if (texture.is_valid()) {
+		bool streamed;
+		{
+			MutexLock lock(stream_mutex);
+			streamed = stream_enabled;
+		}
+		if (streamed) {
+			// The renderer may hold only the smaller mipmaps, read them all from the file instead.
+			int lw, lh;
+			bool request_3d;
+			bool request_normal;
+			bool request_roughness;
+			int mipmap_limit;
+			Ref<Image> image;
+			image.instantiate();
+			if (_load_data(path_to_file, lw, lh, image, request_3d, request_normal, request_roughness, mipmap_limit) == OK) {
+				return image;
+			}
+		}
 		return RS::get_singleton()->texture_2d_get(texture);
 	} else {
 		return Ref<Image>();
@@ -1075,6 +1198,9 @@ void CompressedTexture2D::_bind_methods() {
 CompressedTexture2D::CompressedTexture2D() {}
 
 CompressedTexture2D::~CompressedTexture2D() {
+	if (stream_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(stream_task);
+	}
 	if (texture.is_valid()) {
 		ERR_FAIL_NULL(RenderingServer::get_singleton());
 		RS::get_singleton()->free(texture);
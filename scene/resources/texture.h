@@ -35,6 +35,7 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/math/rect2.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "core/os/thread_safe.h"
@@ -237,7 +238,7 @@ public:
 	};
 
 private:
-	Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0);
+	static Error _load_data(const String &p_path, int &r_width, int &r_height, Ref<Image> &image, bool &r_request_3d, bool &r_request_normal, bool &r_request_roughness, int &mipmap_limit, int p_size_limit = 0, Size2i *r_data_size = nullptr);
 	String path_to_file;
 	mutable RID texture;
 	Image::Format format = Image::FORMAT_L8;
@@ -245,12 +246,25 @@ private:
 	int h = 0;
 	mutable Ref<BitMap> alpha_cache;
 
+	// Texture streaming, the renderer asks for more or fewer mipmaps through _requested_stream().
+	Mutex stream_mutex;
+	WorkerThreadPool::TaskID stream_task = WorkerThreadPool::INVALID_TASK_ID;
+	bool stream_task_active = false;
+	int stream_requested_size = 0;
+	int stream_loaded_size = 0;
+	bool stream_enabled = false; // Loaded with fewer mipmaps than the file has.
+
 	virtual void reload_from_file() override;
 
 	static void _requested_3d(void *p_ud);
 	static void _requested_roughness(void *p_ud, const String &p_normal_path, RS::TextureDetectRoughnessChannel p_roughness_channel);
 	static void _requested_normal(void *p_ud);
 
+	static void _requested_stream(ObjectID p_owner, int p_size);
+	void _stream_task(void *p_userdata);
+	void _stream_apply(const Ref<Image> &p_image);
+	void _stream_failed(const String &p_path);
+
 protected:
 	static void _bind_methods();
 	void _validate_property(PropertyInfo &p_property) const;
@@ -91,6 +91,7 @@ public:
 	virtual bool material_casts_shadows(RID p_material) override { return false; }
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) override {}
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) override {}
+	virtual void material_request_texture_size(RID p_material, uint32_t p_size) override {}
 };
 
 } // namespace RendererDummy
@@ -57,6 +57,39 @@ void MeshStorage::mesh_free(RID p_rid) {
 	mesh_owner.free(p_rid);
 }
 
+void MeshStorage::mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND(!m);
+
+	m->custom_aabb = p_aabb;
+}
+
+AABB MeshStorage::mesh_get_custom_aabb(RID p_mesh) const {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND_V(!m, AABB());
+
+	return m->custom_aabb;
+}
+
+AABB MeshStorage::mesh_get_aabb(RID p_mesh, RID p_skeleton) {
+	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
+	ERR_FAIL_COND_V(!m, AABB());
+
+	if (m->custom_aabb != AABB()) {
+		return m->custom_aabb;
+	}
+
+	AABB aabb;
+	for (int i = 0; i < m->surfaces.size(); i++) {
+		if (i == 0) {
+			aabb = m->surfaces[i].aabb;
+		} else {
+			aabb.merge_with(m->surfaces[i].aabb);
+		}
+	}
+	return aabb;
+}
+
 void MeshStorage::mesh_clear(RID p_mesh) {
 	DummyMesh *m = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_COND(!m);
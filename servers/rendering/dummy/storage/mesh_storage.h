@@ -46,6 +46,7 @@ private:
 		int blend_shape_count;
 		RS::BlendShapeMode blend_shape_mode;
 		PackedFloat32Array blend_shape_values;
+		AABB custom_aabb;
 	};
 
 	mutable RID_Owner<DummyMesh> mesh_owner;
@@ -111,10 +112,10 @@ public:
 		return m->surfaces.size();
 	}
 
-	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override {}
-	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override { return AABB(); }
+	virtual void mesh_set_custom_aabb(RID p_mesh, const AABB &p_aabb) override;
+	virtual AABB mesh_get_custom_aabb(RID p_mesh) const override;
 
-	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override { return AABB(); }
+	virtual AABB mesh_get_aabb(RID p_mesh, RID p_skeleton = RID()) override;
 	virtual void mesh_set_shadow_mesh(RID p_mesh, RID p_shadow_mesh) override {}
 	virtual void mesh_clear(RID p_mesh) override;
 
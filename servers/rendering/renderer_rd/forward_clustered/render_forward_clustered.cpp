@@ -256,6 +256,8 @@ RID RenderForwardClustered::RenderBufferDataForwardClustered::get_specular_only_
 void RenderForwardClustered::setup_render_buffer_data(Ref<RenderSceneBuffersRD> p_render_buffers) {
 	Ref<RenderBufferDataForwardClustered> data;
 	data.instantiate();
+	data->lod_cache.slot = lod_cache_next_slot;
+	lod_cache_next_slot = (lod_cache_next_slot + 1) % LOD_CACHE_SLOTS;
 	p_render_buffers->set_custom_data(RB_SCOPE_FORWARD_CLUSTERED, data);
 
 	Ref<RendererRD::GI::RenderBuffersGI> rbgi;
@@ -794,9 +796,35 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	static const uint32_t subtractor[RS::PRIMITIVE_MAX] = { 0, 0, 1, 0, 1 };
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
+void RenderForwardClustered::_update_lod_cache(LODCache &r_lod_cache, const RenderSceneDataRD *p_scene_data) {
+	const Transform3D &cam_transform = p_scene_data->cam_transform;
+
+	bool invalidate = r_lod_cache.epoch == 0;
+	invalidate = invalidate || cam_transform.origin.distance_squared_to(r_lod_cache.camera_transform.origin) > lod_cache_camera_threshold * lod_cache_camera_threshold;
+	// About one degree of camera rotation, as it changes the AABB support points used for the LOD distance.
+	invalidate = invalidate || cam_transform.basis.get_column(Vector3::AXIS_Z).dot(r_lod_cache.camera_transform.basis.get_column(Vector3::AXIS_Z)) < 0.99985;
+	invalidate = invalidate || p_scene_data->lod_distance_multiplier != r_lod_cache.distance_multiplier || p_scene_data->screen_mesh_lod_threshold != r_lod_cache.threshold || p_scene_data->cam_orthogonal != r_lod_cache.orthogonal;
+
+	if (invalidate) {
+		r_lod_cache.epoch = ++lod_cache_epoch_counter;
+		r_lod_cache.camera_transform = cam_transform;
+		r_lod_cache.distance_multiplier = p_scene_data->lod_distance_multiplier;
+		r_lod_cache.threshold = p_scene_data->screen_mesh_lod_threshold;
+		r_lod_cache.orthogonal = p_scene_data->cam_orthogonal;
+	}
+}
+
 void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, uint32_t p_color_pass_flags = 0, bool p_using_sdfgi, bool p_using_opaque_gi, bool p_append) {
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
 
+	// Only the main pass of viewports uses the LOD cache, shadow passes and reflection probes have a different point of view every time.
+	Ref<RenderBufferDataForwardClustered> lod_cache_rb_data;
+	if (p_render_list == RENDER_LIST_OPAQUE && p_render_data->scene_data->screen_mesh_lod_threshold > 0.0 && p_render_data->render_buffers.is_valid() && p_render_data->render_buffers->has_custom_data(RB_SCOPE_FORWARD_CLUSTERED)) {
+		lod_cache_rb_data = p_render_data->render_buffers->get_custom_data(RB_SCOPE_FORWARD_CLUSTERED);
+		_update_lod_cache(lod_cache_rb_data->lod_cache, p_render_data->scene_data);
+	}
+	const LODCache *lod_cache = lod_cache_rb_data.is_valid() ? &lod_cache_rb_data->lod_cache : nullptr;
+
 	if (p_render_list == RENDER_LIST_OPAQUE) {
 		scene_state.used_sss = false;
 		scene_state.used_screen_texture = false;
@@ -937,6 +965,9 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 
 		GeometryInstanceSurfaceDataCache *surf = inst->surface_caches;
 
+		bool lod_cache_valid = lod_cache && inst->lod_cache_epoch[lod_cache->slot] == lod_cache->epoch;
+		float lod_distance = -1.0; // Computed on demand, it's the same for all surfaces.
+
 		while (surf) {
 			surf->sort.uses_forward_gi = 0;
 			surf->sort.uses_lightmap = 0;
@@ -944,31 +975,49 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 			// LOD
 
 			if (p_render_data->scene_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
-				// Get the LOD support points on the mesh AABB.
-				Vector3 lod_support_min = inst->transformed_aabb.get_support(p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
-				Vector3 lod_support_max = inst->transformed_aabb.get_support(-p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
-
-				// Get the distances to those points on the AABB from the camera origin.
-				float distance_min = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_min);
-				float distance_max = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_max);
-
-				float distance = 0.0;
-
-				if (distance_min * distance_max < 0.0) {
-					//crossing plane
-					distance = 0.0;
-				} else if (distance_min >= 0.0) {
-					distance = distance_min;
-				} else if (distance_max <= 0.0) {
-					distance = -distance_max;
-				}
+				uint32_t indices = 0;
+
+				GeometryInstanceSurfaceDataCache::LODCacheEntry *lod_cache_entry = lod_cache ? &surf->lod_cache[lod_cache->slot] : nullptr;
+
+				if (lod_cache_valid && lod_cache_entry->epoch == lod_cache->epoch) {
+					surf->sort.lod_index = lod_cache_entry->index;
+					indices = lod_cache_entry->index_count;
+				} else {
+					if (lod_distance < 0.0) {
+						// Get the LOD support points on the mesh AABB.
+						Vector3 lod_support_min = inst->transformed_aabb.get_support(p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+						Vector3 lod_support_max = inst->transformed_aabb.get_support(-p_render_data->scene_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+
+						// Get the distances to those points on the AABB from the camera origin.
+						float distance_min = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_min);
+						float distance_max = (float)p_render_data->scene_data->cam_transform.origin.distance_to(lod_support_max);
+
+						lod_distance = 0.0;
+
+						if (distance_min * distance_max < 0.0) {
+							//crossing plane
+							lod_distance = 0.0;
+						} else if (distance_min >= 0.0) {
+							lod_distance = distance_min;
+						} else if (distance_max <= 0.0) {
+							lod_distance = -distance_max;
+						}
 
-				if (p_render_data->scene_data->cam_orthogonal) {
-					distance = 1.0;
+						if (p_render_data->scene_data->cam_orthogonal) {
+							lod_distance = 1.0;
+						}
+					}
+
+					if (lod_cache_entry) {
+						surf->sort.lod_index = mesh_storage->mesh_surface_get_lod_with_hysteresis(surf->surface, inst->lod_model_scale * inst->lod_bias, lod_distance * p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, lod_hysteresis, lod_cache_entry->index, indices);
+						lod_cache_entry->index = surf->sort.lod_index;
+						lod_cache_entry->index_count = indices;
+						lod_cache_entry->epoch = lod_cache->epoch;
+					} else {
+						surf->sort.lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, lod_distance * p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, indices);
+					}
 				}
 
-				uint32_t indices = 0;
-				surf->sort.lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * p_render_data->scene_data->lod_distance_multiplier, p_render_data->scene_data->screen_mesh_lod_threshold, indices);
 				if (p_render_data->render_info) {
 					indices = _indices_to_primitives(surf->primitive, indices);
 					if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
@@ -1050,6 +1099,10 @@ void RenderForwardClustered::_fill_render_list(RenderListType p_render_list, con
 
 			surf = surf->next;
 		}
+
+		if (lod_cache) {
+			inst->lod_cache_epoch[lod_cache->slot] = lod_cache->epoch;
+		}
 	}
 
 	if (p_render_list == RENDER_LIST_OPAQUE && lightmap_captures_used) {
@@ -3829,6 +3882,18 @@ void RenderForwardClustered::GeometryInstanceForwardClustered::set_transform(con
 	}
 
 	RenderGeometryInstanceBase::set_transform(p_transform, p_aabb, p_transformed_aabbb);
+
+	for (uint64_t &epoch : lod_cache_epoch) {
+		epoch = 0;
+	}
+}
+
+void RenderForwardClustered::GeometryInstanceForwardClustered::set_lod_bias(float p_lod_bias) {
+	RenderGeometryInstanceBase::set_lod_bias(p_lod_bias);
+
+	for (uint64_t &epoch : lod_cache_epoch) {
+		epoch = 0;
+	}
 }
 
 void RenderForwardClustered::GeometryInstanceForwardClustered::set_use_lightmap(RID p_lightmap_instance, const Rect2 &p_lightmap_uv_scale, int p_lightmap_slice_index) {
@@ -3994,6 +4059,8 @@ RenderForwardClustered::RenderForwardClustered() {
 	}
 
 	render_list_thread_threshold = GLOBAL_GET("rendering/limits/forward_renderer/threaded_render_minimum_instances");
+	lod_cache_camera_threshold = GLOBAL_GET("rendering/mesh_lod/lod_change/cache_camera_threshold");
+	lod_hysteresis = GLOBAL_GET("rendering/mesh_lod/lod_change/hysteresis");
 
 	_update_shader_quality_settings();
 
@@ -91,6 +91,24 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 	SceneShaderForwardClustered scene_shader;
 
+	/* Mesh LOD cache */
+
+	// Mesh LOD selection of the main pass is reused while the camera stays within a small threshold
+	// of where LODs were last evaluated. Every viewport keeps its own camera state in its render buffers,
+	// and geometry instances keep a few slots of results so viewports don't evict each other's.
+	enum {
+		LOD_CACHE_SLOTS = 4
+	};
+
+	struct LODCache {
+		uint64_t epoch = 0; // Bumped whenever the cached LODs are no longer valid, 0 until first used.
+		uint32_t slot = 0;
+		Transform3D camera_transform;
+		float distance_multiplier = 0.0;
+		float threshold = 0.0;
+		bool orthogonal = false;
+	};
+
 	/* Framebuffer */
 
 	class RenderBufferDataForwardClustered : public RenderBufferCustomDataRD {
@@ -120,6 +138,8 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 		RID render_sdfgi_uniform_set;
 
+		LODCache lod_cache;
+
 		RID get_color_msaa() const { return render_buffers->get_texture(RB_SCOPE_FORWARD_CLUSTERED, RB_TEX_COLOR_MSAA); }
 		RID get_color_msaa(uint32_t p_layer) { return render_buffers->get_texture_slice(RB_SCOPE_FORWARD_CLUSTERED, RB_TEX_COLOR_MSAA, p_layer, 0); }
 
@@ -375,6 +395,14 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 	uint32_t render_list_thread_threshold = 500;
 
+	// Epochs are unique across viewports, so viewports sharing a slot never see each other's results as valid.
+	uint64_t lod_cache_epoch_counter = 0;
+	uint32_t lod_cache_next_slot = 0;
+	float lod_cache_camera_threshold = 0.05;
+	float lod_hysteresis = 0.1;
+
+	void _update_lod_cache(LODCache &r_lod_cache, const RenderSceneDataRD *p_scene_data);
+
 	void _update_instance_data_buffer(RenderListType p_render_list);
 	void _fill_instance_data(RenderListType p_render_list, int *p_render_info = nullptr, uint32_t p_offset = 0, int32_t p_max_elements = -1, bool p_update_buffer = true);
 	void _fill_render_list(RenderListType p_render_list, const RenderDataRD *p_render_data, PassMode p_pass_mode, uint32_t p_color_pass_flags, bool p_using_sdfgi = false, bool p_using_opaque_gi = false, bool p_append = false);
@@ -439,6 +467,12 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		RID material_uniform_set_shadow;
 		SceneShaderForwardClustered::ShaderData *shader_shadow = nullptr;
 
+		struct LODCacheEntry {
+			uint64_t epoch = 0;
+			uint32_t index = 0;
+			uint32_t index_count = 0;
+		} lod_cache[LOD_CACHE_SLOTS];
+
 		GeometryInstanceSurfaceDataCache *next = nullptr;
 		GeometryInstanceForwardClustered *owner = nullptr;
 	};
@@ -461,6 +495,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		bool can_sdfgi = false;
 		bool using_projectors = false;
 		bool using_softshadows = false;
+		uint64_t lod_cache_epoch[LOD_CACHE_SLOTS] = {};
 
 		//used during setup
 		uint64_t prev_transform_change_frame = 0xFFFFFFFF;
@@ -476,6 +511,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		virtual void _mark_dirty() override;
 
 		virtual void set_transform(const Transform3D &p_transform, const AABB &p_aabb, const AABB &p_transformed_aabbb) override;
+		virtual void set_lod_bias(float p_lod_bias) override;
 		virtual void set_use_lightmap(RID p_lightmap_instance, const Rect2 &p_lightmap_uv_scale, int p_lightmap_slice_index) override;
 		virtual void set_lightmap_capture(const Color *p_sh9) override;
 
@@ -135,10 +135,20 @@ public:
 		bool writes_modelview_or_projection = false;
 		bool uses_world_coordinates = false;
 
+		BlendMode blend_mode = BLEND_MODE_MIX;
+		AlphaAntiAliasing alpha_antialiasing_mode = ALPHA_ANTIALIASING_OFF;
+		bool wireframe = false;
+		Cull cull_mode = CULL_BACK;
+		bool compile_pending = false;
+
 		uint64_t last_pass = 0;
 		uint32_t index = 0;
 
+		void _setup_pipelines();
+
 		virtual void set_code(const String &p_Code);
+		virtual bool is_compile_pending() const { return compile_pending; }
+		virtual bool poll_compile();
 		virtual bool is_animated() const;
 		virtual bool casts_shadows() const;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const;
@@ -30,9 +30,11 @@
 
 #include "pipeline_cache_rd.h"
 
+#include "core/io/file_access.h"
 #include "core/os/memory.h"
+#include "servers/rendering/renderer_rd/shader_rd.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
 	RD::PipelineMultisampleState multisample_state_version = multisample_state;
 	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
 
@@ -57,20 +59,34 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
-	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+void PipelineCacheRD::_add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline) {
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
-	versions[version_count].pipeline = pipeline;
+	versions[version_count].wireframe = p_wireframe;
+	versions[version_count].pipeline = p_pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
 	version_count++;
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	ERR_FAIL_COND_V(pipeline.is_null(), RID());
+	_add_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, pipeline);
+
+	if (manifest_recording && manifest_key != 0) {
+		_record_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	}
 	return pipeline;
 }
 
 void PipelineCacheRD::_clear() {
+	_wait_for_precompile();
+
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
 		for (uint32_t i = 0; i < version_count; i++) {
@@ -97,10 +113,14 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+	manifest_key = _compute_manifest_key();
+	_start_precompile();
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
+	manifest_key = _compute_manifest_key();
+	_start_precompile();
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
@@ -113,6 +133,353 @@ void PipelineCacheRD::clear() {
 	_clear();
 	shader = RID(); //clear shader
 	input_mask = 0;
+	manifest_key = 0;
+}
+
+/* PIPELINE MANIFEST */
+
+static const char *pipeline_manifest_header = "GDPM";
+static const uint32_t pipeline_manifest_version = 1;
+
+Mutex PipelineCacheRD::manifest_mutex;
+HashMap<uint64_t, LocalVector<PipelineCacheRD::ManifestVersion>> PipelineCacheRD::manifest;
+bool PipelineCacheRD::manifest_recording = false;
+
+uint64_t PipelineCacheRD::_compute_manifest_key() const {
+	uint32_t variant_hash = ShaderRD::get_variant_hash(shader);
+	if (variant_hash == 0) {
+		return 0; // Not a ShaderRD variant, can't be matched in a later session.
+	}
+
+	uint32_t h = hash_murmur3_one_32(render_primitive);
+
+	h = hash_murmur3_one_32(rasterization_state.enable_depth_clamp, h);
+	h = hash_murmur3_one_32(rasterization_state.discard_primitives, h);
+	h = hash_murmur3_one_32(rasterization_state.wireframe, h);
+	h = hash_murmur3_one_32(rasterization_state.cull_mode, h);
+	h = hash_murmur3_one_32(rasterization_state.front_face, h);
+	h = hash_murmur3_one_32(rasterization_state.depth_bias_enabled, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_constant_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_clamp, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_slope_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.line_width, h);
+	h = hash_murmur3_one_32(rasterization_state.patch_control_points, h);
+
+	h = hash_murmur3_one_32(multisample_state.sample_count, h);
+	h = hash_murmur3_one_32(multisample_state.enable_sample_shading, h);
+	h = hash_murmur3_one_float(multisample_state.min_sample_shading, h);
+	for (uint32_t mask : multisample_state.sample_mask) {
+		h = hash_murmur3_one_32(mask, h);
+	}
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_coverage, h);
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_one, h);
+
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_test, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_write, h);
+	h = hash_murmur3_one_32(depth_stencil_state.depth_compare_operator, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_range, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_min, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_max, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_stencil, h);
+	const RD::PipelineDepthStencilState::StencilOperationState *stencil_ops[2] = { &depth_stencil_state.front_op, &depth_stencil_state.back_op };
+	for (int i = 0; i < 2; i++) {
+		h = hash_murmur3_one_32(stencil_ops[i]->fail, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->pass, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->depth_fail, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->compare, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->compare_mask, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->write_mask, h);
+		h = hash_murmur3_one_32(stencil_ops[i]->reference, h);
+	}
+
+	h = hash_murmur3_one_32(blend_state.enable_logic_op, h);
+	h = hash_murmur3_one_32(blend_state.logic_op, h);
+	for (const RD::PipelineColorBlendState::Attachment &attachment : blend_state.attachments) {
+		h = hash_murmur3_one_32(attachment.enable_blend, h);
+		h = hash_murmur3_one_32(attachment.src_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.color_blend_op, h);
+		h = hash_murmur3_one_32(attachment.src_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.alpha_blend_op, h);
+		h = hash_murmur3_one_32(attachment.write_r | (attachment.write_g << 1) | (attachment.write_b << 2) | (attachment.write_a << 3), h);
+	}
+	h = hash_murmur3_one_float(blend_state.blend_constant.r, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.g, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.b, h);
+	h = hash_murmur3_one_float(blend_state.blend_constant.a, h);
+
+	h = hash_murmur3_one_32(dynamic_state_flags, h);
+	for (const RD::PipelineSpecializationConstant &sc : base_specialization_constants) {
+		h = hash_murmur3_one_32(sc.type, h);
+		h = hash_murmur3_one_32(sc.constant_id, h);
+		h = hash_murmur3_one_32(sc.int_value, h);
+	}
+
+	return (uint64_t(variant_hash) << 32) | hash_fmix32(h);
+}
+
+void PipelineCacheRD::_start_precompile() {
+	if (manifest_key == 0) {
+		return;
+	}
+
+	{
+		MutexLock lock(manifest_mutex);
+		const LocalVector<ManifestVersion> *manifest_versions = manifest.getptr(manifest_key);
+		if (!manifest_versions) {
+			return;
+		}
+		precompile_versions = *manifest_versions;
+	}
+
+	precompile_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PipelineCacheRD::_precompile_version, precompile_versions.ptr(), precompile_versions.size(), -1, false, "PipelineCacheRD precompile");
+}
+
+void PipelineCacheRD::_wait_for_precompile() {
+	if (precompile_task == -1) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(precompile_task);
+	precompile_task = -1;
+	precompile_versions.clear();
+}
+
+void PipelineCacheRD::_precompile_version(uint32_t p_index, const ManifestVersion *p_versions) {
+	const ManifestVersion &version = p_versions[p_index];
+
+	// Drawing may have needed this version already.
+	spin_lock.lock();
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == version.vertex_id && versions[i].framebuffer_id == version.framebuffer_id && versions[i].wireframe == version.wireframe && versions[i].render_pass == version.render_pass && versions[i].bool_specializations == version.bool_specializations) {
+			spin_lock.unlock();
+			return;
+		}
+	}
+	spin_lock.unlock();
+
+	// Create without holding the lock, so drawing with other versions is not blocked.
+	RID pipeline = _create_pipeline(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations);
+	if (pipeline.is_null()) {
+		return;
+	}
+
+	spin_lock.lock();
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == version.vertex_id && versions[i].framebuffer_id == version.framebuffer_id && versions[i].wireframe == version.wireframe && versions[i].render_pass == version.render_pass && versions[i].bool_specializations == version.bool_specializations) {
+			spin_lock.unlock();
+			RD::get_singleton()->free(pipeline);
+			return;
+		}
+	}
+	_add_version(version.vertex_id, version.framebuffer_id, version.wireframe, version.render_pass, version.bool_specializations, pipeline);
+	spin_lock.unlock();
+}
+
+void PipelineCacheRD::_record_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	MutexLock lock(manifest_mutex);
+
+	LocalVector<ManifestVersion> &manifest_versions = manifest[manifest_key];
+	for (const ManifestVersion &E : manifest_versions) {
+		if (E.vertex_id == p_vertex_format_id && E.framebuffer_id == p_framebuffer_format_id && E.wireframe == p_wireframe && E.render_pass == p_render_pass && E.bool_specializations == p_bool_specializations) {
+			return;
+		}
+	}
+
+	ManifestVersion version;
+	version.vertex_id = p_vertex_format_id;
+	version.framebuffer_id = p_framebuffer_format_id;
+	version.render_pass = p_render_pass;
+	version.wireframe = p_wireframe;
+	version.bool_specializations = p_bool_specializations;
+
+	if (p_vertex_format_id != RD::INVALID_FORMAT_ID) {
+		version.has_vertex_format = true;
+		version.vertex_attributes = RD::get_singleton()->vertex_format_get_attributes(p_vertex_format_id);
+	}
+	ERR_FAIL_COND(!RD::get_singleton()->framebuffer_format_get_description(p_framebuffer_format_id, version.attachments, version.passes, version.view_count));
+	version.samples = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, 0);
+
+	manifest_versions.push_back(version);
+}
+
+Error PipelineCacheRD::load_manifest(const String &p_path) {
+	HashMap<uint64_t, LocalVector<ManifestVersion>> loaded;
+	Error err = read_manifest_file(p_path, loaded);
+	if (err != OK) {
+		return err;
+	}
+
+	MutexLock lock(manifest_mutex);
+
+	for (KeyValue<uint64_t, LocalVector<ManifestVersion>> &E : loaded) {
+		for (ManifestVersion &version : E.value) {
+			// IDs are only valid for this session, so recreate the formats from their descriptions.
+			if (version.has_vertex_format) {
+				version.vertex_id = RD::get_singleton()->vertex_format_create(version.vertex_attributes);
+			}
+			if (version.attachments.is_empty()) {
+				version.framebuffer_id = RD::get_singleton()->framebuffer_format_create_empty(version.samples);
+			} else {
+				version.framebuffer_id = RD::get_singleton()->framebuffer_format_create_multipass(version.attachments, version.passes, version.view_count);
+			}
+			if (version.framebuffer_id == RD::INVALID_FORMAT_ID || (version.has_vertex_format && version.vertex_id == RD::INVALID_FORMAT_ID)) {
+				continue; // Not supported on this device.
+			}
+
+			manifest[E.key].push_back(version);
+		}
+	}
+
+	print_verbose("Loaded pipeline manifest with " + itos(manifest.size()) + " pipeline caches from: " + p_path);
+	return OK;
+}
+
+Error PipelineCacheRD::save_manifest(const String &p_path) {
+	MutexLock lock(manifest_mutex);
+	return write_manifest_file(p_path, manifest);
+}
+
+Error PipelineCacheRD::read_manifest_file(const String &p_path, HashMap<uint64_t, LocalVector<ManifestVersion>> &r_manifest) {
+	r_manifest.clear();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		return err;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V_MSG(header != String(pipeline_manifest_header), ERR_FILE_CORRUPT, "Invalid pipeline manifest: " + p_path);
+	if (f->get_32() != pipeline_manifest_version) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	uint32_t key_count = f->get_32();
+	for (uint32_t i = 0; i < key_count && !f->eof_reached(); i++) {
+		uint64_t key = f->get_64();
+		uint32_t version_count = f->get_32();
+		LocalVector<ManifestVersion> &versions = r_manifest[key];
+
+		for (uint32_t j = 0; j < version_count && !f->eof_reached(); j++) {
+			ManifestVersion version;
+
+			version.has_vertex_format = f->get_8();
+			uint32_t attribute_count = f->get_32();
+			for (uint32_t k = 0; k < attribute_count && !f->eof_reached(); k++) {
+				RD::VertexAttribute attribute;
+				attribute.location = f->get_32();
+				attribute.offset = f->get_32();
+				attribute.format = RD::DataFormat(f->get_32());
+				attribute.stride = f->get_32();
+				attribute.frequency = RD::VertexFrequency(f->get_32());
+				version.vertex_attributes.push_back(attribute);
+			}
+
+			uint32_t attachment_count = f->get_32();
+			for (uint32_t k = 0; k < attachment_count && !f->eof_reached(); k++) {
+				RD::AttachmentFormat attachment;
+				attachment.format = RD::DataFormat(f->get_32());
+				attachment.samples = RD::TextureSamples(f->get_32());
+				attachment.usage_flags = f->get_32();
+				version.attachments.push_back(attachment);
+			}
+
+			uint32_t pass_count = f->get_32();
+			for (uint32_t k = 0; k < pass_count && !f->eof_reached(); k++) {
+				RD::FramebufferPass pass;
+				Vector<int32_t> *lists[4] = { &pass.color_attachments, &pass.input_attachments, &pass.resolve_attachments, &pass.preserve_attachments };
+				for (int l = 0; l < 4; l++) {
+					uint32_t count = f->get_32();
+					for (uint32_t m = 0; m < count && !f->eof_reached(); m++) {
+						lists[l]->push_back(int32_t(f->get_32()));
+					}
+				}
+				pass.depth_attachment = int32_t(f->get_32());
+				pass.vrs_attachment = int32_t(f->get_32());
+				version.passes.push_back(pass);
+			}
+
+			version.view_count = f->get_32();
+			version.samples = RD::TextureSamples(f->get_32());
+			version.render_pass = f->get_32();
+			version.wireframe = f->get_8();
+			version.bool_specializations = f->get_32();
+
+			versions.push_back(version);
+		}
+	}
+
+	if (f->eof_reached()) {
+		r_manifest.clear();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "Truncated pipeline manifest: " + p_path);
+	}
+	return OK;
+}
+
+Error PipelineCacheRD::write_manifest_file(const String &p_path, const HashMap<uint64_t, LocalVector<ManifestVersion>> &p_manifest) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Can't save pipeline manifest: " + p_path);
+
+	f->store_buffer((const uint8_t *)pipeline_manifest_header, 4);
+	f->store_32(pipeline_manifest_version);
+
+	f->store_32(p_manifest.size());
+	for (const KeyValue<uint64_t, LocalVector<ManifestVersion>> &E : p_manifest) {
+		f->store_64(E.key);
+		f->store_32(E.value.size());
+
+		for (const ManifestVersion &version : E.value) {
+			f->store_8(version.has_vertex_format);
+			f->store_32(version.vertex_attributes.size());
+			for (const RD::VertexAttribute &attribute : version.vertex_attributes) {
+				f->store_32(attribute.location);
+				f->store_32(attribute.offset);
+				f->store_32(attribute.format);
+				f->store_32(attribute.stride);
+				f->store_32(attribute.frequency);
+			}
+
+			f->store_32(version.attachments.size());
+			for (const RD::AttachmentFormat &attachment : version.attachments) {
+				f->store_32(attachment.format);
+				f->store_32(attachment.samples);
+				f->store_32(attachment.usage_flags);
+			}
+
+			f->store_32(version.passes.size());
+			for (const RD::FramebufferPass &pass : version.passes) {
+				const Vector<int32_t> *lists[4] = { &pass.color_attachments, &pass.input_attachments, &pass.resolve_attachments, &pass.preserve_attachments };
+				for (int l = 0; l < 4; l++) {
+					f->store_32(lists[l]->size());
+					for (int32_t index : *lists[l]) {
+						f->store_32(uint32_t(index));
+					}
+				}
+				f->store_32(uint32_t(pass.depth_attachment));
+				f->store_32(uint32_t(pass.vrs_attachment));
+			}
+
+			f->store_32(version.view_count);
+			f->store_32(version.samples);
+			f->store_32(version.render_pass);
+			f->store_8(version.wireframe);
+			f->store_32(version.bool_specializations);
+		}
+	}
+
+	return OK;
+}
+
+void PipelineCacheRD::set_manifest_recording(bool p_enable) {
+	manifest_recording = p_enable;
+}
+
+void PipelineCacheRD::clear_manifest() {
+	MutexLock lock(manifest_mutex);
+	manifest.clear();
 }
 
 PipelineCacheRD::PipelineCacheRD() {
@@ -31,7 +31,10 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
@@ -60,10 +63,49 @@ class PipelineCacheRD {
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _add_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RID p_pipeline);
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
 
 	void _clear();
 
+	/* PIPELINE MANIFEST */
+
+	// A manifest lists the pipeline versions that were used in a previous session, so they
+	// can be created on worker threads as soon as the cache is set up instead of on first draw.
+
+public:
+	struct ManifestVersion {
+		RD::VertexFormatID vertex_id = RD::INVALID_FORMAT_ID;
+		RD::FramebufferFormatID framebuffer_id = RD::INVALID_FORMAT_ID;
+		uint32_t render_pass = 0;
+		bool wireframe = false;
+		uint32_t bool_specializations = 0;
+
+		// Descriptions of the formats above, needed to recreate them when loading.
+		bool has_vertex_format = false;
+		Vector<RD::VertexAttribute> vertex_attributes;
+		Vector<RD::AttachmentFormat> attachments;
+		Vector<RD::FramebufferPass> passes;
+		uint32_t view_count = 1;
+		RD::TextureSamples samples = RD::TEXTURE_SAMPLES_1;
+	};
+
+private:
+	static Mutex manifest_mutex;
+	static HashMap<uint64_t, LocalVector<ManifestVersion>> manifest;
+	static bool manifest_recording;
+
+	uint64_t manifest_key = 0;
+	LocalVector<ManifestVersion> precompile_versions;
+	WorkerThreadPool::GroupID precompile_task = -1;
+
+	uint64_t _compute_manifest_key() const;
+	void _start_precompile();
+	void _wait_for_precompile();
+	void _precompile_version(uint32_t p_index, const ManifestVersion *p_versions);
+	void _record_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+
 public:
 	void setup(RID p_shader, RD::RenderPrimitive p_primitive, const RD::PipelineRasterizationState &p_rasterization_state, RD::PipelineMultisampleState p_multisample, const RD::PipelineDepthStencilState &p_depth_stencil_state, const RD::PipelineColorBlendState &p_blend_state, int p_dynamic_state_flags = 0, const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants = Vector<RD::PipelineSpecializationConstant>());
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
@@ -95,6 +137,15 @@ public:
 		return input_mask;
 	}
 	void clear();
+
+	static Error load_manifest(const String &p_path);
+	static Error save_manifest(const String &p_path);
+	// Only the format descriptions are stored in the file, load_manifest() creates the formats from them.
+	static Error read_manifest_file(const String &p_path, HashMap<uint64_t, LocalVector<ManifestVersion>> &r_manifest);
+	static Error write_manifest_file(const String &p_path, const HashMap<uint64_t, LocalVector<ManifestVersion>> &p_manifest);
+	static void set_manifest_recording(bool p_enable);
+	static void clear_manifest();
+
 	PipelineCacheRD();
 	~PipelineCacheRD();
 };
@@ -32,6 +32,9 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+#include "servers/rendering/shader_compiler.h"
 
 void RendererCompositorRD::prepare_for_blitting_render_targets() {
 	RD::get_singleton()->prepare_screen_for_drawing();
@@ -284,6 +287,7 @@ RendererCompositorRD::RendererCompositorRD() {
 					bool strip_debug = GLOBAL_GET("rendering/shader_compiler/shader_cache/strip_debug");
 
 					ShaderRD::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_cache_dir(shader_cache_dir);
 					ShaderRD::set_shader_cache_save_compressed(compress);
 					ShaderRD::set_shader_cache_save_compressed_zstd(use_zstd);
 					ShaderRD::set_shader_cache_save_debug(!strip_debug);
@@ -292,6 +296,16 @@ RendererCompositorRD::RendererCompositorRD() {
 		}
 	}
 
+	{
+		String manifest_path = GLOBAL_GET("rendering/rendering_device/pipeline_manifest/path");
+		if (!manifest_path.is_empty()) {
+			if (FileAccess::exists(manifest_path)) {
+				PipelineCacheRD::load_manifest(manifest_path);
+			}
+			PipelineCacheRD::set_manifest_recording(GLOBAL_GET("rendering/rendering_device/pipeline_manifest/record"));
+		}
+	}
+
 	singleton = this;
 
 	utilities = memnew(RendererRD::Utilities);
@@ -325,4 +339,12 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_dir(String());
+	ShaderCompiler::set_cache_dir(String());
+
+	String manifest_path = GLOBAL_GET("rendering/rendering_device/pipeline_manifest/path");
+	if (!manifest_path.is_empty() && bool(GLOBAL_GET("rendering/rendering_device/pipeline_manifest/record"))) {
+		PipelineCacheRD::save_manifest(manifest_path);
+	}
+	PipelineCacheRD::set_manifest_recording(false);
+	PipelineCacheRD::clear_manifest();
 }
@@ -151,8 +151,10 @@ RID ShaderRD::version_create() {
 void ShaderRD::_clear_version(Version *p_version) {
 	//clear versions if they exist
 	if (p_version->variants) {
+		MutexLock lock(variant_hash_mutex);
 		for (int i = 0; i < variant_defines.size(); i++) {
 			if (variants_enabled[i]) {
+				variant_hashes.erase(p_version->variants[i]);
 				RD::get_singleton()->free(p_version->variants[i]);
 			}
 		}
@@ -464,6 +466,31 @@ void ShaderRD::_save_to_cache(Version *p_version) {
 	}
 }
 
+void ShaderRD::_register_variant_hashes(Version *p_version) {
+	StringBuilder hash_build;
+	hash_build.append(name);
+	hash_build.append("[base_hash]");
+	hash_build.append(base_sha256);
+	hash_build.append("[general_defines]");
+	hash_build.append(general_defines.get_data());
+	hash_build.append("[version]");
+	hash_build.append(_version_get_sha1(p_version));
+	uint32_t version_hash = hash_build.as_string().hash();
+
+	MutexLock lock(variant_hash_mutex);
+	for (int i = 0; i < variant_defines.size(); i++) {
+		if (variants_enabled[i]) {
+			variant_hashes[p_version->variants[i]] = hash_murmur3_one_32(i, version_hash);
+		}
+	}
+}
+
+uint32_t ShaderRD::get_variant_hash(RID p_shader) {
+	MutexLock lock(variant_hash_mutex);
+	const uint32_t *hash = variant_hashes.getptr(p_shader);
+	return hash ? *hash : 0;
+}
+
 void ShaderRD::_compile_version(Version *p_version) {
 	_clear_version(p_version);
 
@@ -476,6 +503,7 @@ void ShaderRD::_compile_version(Version *p_version) {
 
 	if (shader_cache_dir_valid) {
 		if (_load_from_cache(p_version)) {
+			_register_variant_hashes(p_version);
 			return;
 		}
 	}
@@ -528,13 +556,28 @@ void ShaderRD::_compile_version(Version *p_version) {
 	p_version->variant_data = nullptr;
 
 	p_version->valid = true;
+	_register_variant_hashes(p_version);
 }
 
-void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
-	ERR_FAIL_COND(is_compute);
+void ShaderRD::_compile_version_task(Version *p_version) {
+	_compile_version(p_version);
+}
+
+void ShaderRD::_wait_for_compile(Version *p_version) {
+	if (p_version->compile_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return;
+	}
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_version->compile_task);
+	p_version->compile_task = WorkerThreadPool::INVALID_TASK_ID;
+}
+
+ShaderRD::Version *ShaderRD::_version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
+	ERR_FAIL_COND_V(is_compute, nullptr);
 
 	Version *version = version_owner.get_or_null(p_version);
-	ERR_FAIL_COND(!version);
+	ERR_FAIL_COND_V(!version, nullptr);
+	_wait_for_compile(version);
+
 	version->vertex_globals = p_vertex_globals.utf8();
 	version->fragment_globals = p_fragment_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
@@ -549,17 +592,34 @@ void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_
 	}
 
 	version->dirty = true;
-	if (version->initialize_needed) {
+	return version;
+}
+
+void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
+	Version *version = _version_set_code(p_version, p_code, p_uniforms, p_vertex_globals, p_fragment_globals, p_custom_defines);
+	if (version && version->initialize_needed) {
 		_compile_version(version);
 		version->initialize_needed = false;
 	}
 }
 
+void ShaderRD::version_set_code_async(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
+	Version *version = _version_set_code(p_version, p_code, p_uniforms, p_vertex_globals, p_fragment_globals, p_custom_defines);
+	if (!version) {
+		return;
+	}
+
+	// Low priority, so compiling many materials at once leaves threads free for the variant group tasks.
+	version->initialize_needed = false;
+	version->compile_task = WorkerThreadPool::get_singleton()->add_template_task(this, &ShaderRD::_compile_version_task, version, false, "ShaderCompilation");
+}
+
 void ShaderRD::version_set_compute_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_compute_globals, const Vector<String> &p_custom_defines) {
 	ERR_FAIL_COND(!is_compute);
 
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_COND(!version);
+	_wait_for_compile(version);
 
 	version->compute_globals = p_compute_globals.utf8();
 	version->uniforms = p_uniforms.utf8();
@@ -584,6 +644,7 @@ void ShaderRD::version_set_compute_code(RID p_version, const HashMap<String, Str
 bool ShaderRD::version_is_valid(RID p_version) {
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_COND_V(!version, false);
+	_wait_for_compile(version);
 
 	if (version->dirty) {
 		_compile_version(version);
@@ -592,9 +653,24 @@ bool ShaderRD::version_is_valid(RID p_version) {
 	return version->valid;
 }
 
+bool ShaderRD::version_is_compiling(RID p_version) {
+	Version *version = version_owner.get_or_null(p_version);
+	ERR_FAIL_COND_V(!version, false);
+
+	if (version->compile_task == WorkerThreadPool::INVALID_TASK_ID) {
+		return false;
+	}
+	if (!WorkerThreadPool::get_singleton()->is_task_completed(version->compile_task)) {
+		return true;
+	}
+	_wait_for_compile(version);
+	return false;
+}
+
 bool ShaderRD::version_free(RID p_version) {
 	if (version_owner.owns(p_version)) {
 		Version *version = version_owner.get_or_null(p_version);
+		_wait_for_compile(version);
 		_clear_version(version);
 		version_owner.free(p_version);
 	} else {
@@ -697,6 +773,8 @@ void ShaderRD::set_shader_cache_save_debug(bool p_enable) {
 }
 
 String ShaderRD::shader_cache_dir;
+Mutex ShaderRD::variant_hash_mutex;
+HashMap<RID, uint32_t> ShaderRD::variant_hashes;
 bool ShaderRD::shader_cache_save_compressed = true;
 bool ShaderRD::shader_cache_save_compressed_zstd = true;
 bool ShaderRD::shader_cache_save_debug = true;
@@ -31,6 +31,7 @@
 #ifndef SHADER_RD_H
 #define SHADER_RD_H
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 #include "core/string/string_builder.h"
 #include "core/templates/hash_map.h"
@@ -60,14 +61,24 @@ class ShaderRD {
 		bool valid;
 		bool dirty;
 		bool initialize_needed;
+
+		WorkerThreadPool::TaskID compile_task = WorkerThreadPool::INVALID_TASK_ID;
 	};
 
 	Mutex variant_set_mutex;
 
+	// Stable identifiers for compiled variants, used to match pipelines across sessions (see PipelineCacheRD).
+	static Mutex variant_hash_mutex;
+	static HashMap<RID, uint32_t> variant_hashes;
+	void _register_variant_hashes(Version *p_version);
+
 	void _compile_variant(uint32_t p_variant, Version *p_version);
 
 	void _clear_version(Version *p_version);
 	void _compile_version(Version *p_version);
+	void _compile_version_task(Version *p_version);
+	void _wait_for_compile(Version *p_version);
+	Version *_version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines);
 
 	RID_Owner<Version> version_owner;
 
@@ -130,6 +141,8 @@ public:
 	RID version_create();
 
 	void version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines);
+	// Like version_set_code(), but the variants are compiled on a worker thread. Poll version_is_compiling() to know when they are ready.
+	void version_set_code_async(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines);
 	void version_set_compute_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_compute_globals, const Vector<String> &p_custom_defines);
 
 	_FORCE_INLINE_ RID version_get_shader(RID p_version, int p_variant) {
@@ -139,6 +152,10 @@ public:
 		Version *version = version_owner.get_or_null(p_version);
 		ERR_FAIL_COND_V(!version, RID());
 
+		if (version->compile_task != WorkerThreadPool::INVALID_TASK_ID) {
+			_wait_for_compile(version);
+		}
+
 		if (version->dirty) {
 			_compile_version(version);
 		}
@@ -151,12 +168,15 @@ public:
 	}
 
 	bool version_is_valid(RID p_version);
+	bool version_is_compiling(RID p_version);
 
 	bool version_free(RID p_version);
 
 	void set_variant_enabled(int p_variant, bool p_enabled);
 	bool is_variant_enabled(int p_variant) const;
 
+	static uint32_t get_variant_hash(RID p_shader);
+
 	static void set_shader_cache_dir(const String &p_dir);
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
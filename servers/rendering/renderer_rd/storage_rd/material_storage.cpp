@@ -755,6 +755,8 @@ void MaterialStorage::MaterialData::update_textures(const HashMap<StringName, Va
 	TextureStorage *texture_storage = TextureStorage::get_singleton();
 	MaterialStorage *material_storage = MaterialStorage::get_singleton();
 
+	streamed_textures.clear();
+
 #ifdef TOOLS_ENABLED
 	TextureStorage::Texture *roughness_detect_texture = nullptr;
 	RS::TextureDetectRoughnessChannel roughness_channel = RS::TEXTURE_DETECT_ROUGHNESS_R;
@@ -916,6 +918,13 @@ void MaterialStorage::MaterialData::update_textures(const HashMap<StringName, Va
 
 				if (tex) {
 					rd_texture = (srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
+					if (tex->streaming_callback) {
+						if (texture_streaming) {
+							streamed_textures.push_back(textures[j]);
+						} else {
+							tex->streaming_full = true;
+						}
+					}
 #ifdef TOOLS_ENABLED
 					if (tex->detect_3d_callback && p_use_linear_color) {
 						tex->detect_3d_callback(tex->detect_3d_callback_ud);
@@ -1100,6 +1109,8 @@ MaterialStorage *MaterialStorage::get_singleton() {
 MaterialStorage::MaterialStorage() {
 	singleton = this;
 
+	shader_compile_async = GLOBAL_GET("rendering/shader_compiler/async_compile/enabled");
+
 	//default samplers
 	for (int i = 1; i < RS::CANVAS_ITEM_TEXTURE_FILTER_MAX; i++) {
 		for (int j = 1; j < RS::CANVAS_ITEM_TEXTURE_REPEAT_MAX; j++) {
@@ -1986,11 +1997,7 @@ RID MaterialStorage::shader_allocate() {
 }
 
 void MaterialStorage::shader_initialize(RID p_rid) {
-	Shader shader;
-	shader.data = nullptr;
-	shader.type = SHADER_TYPE_MAX;
-
-	shader_owner.initialize_rid(p_rid, shader);
+	shader_owner.initialize_rid(p_rid);
 }
 
 void MaterialStorage::shader_free(RID p_rid) {
@@ -2002,6 +2009,11 @@ void MaterialStorage::shader_free(RID p_rid) {
 		material_set_shader((*shader->owners.begin())->self, RID());
 	}
 
+	if (shader->compile_element.in_list()) {
+		shader_compile_list.remove(&shader->compile_element);
+		shader_compile_pending_count--;
+	}
+
 	//clear data if exists
 	if (shader->data) {
 		memdelete(shader->data);
@@ -2059,6 +2071,7 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 			if (shader->data) {
 				material->data = material_get_data_request_function(new_type)(shader->data);
 				material->data->self = material->self;
+				material->data->texture_streaming = new_type == SHADER_TYPE_3D;
 				material->data->set_next_pass(material->next_pass);
 				material->data->set_render_priority(material->priority);
 			}
@@ -2077,6 +2090,11 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
 		shader->data->set_code(p_code);
+
+		if (shader->data->is_compile_pending() && !shader->compile_element.in_list()) {
+			shader_compile_list.add(&shader->compile_element);
+			shader_compile_pending_count++;
+		}
 	}
 
 	for (Material *E : shader->owners) {
@@ -2196,7 +2214,30 @@ void MaterialStorage::_material_queue_update(Material *material, bool p_uniform,
 	material_update_list.add(&material->update_element);
 }
 
+void MaterialStorage::_update_pending_shader_compiles() {
+	SelfList<Shader> *E = shader_compile_list.first();
+	while (E) {
+		SelfList<Shader> *N = E->next();
+		Shader *shader = E->self();
+
+		if (!shader->data || shader->data->poll_compile()) {
+			shader_compile_list.remove(E);
+			shader_compile_pending_count--;
+
+			// Materials were drawn with the fallback material until now.
+			for (Material *material : shader->owners) {
+				material->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_MATERIAL);
+				_material_queue_update(material, true, true);
+			}
+		}
+
+		E = N;
+	}
+}
+
 void MaterialStorage::_update_queued_materials() {
+	_update_pending_shader_compiles();
+
 	while (material_update_list.first()) {
 		Material *material = material_update_list.first()->self();
 		bool uniforms_changed = false;
@@ -2280,6 +2321,7 @@ void MaterialStorage::material_set_shader(RID p_material, RID p_shader) {
 
 	material->data = material_data_request_func[shader->type](shader->data);
 	material->data->self = p_material;
+	material->data->texture_streaming = shader->type == SHADER_TYPE_3D;
 	material->data->set_next_pass(material->next_pass);
 	material->data->set_render_priority(material->priority);
 	//updating happens later
@@ -2398,6 +2440,18 @@ void MaterialStorage::material_update_dependency(RID p_material, DependencyTrack
 	}
 }
 
+void MaterialStorage::material_request_texture_size(RID p_material, uint32_t p_size) {
+	Material *material = material_owner.get_or_null(p_material);
+	if (!material || !material->data) {
+		return;
+	}
+
+	TextureStorage *texture_storage = TextureStorage::get_singleton();
+	for (const RID &E : material->data->streamed_textures) {
+		texture_storage->texture_streaming_request(E, p_size);
+	}
+}
+
 void MaterialStorage::material_set_data_request_function(ShaderType p_shader_type, MaterialStorage::MaterialDataRequestFunction p_function) {
 	ERR_FAIL_INDEX(p_shader_type, SHADER_TYPE_MAX);
 	material_data_request_func[p_shader_type] = p_function;
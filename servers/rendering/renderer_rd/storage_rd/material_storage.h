@@ -72,6 +72,11 @@ public:
 		virtual bool casts_shadows() const = 0;
 		virtual RS::ShaderNativeSourceCode get_native_source_code() const { return RS::ShaderNativeSourceCode(); }
 
+		// Shaders that compile on worker threads return true from is_compile_pending() after set_code().
+		// poll_compile() is then called once per frame until it returns true, which means the shader is usable (or failed).
+		virtual bool is_compile_pending() const { return false; }
+		virtual bool poll_compile() { return true; }
+
 		virtual ~ShaderData() {}
 	};
 
@@ -103,6 +108,8 @@ public:
 		Vector<uint8_t> ubo_data;
 		RID uniform_buffer;
 		Vector<RID> texture_cache;
+		Vector<RID> streamed_textures;
+		bool texture_streaming = false; // Only 3D materials are given a size to stream their textures at.
 	};
 
 private:
@@ -190,9 +197,13 @@ private:
 		ShaderData *data = nullptr;
 		String code;
 		String path_hint;
-		ShaderType type;
+		ShaderType type = SHADER_TYPE_MAX;
 		HashMap<StringName, HashMap<int, RID>> default_texture_parameter;
 		HashSet<Material *> owners;
+		SelfList<Shader> compile_element;
+
+		Shader() :
+				compile_element(this) {}
 	};
 
 	typedef ShaderData *(*ShaderDataRequestFunction)();
@@ -231,6 +242,10 @@ private:
 
 	SelfList<Material>::List material_update_list;
 
+	SelfList<Shader>::List shader_compile_list;
+	uint32_t shader_compile_pending_count = 0;
+	bool shader_compile_async = false;
+
 	static void _material_uniform_set_erased(void *p_material);
 
 public:
@@ -393,6 +408,10 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	void _update_pending_shader_compiles();
+	bool is_shader_compile_async() const { return shader_compile_async; }
+	uint32_t get_pending_shader_compile_count() const { return shader_compile_pending_count; }
+
 	/* MATERIAL API */
 
 	bool owns_material(RID p_rid) { return material_owner.owns(p_rid); };
@@ -419,6 +438,7 @@ public:
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) override;
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) override;
+	virtual void material_request_texture_size(RID p_material, uint32_t p_size) override;
 
 	void material_set_data_request_function(ShaderType p_shader_type, MaterialDataRequestFunction p_function);
 	MaterialDataRequestFunction material_get_data_request_function(ShaderType p_shader_type);
@@ -30,6 +30,7 @@
 
 #include "mesh_storage.h"
 #include "../../rendering_server_globals.h"
+#include "core/config/project_settings.h"
 
 using namespace RendererRD;
 
@@ -42,6 +43,8 @@ MeshStorage *MeshStorage::get_singleton() {
 MeshStorage::MeshStorage() {
 	singleton = this;
 
+	skin_share_poses = GLOBAL_GET("rendering/skinning/share_identical_poses");
+
 	default_rd_storage_buffer = RD::get_singleton()->storage_buffer_create(sizeof(uint32_t) * 4);
 
 	//default rd buffers
@@ -847,6 +850,8 @@ void MeshStorage::mesh_instance_set_blend_shape_weight(RID p_mesh_instance, int
 }
 
 void MeshStorage::_mesh_instance_clear(MeshInstance *mi) {
+	_mesh_instance_unshare_skin(mi);
+
 	for (const RendererRD::MeshStorage::MeshInstance::Surface &surface : mi->surfaces) {
 		if (surface.versions) {
 			for (uint32_t j = 0; j < surface.version_count; j++) {
@@ -869,6 +874,23 @@ void MeshStorage::_mesh_instance_clear(MeshInstance *mi) {
 	mi->skeleton_version = 0;
 }
 
+void MeshStorage::_mesh_instance_unshare_skin(MeshInstance *mi) {
+	if (mi->skin_source) {
+		mi->skin_source->skin_sharers.erase(mi);
+		mi->skin_source = nullptr;
+	}
+
+	// Sharers never wrote their own vertex buffers, so they need skinning again.
+	for (MeshInstance *sharer : mi->skin_sharers) {
+		sharer->skin_source = nullptr;
+		sharer->dirty = true;
+		if (!sharer->array_update_list.in_list()) {
+			dirty_mesh_instance_arrays.add(&sharer->array_update_list);
+		}
+	}
+	mi->skin_sharers.clear();
+}
+
 void MeshStorage::_mesh_instance_add_surface(MeshInstance *mi, Mesh *mesh, uint32_t p_surface) {
 	if (mesh->blend_shape_count > 0 && mi->blend_weights_buffer.is_null()) {
 		mi->blend_weights.resize(mesh->blend_shape_count);
@@ -958,11 +980,44 @@ void MeshStorage::update_mesh_instances() {
 	//process skeletons and blend shapes
 	RD::ComputeListID compute_list = RD::get_singleton()->compute_list_begin();
 
+	skin_pose_sources.clear();
+
 	while (dirty_mesh_instance_arrays.first()) {
 		MeshInstance *mi = dirty_mesh_instance_arrays.first()->self();
 
 		Skeleton *sk = skeleton_owner.get_or_null(mi->skeleton);
 
+		// Whatever was shared belongs to the previous pose.
+		_mesh_instance_unshare_skin(mi);
+
+		if (skin_share_poses && sk && !sk->use_2d) {
+			// Crowds often play the same animation in lockstep, skin each distinct pose only once.
+			uint32_t hash = hash_murmur3_one_64(uint64_t(mi->mesh), sk->pose_hash);
+			if (mi->blend_weights.size()) {
+				hash = hash_murmur3_buffer(mi->blend_weights.ptr(), mi->blend_weights.size() * sizeof(float), hash);
+			}
+
+			MeshInstance **source = skin_pose_sources.getptr(hash);
+			if (source) {
+				MeshInstance *smi = *source;
+				Skeleton *ssk = skeleton_owner.get_or_null(smi->skeleton);
+				bool same_pose = smi->mesh == mi->mesh && ssk && ssk->data.size() == sk->data.size() && smi->blend_weights.size() == mi->blend_weights.size();
+				same_pose = same_pose && memcmp(ssk->data.ptr(), sk->data.ptr(), sk->data.size() * sizeof(float)) == 0;
+				same_pose = same_pose && (mi->blend_weights.is_empty() || memcmp(smi->blend_weights.ptr(), mi->blend_weights.ptr(), mi->blend_weights.size() * sizeof(float)) == 0);
+
+				if (same_pose) {
+					mi->skin_source = smi;
+					smi->skin_sharers.push_back(mi);
+					mi->dirty = false;
+					mi->skeleton_version = sk->version;
+					dirty_mesh_instance_arrays.remove(&mi->array_update_list);
+					continue;
+				}
+			} else {
+				skin_pose_sources.insert(hash, mi);
+			}
+		}
+
 		for (uint32_t i = 0; i < mi->surfaces.size(); i++) {
 			if (mi->surfaces[i].uniform_set == RID() || mi->mesh->surfaces[i]->uniform_set == RID()) {
 				continue;
@@ -2082,6 +2137,10 @@ void MeshStorage::_update_dirty_skeletons() {
 
 		skeleton->dependency.changed_notify(Dependency::DEPENDENCY_CHANGED_SKELETON_BONES);
 
+		if (skin_share_poses) {
+			skeleton->pose_hash = skeleton->data.is_empty() ? 0 : hash_murmur3_buffer(skeleton->data.ptr(), skeleton->data.size() * sizeof(float));
+		}
+
 		skeleton->version++;
 
 		skeleton->dirty = false;
@@ -179,6 +179,11 @@ private:
 		SelfList<MeshInstance> weight_update_list;
 		SelfList<MeshInstance> array_update_list;
 		Transform2D canvas_item_transform_2d;
+
+		// When skinned to the same pose as another instance of the same mesh, render its vertex buffers instead.
+		MeshInstance *skin_source = nullptr;
+		LocalVector<MeshInstance *> skin_sharers;
+
 		MeshInstance() :
 				weight_update_list(this), array_update_list(this) {}
 	};
@@ -187,6 +192,10 @@ private:
 
 	void _mesh_instance_clear(MeshInstance *mi);
 	void _mesh_instance_add_surface(MeshInstance *mi, Mesh *mesh, uint32_t p_surface);
+	void _mesh_instance_unshare_skin(MeshInstance *mi);
+
+	bool skin_share_poses = false;
+	HashMap<uint32_t, MeshInstance *> skin_pose_sources; // Instances skinned during the current update, by pose hash.
 
 	mutable RID_Owner<MeshInstance> mesh_instance_owner;
 
@@ -300,6 +309,7 @@ private:
 		RID uniform_set_mi;
 
 		uint64_t version = 1;
+		uint32_t pose_hash = 0; // Only computed when sharing skinned poses.
 
 		Dependency dependency;
 	};
@@ -426,6 +436,34 @@ public:
 		}
 	}
 
+	// Like mesh_surface_get_lod(), but keeps p_current_lod as long as the screen size stays within
+	// p_hysteresis (relative) of the threshold, so LODs don't flicker around the transition point.
+	_FORCE_INLINE_ uint32_t mesh_surface_get_lod_with_hysteresis(void *p_surface, float p_model_scale, float p_distance_threshold, float p_mesh_lod_threshold, float p_hysteresis, uint32_t p_current_lod, uint32_t &r_index_count) const {
+		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
+
+		// Same as mesh_surface_get_lod() with both thresholds, in a single pass over the LODs.
+		float finest_threshold = p_mesh_lod_threshold * (1.0 - p_hysteresis);
+		float coarsest_threshold = p_mesh_lod_threshold * (1.0 + p_hysteresis);
+		uint32_t finest_lod = 0;
+		uint32_t coarsest_lod = 0;
+		bool finest_found = false;
+		for (uint32_t i = 0; i < s->lod_count; i++) {
+			float screen_size = s->lods[i].edge_length * p_model_scale / p_distance_threshold;
+			if (screen_size > coarsest_threshold) {
+				break;
+			}
+			coarsest_lod = i + 1;
+			finest_found = finest_found || screen_size > finest_threshold;
+			if (!finest_found) {
+				finest_lod = i + 1;
+			}
+		}
+
+		uint32_t lod = CLAMP(p_current_lod, finest_lod, coarsest_lod);
+		r_index_count = lod == 0 ? s->index_count : s->lods[lod - 1].index_count;
+		return lod;
+	}
+
 	_FORCE_INLINE_ RID mesh_surface_get_index_array(void *p_surface, uint32_t p_lod) const {
 		Mesh::Surface *s = reinterpret_cast<Mesh::Surface *>(p_surface);
 
@@ -469,6 +507,9 @@ public:
 	_FORCE_INLINE_ void mesh_instance_surface_get_vertex_arrays_and_format(RID p_mesh_instance, uint32_t p_surface_index, uint32_t p_input_mask, RID &r_vertex_array_rd, RD::VertexFormatID &r_vertex_format) {
 		MeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
 		ERR_FAIL_COND(!mi);
+		if (mi->skin_source) {
+			mi = mi->skin_source;
+		}
 		Mesh *mesh = mi->mesh;
 		ERR_FAIL_UNSIGNED_INDEX(p_surface_index, mesh->surface_count);
 
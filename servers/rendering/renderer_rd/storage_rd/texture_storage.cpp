@@ -32,6 +32,7 @@
 
 #include "../effects/copy_effects.h"
 #include "../framebuffer_cache_rd.h"
+#include "core/config/project_settings.h"
 #include "material_storage.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 
@@ -531,6 +532,9 @@ TextureStorage::TextureStorage() {
 			rt_sdf.pipelines[i] = RD::get_singleton()->compute_pipeline_create(rt_sdf.shader.version_get_shader(rt_sdf.shader_version, i));
 		}
 	}
+
+	streaming_budget = uint64_t(MAX(int(GLOBAL_GET("rendering/textures/streaming/memory_budget_mb")), 1)) * 1024 * 1024;
+	streaming_min_size = MAX(int(GLOBAL_GET("rendering/textures/streaming/min_size")), 1);
 }
 
 TextureStorage::~TextureStorage() {
@@ -690,6 +694,7 @@ bool TextureStorage::canvas_texture_get_uniform_set(RID p_texture, RS::CanvasIte
 			} else {
 				u.append_id(t->rd_texture);
 				ct->size_cache = Size2i(t->width_2d, t->height_2d);
+				t->streaming_full = true;
 				if (t->render_target) {
 					t->render_target->was_used = true;
 				}
@@ -708,6 +713,7 @@ bool TextureStorage::canvas_texture_get_uniform_set(RID p_texture, RS::CanvasIte
 			} else {
 				u.append_id(t->rd_texture);
 				ct->use_normal_cache = true;
+				t->streaming_full = true;
 				if (t->render_target) {
 					t->render_target->was_used = true;
 				}
@@ -726,6 +732,7 @@ bool TextureStorage::canvas_texture_get_uniform_set(RID p_texture, RS::CanvasIte
 			} else {
 				u.append_id(t->rd_texture);
 				ct->use_specular_cache = true;
+				t->streaming_full = true;
 				if (t->render_target) {
 					t->render_target->was_used = true;
 				}
@@ -775,6 +782,7 @@ void TextureStorage::texture_free(RID p_texture) {
 	}
 
 	decal_atlas_remove_texture(p_texture);
+	streaming_textures.erase(p_texture);
 
 	for (int i = 0; i < t->proxies.size(); i++) {
 		Texture *p = texture_owner.get_or_null(t->proxies[i]);
@@ -1361,9 +1369,23 @@ void TextureStorage::texture_replace(RID p_texture, RID p_by_texture) {
 	Vector<RID> proxies_to_update = tex->proxies;
 	Vector<RID> proxies_to_redirect = by_tex->proxies;
 
+	// Streaming state belongs to the texture RID, not to the data replacing it.
+	RS::TextureStreamingCallback streaming_callback = tex->streaming_callback;
+	ObjectID streaming_callback_owner = tex->streaming_callback_owner;
+	Size2i streaming_data_size = tex->streaming_data_size;
+	uint32_t streaming_target_size = tex->streaming_target_size;
+	uint64_t streaming_last_used = tex->streaming_last_used;
+	bool streaming_full = tex->streaming_full;
+
 	*tex = *by_tex;
 
 	tex->proxies = proxies_to_update; //restore proxies, so they can be updated
+	tex->streaming_callback = streaming_callback;
+	tex->streaming_callback_owner = streaming_callback_owner;
+	tex->streaming_data_size = streaming_data_size;
+	tex->streaming_target_size = streaming_target_size;
+	tex->streaming_last_used = streaming_last_used;
+	tex->streaming_full = streaming_full;
 
 	if (tex->canvas_texture) {
 		tex->canvas_texture->diffuse = p_texture; //update
@@ -1428,6 +1450,145 @@ void TextureStorage::texture_set_detect_roughness_callback(RID p_texture, RS::Te
 	tex->detect_roughness_callback = p_callback;
 }
 
+void TextureStorage::texture_set_streaming_callback(RID p_texture, const Size2i &p_data_size, RS::TextureStreamingCallback p_callback, ObjectID p_owner) {
+	Texture *tex = texture_owner.get_or_null(p_texture);
+	ERR_FAIL_COND(!tex);
+	ERR_FAIL_COND(tex->type != TextureStorage::TYPE_2D);
+
+	tex->streaming_callback = p_callback;
+	tex->streaming_callback_owner = p_owner;
+	tex->streaming_data_size = p_data_size;
+	tex->streaming_requested_size = 0;
+	tex->streaming_target_size = 0;
+	tex->streaming_pending_size = 0;
+	tex->streaming_last_used = streaming_frame;
+
+	if (p_callback) {
+		streaming_textures.insert(p_texture);
+	} else {
+		streaming_textures.erase(p_texture);
+	}
+}
+
+void TextureStorage::texture_streaming_request(RID p_texture, uint32_t p_size) {
+	Texture *tex = texture_owner.get_or_null(p_texture);
+	if (!tex || !tex->streaming_callback) {
+		return;
+	}
+
+	tex->streaming_requested_size = MAX(tex->streaming_requested_size, p_size);
+}
+
+uint32_t TextureStorage::_texture_streaming_fit(const Texture *p_texture, uint32_t p_size, uint64_t *r_bytes) const {
+	// Walk down the mip chain of the stored data until the largest side fits,
+	// this matches which mips CompressedTexture2D skips when loading with a size limit.
+	int w = p_texture->streaming_data_size.width;
+	int h = p_texture->streaming_data_size.height;
+	while (uint32_t(MAX(w, h)) > p_size && (w > 1 || h > 1)) {
+		w = MAX(w >> 1, 1);
+		h = MAX(h >> 1, 1);
+	}
+
+	if (r_bytes) {
+		*r_bytes = Image::get_image_data_size(w, h, p_texture->format, true);
+	}
+	return MAX(w, h);
+}
+
+void TextureStorage::update_texture_streaming() {
+	if (streaming_textures.is_empty()) {
+		return;
+	}
+
+	streaming_frame++;
+
+	struct StreamItem {
+		Texture *texture = nullptr;
+		uint32_t min_size = 0;
+		uint32_t size = 0;
+		uint64_t min_bytes = 0;
+
+		bool operator<(const StreamItem &p_item) const {
+			// Recently seen textures first, then the ones wanting the most detail.
+			if (texture->streaming_last_used == p_item.texture->streaming_last_used) {
+				return size > p_item.size;
+			}
+			return texture->streaming_last_used > p_item.texture->streaming_last_used;
+		}
+	};
+
+	LocalVector<StreamItem> items;
+	items.reserve(streaming_textures.size());
+
+	// The lowest mips of every streamed texture always stay resident, they are the baseline of the budget.
+	uint64_t used = 0;
+
+	for (const RID &E : streaming_textures) {
+		Texture *tex = texture_owner.get_or_null(E);
+		if (!tex || !tex->streaming_callback) {
+			continue;
+		}
+
+		StreamItem item;
+		item.texture = tex;
+		// Textures used outside of 3D materials get no size requests, so they are always kept whole.
+		item.min_size = _texture_streaming_fit(tex, tex->streaming_full ? UINT32_MAX : streaming_min_size, &item.min_bytes);
+
+		if (tex->streaming_requested_size > 0) {
+			tex->streaming_target_size = _texture_streaming_fit(tex, next_power_of_2(tex->streaming_requested_size));
+			tex->streaming_last_used = streaming_frame;
+			tex->streaming_requested_size = 0;
+		} else if (streaming_frame - tex->streaming_last_used > TEXTURE_STREAMING_EVICT_FRAMES) {
+			tex->streaming_target_size = item.min_size;
+		}
+
+		item.size = MAX(tex->streaming_target_size, item.min_size);
+		used += item.min_bytes;
+		items.push_back(item);
+	}
+
+	items.sort();
+
+	uint32_t uploads = 0;
+
+	for (StreamItem &item : items) {
+		Texture *tex = item.texture;
+
+		// Hand out the remaining budget by priority, halving what does not fit. Textures that
+		// lose their share here are evicted back to lower mips, which frees room next frame.
+		uint32_t size = item.size;
+		uint64_t bytes = item.min_bytes;
+		while (size > item.min_size) {
+			size = _texture_streaming_fit(tex, size, &bytes);
+			if (used + bytes - item.min_bytes <= streaming_budget) {
+				break;
+			}
+			size >>= 1;
+		}
+		if (size <= item.min_size) {
+			size = item.min_size;
+			bytes = item.min_bytes;
+		}
+		used += bytes - item.min_bytes;
+
+		// Compressed formats stop halving at their block size, so accept anything within the same mip.
+		uint32_t current = tex->streaming_pending_size ? tex->streaming_pending_size : uint32_t(MAX(tex->width, tex->height));
+		if (current <= size && current * 2 > size) {
+			continue;
+		}
+
+		if (size > current) {
+			if (uploads >= TEXTURE_STREAMING_MAX_UPLOADS_PER_FRAME) {
+				continue;
+			}
+			uploads++;
+		}
+
+		tex->streaming_pending_size = size;
+		tex->streaming_callback(tex->streaming_callback_owner, size);
+	}
+}
+
 void TextureStorage::texture_debug_usage(List<RS::TextureInfo> *r_info) {
 }
 
@@ -1448,6 +1609,7 @@ RID TextureStorage::texture_get_rd_texture(RID p_texture, bool p_srgb) const {
 		return RID();
 	}
 
+	tex->streaming_full = true;
 	return (p_srgb && tex->rd_texture_srgb.is_valid()) ? tex->rd_texture_srgb : tex->rd_texture;
 }
 
@@ -2268,6 +2430,11 @@ void TextureStorage::update_decal_atlas() {
 }
 
 void TextureStorage::texture_add_to_decal_atlas(RID p_texture, bool p_panorama_to_dp) {
+	Texture *tex = get_texture(p_texture);
+	if (tex) {
+		tex->streaming_full = true;
+	}
+
 	if (!decal_atlas.textures.has(p_texture)) {
 		DecalAtlas::Texture t;
 		t.users = 1;
@@ -167,6 +167,15 @@ private:
 		RS::TextureDetectRoughnessCallback detect_roughness_callback = nullptr;
 		void *detect_roughness_callback_ud = nullptr;
 
+		RS::TextureStreamingCallback streaming_callback = nullptr;
+		ObjectID streaming_callback_owner;
+		Size2i streaming_data_size;
+		uint32_t streaming_requested_size = 0; // Largest on-screen size reported since the last streaming update.
+		uint32_t streaming_target_size = 0;
+		uint32_t streaming_pending_size = 0; // Size asked from the owner, 0 once it has been replaced.
+		uint64_t streaming_last_used = 0;
+		bool streaming_full = false; // Used by something else than 3D materials, which never ask for a size.
+
 		CanvasTexture *canvas_texture = nullptr;
 
 		void cleanup();
@@ -196,6 +205,20 @@ private:
 	Ref<Image> _validate_texture_format(const Ref<Image> &p_image, TextureToRDFormat &r_format);
 	void _texture_2d_update(RID p_texture, const Ref<Image> &p_image, int p_layer = 0, bool p_immediate = false);
 
+	/* TEXTURE STREAMING */
+
+	enum {
+		TEXTURE_STREAMING_EVICT_FRAMES = 300, // Frames a texture can go unseen before dropping back to its lowest mips.
+		TEXTURE_STREAMING_MAX_UPLOADS_PER_FRAME = 4,
+	};
+
+	HashSet<RID> streaming_textures;
+	uint64_t streaming_frame = 0;
+	uint64_t streaming_budget = 0;
+	uint32_t streaming_min_size = 0;
+
+	uint32_t _texture_streaming_fit(const Texture *p_texture, uint32_t p_size, uint64_t *r_bytes = nullptr) const;
+
 	/* DECAL API */
 
 	struct DecalAtlas {
@@ -494,6 +517,10 @@ public:
 	virtual void texture_set_detect_normal_callback(RID p_texture, RS::TextureDetectCallback p_callback, void *p_userdata) override;
 	virtual void texture_set_detect_roughness_callback(RID p_texture, RS::TextureDetectRoughnessCallback p_callback, void *p_userdata) override;
 
+	virtual void texture_set_streaming_callback(RID p_texture, const Size2i &p_data_size, RS::TextureStreamingCallback p_callback, ObjectID p_owner) override;
+	void texture_streaming_request(RID p_texture, uint32_t p_size);
+	void update_texture_streaming();
+
 	virtual void texture_debug_usage(List<RS::TextureInfo> *r_info) override;
 
 	virtual void texture_set_force_redraw_if_visible(RID p_texture, bool p_enable) override;
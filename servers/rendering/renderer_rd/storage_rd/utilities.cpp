@@ -258,6 +258,7 @@ void Utilities::update_dirty_resources() {
 	MeshStorage::get_singleton()->_update_dirty_multimeshes();
 	MeshStorage::get_singleton()->_update_dirty_skeletons();
 	TextureStorage::get_singleton()->update_decal_atlas();
+	TextureStorage::get_singleton()->update_texture_streaming();
 }
 
 bool Utilities::has_os_feature(const String &p_feature) const {
@@ -306,6 +307,8 @@ uint64_t Utilities::get_rendering_info(RS::RenderingInfo p_info) {
 		return buffer_mem_cache;
 	} else if (p_info == RS::RENDERING_INFO_VIDEO_MEM_USED) {
 		return total_mem_cache;
+	} else if (p_info == RS::RENDERING_INFO_PENDING_SHADER_COMPILATIONS) {
+		return MaterialStorage::get_singleton()->get_pending_shader_compile_count();
 	}
 	return 0;
 }
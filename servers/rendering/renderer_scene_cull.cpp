@@ -892,11 +892,8 @@ void RendererSceneCull::instance_geometry_set_transparency(RID p_instance, float
 	}
 }
 
-void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
-	Instance *instance = instance_owner.get_or_null(p_instance);
-	ERR_FAIL_COND(!instance);
-
-	if (instance->transform == p_transform) {
+void RendererSceneCull::_instance_set_transform(Instance *p_instance, const Transform3D &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -908,8 +905,30 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+void RendererSceneCull::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	int count = p_instances.size();
+
+	for (int i = 0; i < count; i++) {
+		Instance *instance = instance_owner.get_or_null(instances[i]);
+		ERR_CONTINUE(!instance);
+
+		_instance_set_transform(instance, transforms[i]);
+	}
 }
 
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
@@ -1768,7 +1787,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
-			p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			if (batch_indexer_updates) {
+				_queue_geometry_indexer_update(p_instance, bvh_aabb);
+			} else {
+				p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].update(p_instance->indexer_id, bvh_aabb);
+			}
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
@@ -1827,6 +1850,11 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	}
 
+	if (pair.bvh == &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY]) {
+		// Pairing against geometry needs its deferred updates in place.
+		_flush_geometry_indexer_updates(p_instance->scenario);
+	}
+
 	pair.pair();
 
 	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
@@ -1845,6 +1873,9 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	}
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
+		if (p_instance->indexer_update_index != -1) {
+			_flush_geometry_indexer_updates(p_instance->scenario);
+		}
 		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
 	} else {
 		p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].remove(p_instance->indexer_id);
@@ -2909,6 +2940,9 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 					if (keep) {
 						cull_result.geometry_instances.push_back(idata.instance_geometry);
+						if (cull_data.texture_streaming) {
+							cull_result.texture_streaming_instances.push_back(idata.instance);
+						}
 					}
 				}
 			}
@@ -2963,6 +2997,56 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	}
 }
 
+void RendererSceneCull::_request_texture_streaming(const RendererSceneRender::CameraData *p_camera_data, RID p_viewport) {
+	RID render_target = RSG::viewport->viewport_get_render_target(p_viewport);
+	if (render_target.is_null()) {
+		return;
+	}
+	float viewport_width = RSG::texture_storage->render_target_get_size(render_target).width;
+	float lod_multiplier = p_camera_data->main_projection.get_lod_multiplier();
+	bool is_orthogonal = p_camera_data->main_projection.is_orthogonal();
+	float z_near = p_camera_data->main_projection.get_z_near();
+	const Vector3 &camera_position = p_camera_data->main_transform.origin;
+
+	// Estimate how many pixels each visible instance covers and ask for at least that much
+	// texel detail from every texture its materials sample. Same metric as mesh LOD selection.
+	for (uint64_t i = 0; i < scene_cull_result.texture_streaming_instances.size(); i++) {
+		Instance *ins = scene_cull_result.texture_streaming_instances[i];
+
+		float size = ins->transformed_aabb.get_longest_axis_size();
+		float distance = 1.0;
+		if (!is_orthogonal) {
+			distance = MAX(camera_position.distance_to(ins->transformed_aabb.get_center()) - ins->transformed_aabb.size.length() * 0.5, z_near);
+		}
+		uint32_t pixels = uint32_t(MAX(size / (distance * lod_multiplier) * viewport_width, 1.0f));
+
+		if (ins->material_override.is_valid()) {
+			RSG::material_storage->material_request_texture_size(ins->material_override, pixels);
+		}
+		if (ins->material_overlay.is_valid()) {
+			RSG::material_storage->material_request_texture_size(ins->material_overlay, pixels);
+		}
+
+		RID mesh;
+		if (ins->base_type == RS::INSTANCE_MESH) {
+			mesh = ins->base;
+		} else if (ins->base_type == RS::INSTANCE_MULTIMESH) {
+			mesh = RSG::mesh_storage->multimesh_get_mesh(ins->base);
+		}
+		if (mesh.is_null() || ins->material_override.is_valid()) {
+			continue;
+		}
+
+		int surface_count = RSG::mesh_storage->mesh_get_surface_count(mesh);
+		for (int j = 0; j < surface_count; j++) {
+			RID material = j < ins->materials.size() && ins->materials[j].is_valid() ? ins->materials[j] : RSG::mesh_storage->mesh_surface_get_material(mesh, j);
+			if (material.is_valid()) {
+				RSG::material_storage->material_request_texture_size(material, pixels);
+			}
+		}
+	}
+}
+
 void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows, RenderingMethod::RenderInfo *r_render_info) {
 	Instance *render_reflection_probe = instance_owner.get_or_null(p_reflection_probe); //if null, not rendering to it
 
@@ -3096,6 +3180,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+		cull_data.texture_streaming = texture_streaming && p_viewport.is_valid();
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3132,6 +3217,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			}
 			RSG::mesh_storage->update_mesh_instances();
 		}
+
+		if (scene_cull_result.texture_streaming_instances.size()) {
+			_request_texture_streaming(p_camera_data, p_viewport);
+		}
 	}
 
 	//render shadows
@@ -3993,12 +4082,56 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 	p_instance->update_dependencies = false;
 }
 
+void RendererSceneCull::_queue_geometry_indexer_update(Instance *p_instance, const AABB &p_aabb) {
+	Scenario *scenario = p_instance->scenario;
+
+	if (p_instance->indexer_update_index != -1) {
+		scenario->geometry_indexer_update_aabbs[p_instance->indexer_update_index] = p_aabb;
+		return;
+	}
+
+	if (scenario->geometry_indexer_update_instances.is_empty()) {
+		indexer_update_scenarios.push_back(scenario);
+	}
+
+	p_instance->indexer_update_index = scenario->geometry_indexer_update_instances.size();
+	scenario->geometry_indexer_update_instances.push_back(p_instance);
+	scenario->geometry_indexer_update_ids.push_back(p_instance->indexer_id);
+	scenario->geometry_indexer_update_aabbs.push_back(p_aabb);
+}
+
+void RendererSceneCull::_flush_geometry_indexer_updates(Scenario *p_scenario) {
+	if (p_scenario->geometry_indexer_update_instances.is_empty()) {
+		return;
+	}
+
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].update_batch(p_scenario->geometry_indexer_update_ids.ptr(), p_scenario->geometry_indexer_update_aabbs.ptr(), p_scenario->geometry_indexer_update_ids.size());
+
+	for (Instance *instance : p_scenario->geometry_indexer_update_instances) {
+		instance->indexer_update_index = -1;
+	}
+	p_scenario->geometry_indexer_update_instances.clear();
+	p_scenario->geometry_indexer_update_ids.clear();
+	p_scenario->geometry_indexer_update_aabbs.clear();
+}
+
 void RendererSceneCull::update_dirty_instances() {
 	RSG::utilities->update_dirty_resources();
 
+	// Moving geometry only touches its own indexer, so those updates can be batched per scenario
+	// until something needs to query it.
+	batch_indexer_updates = true;
+
 	while (_instance_update_list.first()) {
 		_update_dirty_instance(_instance_update_list.first()->self());
 	}
+
+	batch_indexer_updates = false;
+
+	for (Scenario *scenario : indexer_update_scenarios) {
+		_flush_geometry_indexer_updates(scenario);
+	}
+	indexer_update_scenarios.clear();
 }
 
 void RendererSceneCull::update() {
@@ -4147,6 +4280,7 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	texture_streaming = GLOBAL_GET("rendering/textures/streaming/enabled");
 
 	taa_jitter_array.resize(TAA_JITTER_COUNT);
 	for (int i = 0; i < TAA_JITTER_COUNT; i++) {
@@ -69,6 +69,9 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	// Commands buffered by other threads since the last frame become visible now.
+	command_queue.flush_thread_buffers();
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
@@ -354,6 +357,7 @@ void RenderingServerDefault::_thread_draw(bool p_swap_buffers, double frame_step
 }
 
 void RenderingServerDefault::_thread_flush() {
+	command_queue.flush_thread_buffers();
 }
 
 void RenderingServerDefault::_thread_callback(void *_instance) {
@@ -387,6 +391,7 @@ void RenderingServerDefault::sync() {
 		command_queue.push_and_sync(this, &RenderingServerDefault::_thread_flush);
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
+		command_queue.flush_thread_buffers();
 	}
 }
 
@@ -403,6 +408,7 @@ RenderingServerDefault::RenderingServerDefault(bool p_create_thread) :
 	RenderingServer::init();
 
 	create_thread = p_create_thread;
+	command_queue.set_thread_buffers_enabled(GLOBAL_GET("rendering/driver/threads/thread_command_buffers"));
 
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
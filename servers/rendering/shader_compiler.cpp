@@ -31,7 +31,11 @@
 #include "shader_compiler.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -1438,7 +1442,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1546,9 +1550,392 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	return OK;
 }
 
+static const char *compiler_cache_file_header = "GDSG";
+static const uint32_t compiler_cache_file_version = 1;
+
+String ShaderCompiler::cache_dir;
+SafeNumeric<uint32_t> ShaderCompiler::compiled_count;
+SafeNumeric<uint64_t> ShaderCompiler::compile_usec;
+SafeNumeric<uint32_t> ShaderCompiler::cache_hit_count;
+SafeNumeric<uint64_t> ShaderCompiler::cache_load_usec;
+
+String ShaderCompiler::_get_cache_path(RS::ShaderMode p_mode, const String &p_code) const {
+	StringBuilder hash_build;
+	hash_build.append("[GodotVersionNumber]");
+	hash_build.append(VERSION_NUMBER);
+	hash_build.append("[GodotVersionHash]");
+	hash_build.append(VERSION_HASH);
+	hash_build.append("[CacheVersion]");
+	hash_build.append(itos(compiler_cache_file_version));
+	hash_build.append("[Mode]");
+	hash_build.append(itos(p_mode));
+	hash_build.append("[Actions]");
+	hash_build.append(actions_sha256);
+
+	// Global uniform types are resolved while parsing, so they are part of the key.
+	if (RSG::material_storage) {
+		Vector<StringName> global_names = RSG::material_storage->global_shader_parameter_get_list();
+		Vector<String> globals;
+		for (const StringName &E : global_names) {
+			globals.push_back(String(E) + ":" + itos(RSG::material_storage->global_shader_parameter_get_type(E)));
+		}
+		globals.sort();
+		hash_build.append("[Globals]");
+		for (const String &E : globals) {
+			hash_build.append(E);
+			hash_build.append(";");
+		}
+	}
+
+	hash_build.append("[Code]");
+	hash_build.append(p_code);
+
+	return cache_dir.path_join(hash_build.as_string().sha256_text() + ".cache");
+}
+
+static void _store_string_list(Ref<FileAccess> p_file, const Vector<StringName> &p_list) {
+	p_file->store_32(p_list.size());
+	for (const StringName &E : p_list) {
+		p_file->store_pascal_string(E);
+	}
+}
+
+static Vector<StringName> _get_string_list(Ref<FileAccess> p_file) {
+	Vector<StringName> list;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		list.push_back(p_file->get_pascal_string());
+	}
+	return list;
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_path, const AppliedActions &p_applied, const IdentifierActions *p_actions, const GeneratedCode &p_gen_code) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+
+	f->store_buffer((const uint8_t *)compiler_cache_file_header, 4);
+	f->store_32(compiler_cache_file_version);
+
+	f->store_32(p_gen_code.defines.size());
+	for (const String &E : p_gen_code.defines) {
+		f->store_pascal_string(E);
+	}
+
+	f->store_32(p_gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &E : p_gen_code.texture_uniforms) {
+		f->store_pascal_string(E.name);
+		f->store_32(E.type);
+		f->store_32(E.hint);
+		f->store_8(E.use_color);
+		f->store_32(E.filter);
+		f->store_32(E.repeat);
+		f->store_8(E.global);
+		f->store_32(E.array_size);
+	}
+
+	f->store_32(p_gen_code.uniform_offsets.size());
+	for (uint32_t E : p_gen_code.uniform_offsets) {
+		f->store_32(E);
+	}
+	f->store_32(p_gen_code.uniform_total_size);
+	f->store_pascal_string(p_gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(p_gen_code.stage_globals[i]);
+	}
+
+	f->store_32(p_gen_code.code.size());
+	for (const KeyValue<String, String> &E : p_gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	f->store_8(p_gen_code.uses_global_textures);
+	f->store_8(p_gen_code.uses_fragment_time);
+	f->store_8(p_gen_code.uses_vertex_time);
+	f->store_8(p_gen_code.uses_screen_texture_mipmaps);
+	f->store_8(p_gen_code.uses_screen_texture);
+	f->store_8(p_gen_code.uses_depth_texture);
+	f->store_8(p_gen_code.uses_normal_roughness_texture);
+
+	_store_string_list(f, p_applied.render_modes);
+	_store_string_list(f, p_applied.usage_flags);
+	_store_string_list(f, p_applied.write_flags);
+
+	if (p_actions->uniforms) {
+		f->store_32(p_actions->uniforms->size());
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : *p_actions->uniforms) {
+			const ShaderLanguage::ShaderNode::Uniform &u = E.value;
+			f->store_pascal_string(E.key);
+			f->store_32(u.order);
+			f->store_32(u.texture_order);
+			f->store_32(u.texture_binding);
+			f->store_32(u.type);
+			f->store_32(u.precision);
+			f->store_32(u.array_size);
+			f->store_32(u.default_value.size());
+			for (const ShaderLanguage::ConstantNode::Value &value : u.default_value) {
+				f->store_32(value.uint);
+			}
+			f->store_32(u.scope);
+			f->store_32(u.hint);
+			f->store_8(u.use_color);
+			f->store_32(u.filter);
+			f->store_32(u.repeat);
+			for (int i = 0; i < 3; i++) {
+				f->store_float(u.hint_range[i]);
+			}
+			f->store_32(u.instance_index);
+			f->store_pascal_string(u.group);
+			f->store_pascal_string(u.subgroup);
+		}
+	} else {
+		f->store_32(0);
+	}
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_path, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(compiler_cache_file_header), false);
+
+	if (f->get_32() != compiler_cache_file_version) {
+		return false; // Wrong version.
+	}
+
+	GeneratedCode gen_code;
+
+	uint32_t define_count = f->get_32();
+	for (uint32_t i = 0; i < define_count && !f->eof_reached(); i++) {
+		gen_code.defines.push_back(f->get_pascal_string());
+	}
+
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = ShaderLanguage::DataType(f->get_32());
+		texture.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = ShaderLanguage::TextureFilter(f->get_32());
+		texture.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+		gen_code.texture_uniforms.push_back(texture);
+	}
+
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String key = f->get_pascal_string();
+		gen_code.code[key] = f->get_pascal_string();
+	}
+
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	AppliedActions applied;
+	applied.render_modes = _get_string_list(f);
+	applied.usage_flags = _get_string_list(f);
+	applied.write_flags = _get_string_list(f);
+
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		ShaderLanguage::ShaderNode::Uniform u;
+		u.order = f->get_32();
+		u.texture_order = f->get_32();
+		u.texture_binding = f->get_32();
+		u.type = ShaderLanguage::DataType(f->get_32());
+		u.precision = ShaderLanguage::DataPrecision(f->get_32());
+		u.array_size = f->get_32();
+		uint32_t value_count = f->get_32();
+		for (uint32_t j = 0; j < value_count && !f->eof_reached(); j++) {
+			ShaderLanguage::ConstantNode::Value value;
+			value.uint = f->get_32();
+			u.default_value.push_back(value);
+		}
+		u.scope = ShaderLanguage::ShaderNode::Uniform::Scope(f->get_32());
+		u.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		u.use_color = f->get_8();
+		u.filter = ShaderLanguage::TextureFilter(f->get_32());
+		u.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			u.hint_range[j] = f->get_float();
+		}
+		u.instance_index = f->get_32();
+		u.group = f->get_pascal_string();
+		u.subgroup = f->get_pascal_string();
+		uniforms.insert(name, u);
+	}
+
+	ERR_FAIL_COND_V_MSG(f->eof_reached(), false, "Truncated shader compiler cache file: " + p_path);
+
+	r_gen_code = gen_code;
+	_apply_actions(applied, p_actions);
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+	return true;
+}
+
+void ShaderCompiler::_apply_actions(const AppliedActions &p_applied, IdentifierActions *p_actions) {
+	for (const StringName &E : p_applied.render_modes) {
+		if (p_actions->render_mode_flags.has(E)) {
+			*p_actions->render_mode_flags[E] = true;
+		}
+		if (p_actions->render_mode_values.has(E)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[E];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &E : p_applied.usage_flags) {
+		if (p_actions->usage_flag_pointers.has(E)) {
+			*p_actions->usage_flag_pointers[E] = true;
+		}
+	}
+	for (const StringName &E : p_applied.write_flags) {
+		if (p_actions->write_flag_pointers.has(E)) {
+			*p_actions->write_flag_pointers[E] = true;
+		}
+	}
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+
+	String cache_path;
+	if (!cache_dir.is_empty()) {
+		cache_path = _get_cache_path(p_mode, p_code);
+		if (_load_from_cache(cache_path, p_actions, r_gen_code)) {
+			cache_hit_count.increment();
+			cache_load_usec.add(OS::get_singleton()->get_ticks_usec() - from);
+			return OK;
+		}
+	}
+
+	// Point usage and write flags to local storage, to find out which ones the shader sets.
+	IdentifierActions recording_actions = *p_actions;
+	LocalVector<bool> usage_flags;
+	usage_flags.resize(recording_actions.usage_flag_pointers.size());
+	LocalVector<bool> write_flags;
+	write_flags.resize(recording_actions.write_flag_pointers.size());
+
+	uint32_t index = 0;
+	for (KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		usage_flags[index] = false;
+		E.value = &usage_flags[index++];
+	}
+	index = 0;
+	for (KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		write_flags[index] = false;
+		E.value = &write_flags[index++];
+	}
+
+	Error err = _compile(p_mode, p_code, &recording_actions, p_path, r_gen_code);
+
+	AppliedActions applied;
+	for (const KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		if (*E.value) {
+			applied.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		if (*E.value) {
+			applied.write_flags.push_back(E.key);
+		}
+	}
+	if (err == OK) {
+		for (const StringName &E : shader->render_modes) {
+			if (p_actions->render_mode_flags.has(E) || p_actions->render_mode_values.has(E)) {
+				applied.render_modes.push_back(E);
+			}
+		}
+	}
+	_apply_actions(applied, p_actions);
+
+	if (err != OK) {
+		return err;
+	}
+
+	compiled_count.increment();
+	compile_usec.add(OS::get_singleton()->get_ticks_usec() - from);
+
+	if (!cache_path.is_empty()) {
+		_save_to_cache(cache_path, applied, p_actions, r_gen_code);
+	}
+
+	return OK;
+}
+
+void ShaderCompiler::set_cache_dir(const String &p_dir) {
+	cache_dir = String();
+	if (p_dir.is_empty()) {
+		return;
+	}
+
+	Ref<DirAccess> d = DirAccess::open(p_dir);
+	ERR_FAIL_COND(d.is_null());
+	if (d->change_dir("shader_compiler") != OK) {
+		Error err = d->make_dir("shader_compiler");
+		ERR_FAIL_COND(err != OK);
+	}
+	cache_dir = p_dir.path_join("shader_compiler");
+}
+
+ShaderCompiler::CacheStats ShaderCompiler::get_cache_stats() {
+	CacheStats stats;
+	stats.compiled = compiled_count.get();
+	stats.compile_usec = compile_usec.get();
+	stats.cache_hits = cache_hit_count.get();
+	stats.cache_load_usec = cache_load_usec.get();
+	return stats;
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	{
+		// Everything that changes the generated code besides the shader source.
+		StringBuilder hash_build;
+		const HashMap<StringName, String> *maps[4] = { &p_actions.renames, &p_actions.render_mode_defines, &p_actions.usage_defines, &p_actions.custom_samplers };
+		for (int i = 0; i < 4; i++) {
+			hash_build.append("[Map" + itos(i) + "]");
+			for (const KeyValue<StringName, String> &E : *maps[i]) {
+				hash_build.append(String(E.key));
+				hash_build.append("=");
+				hash_build.append(E.value);
+				hash_build.append(";");
+			}
+		}
+		hash_build.append("[Settings]");
+		hash_build.append(itos(p_actions.default_filter) + "," + itos(p_actions.default_repeat) + "," + itos(p_actions.base_texture_binding_index) + "," + itos(p_actions.texture_layout_set) + "," + itos(p_actions.base_varying_index) + "," + itos(p_actions.apply_luminance_multiplier) + "," + itos(p_actions.check_multiview_samplers));
+		hash_build.append("[Strings]");
+		hash_build.append(p_actions.sampler_array_name + ";" + p_actions.base_uniform_string + ";" + p_actions.global_buffer_array_variable + ";" + p_actions.instance_uniform_index_variable);
+		actions_sha256 = hash_build.as_string().sha256_text();
+	}
+
 	time_name = "TIME";
 
 	List<String> func_list;
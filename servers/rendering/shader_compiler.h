@@ -128,10 +128,43 @@ private:
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	// Identifier actions applied by a compilation, so they can be replayed when loading it from the cache.
+	struct AppliedActions {
+		Vector<StringName> render_modes;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+	};
+
+	static String cache_dir;
+	String actions_sha256;
+
+	static SafeNumeric<uint32_t> compiled_count;
+	static SafeNumeric<uint64_t> compile_usec;
+	static SafeNumeric<uint32_t> cache_hit_count;
+	static SafeNumeric<uint64_t> cache_load_usec;
+
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	String _get_cache_path(RS::ShaderMode p_mode, const String &p_code) const;
+	bool _load_from_cache(const String &p_path, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _save_to_cache(const String &p_path, const AppliedActions &p_applied, const IdentifierActions *p_actions, const GeneratedCode &p_gen_code);
+	static void _apply_actions(const AppliedActions &p_applied, IdentifierActions *p_actions);
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	// Caches generated code on disk, so shaders that did not change skip parsing and code generation.
+	static void set_cache_dir(const String &p_dir);
+
+	struct CacheStats {
+		uint32_t compiled = 0;
+		uint64_t compile_usec = 0;
+		uint32_t cache_hits = 0;
+		uint64_t cache_load_usec = 0;
+	};
+	static CacheStats get_cache_stats();
+
 	ShaderCompiler();
 };
 
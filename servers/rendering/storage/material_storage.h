@@ -97,6 +97,7 @@ public:
 	virtual void material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) = 0;
 
 	virtual void material_update_dependency(RID p_material, DependencyTracker *p_instance) = 0;
+	virtual void material_request_texture_size(RID p_material, uint32_t p_size) = 0;
 };
 
 #endif // MATERIAL_STORAGE_H
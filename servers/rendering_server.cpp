@@ -112,6 +112,35 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms) {
+	ERR_FAIL_COND_MSG(p_transforms.size() != p_instances.size() * 12, "The transforms array must contain 12 floats per instance.");
+
+	Vector<RID> instances;
+	Vector<Transform3D> transforms;
+	instances.resize(p_instances.size());
+	transforms.resize(p_instances.size());
+
+	RID *instances_ptr = instances.ptrw();
+	Transform3D *transforms_ptr = transforms.ptrw();
+	const float *src = p_transforms.ptr();
+
+	// Same layout as 3D transforms in MultiMesh buffers.
+	for (int i = 0; i < p_instances.size(); i++) {
+		instances_ptr[i] = p_instances[i];
+
+		Transform3D &t = transforms_ptr[i];
+		const float *f = &src[i * 12];
+		t.basis.rows[0] = Vector3(f[0], f[1], f[2]);
+		t.origin.x = f[3];
+		t.basis.rows[1] = Vector3(f[4], f[5], f[6]);
+		t.origin.y = f[7];
+		t.basis.rows[2] = Vector3(f[8], f[9], f[10]);
+		t.origin.z = f[11];
+	}
+
+	instances_set_transforms(instances, transforms);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -2494,6 +2523,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
 	ClassDB::bind_method(D_METHOD("instance_set_pivot_data", "instance", "sorting_offset", "use_aabb_center"), &RenderingServer::instance_set_pivot_data);
 	ClassDB::bind_method(D_METHOD("instance_set_transform", "instance", "transform"), &RenderingServer::instance_set_transform);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
 	ClassDB::bind_method(D_METHOD("instance_attach_object_instance_id", "instance", "id"), &RenderingServer::instance_attach_object_instance_id);
 	ClassDB::bind_method(D_METHOD("instance_set_blend_shape_weight", "instance", "shape", "weight"), &RenderingServer::instance_set_blend_shape_weight);
 	ClassDB::bind_method(D_METHOD("instance_set_surface_override_material", "instance", "surface", "material"), &RenderingServer::instance_set_surface_override_material);
@@ -2797,6 +2827,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_PENDING_SHADER_COMPILATIONS);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2900,6 +2931,10 @@ void RenderingServer::init() {
 	// Number of commands that can be drawn per frame.
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
 
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "rendering/rendering_device/pipeline_manifest/path", PROPERTY_HINT_FILE, "*.gdpm"), "");
+	GLOBAL_DEF("rendering/rendering_device/pipeline_manifest/record", false);
+
+	GLOBAL_DEF_RST("rendering/shader_compiler/async_compile/enabled", false);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/compress", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/use_zstd_compression", true);
@@ -2920,11 +2955,15 @@ void RenderingServer::init() {
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/global_illumination/voxel_gi/quality", PROPERTY_HINT_ENUM, "Low (4 Cones - Fast),High (6 Cones - Slow)"), 0);
 
+	GLOBAL_DEF_RST("rendering/skinning/share_identical_poses", false);
+
 	GLOBAL_DEF("rendering/shading/overrides/force_vertex_shading", false);
 	GLOBAL_DEF("rendering/shading/overrides/force_vertex_shading.mobile", true);
 	GLOBAL_DEF("rendering/shading/overrides/force_lambert_over_burley", false);
 	GLOBAL_DEF("rendering/shading/overrides/force_lambert_over_burley.mobile", true);
 
+	GLOBAL_DEF_RST("rendering/driver/threads/thread_command_buffers", true);
+
 	GLOBAL_DEF("rendering/driver/depth_prepass/enable", true);
 	GLOBAL_DEF("rendering/driver/depth_prepass/disable_for_vendors", "PowerVR,Mali,Adreno,Apple");
 
@@ -2959,9 +2998,15 @@ void RenderingServer::init() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/textures/default_filters/texture_mipmap_bias", PROPERTY_HINT_RANGE, "-2,2,0.001"), 0.0f);
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/decals/filter", PROPERTY_HINT_ENUM, "Nearest (Fast),Linear (Fast),Nearest Mipmap (Fast),Linear Mipmap (Fast),Nearest Mipmap Anisotropic (Average),Linear Mipmap Anisotropic (Average)"), DECAL_FILTER_LINEAR_MIPMAPS);
+	GLOBAL_DEF_RST("rendering/textures/streaming/enabled", false);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/textures/streaming/memory_budget_mb", PROPERTY_HINT_RANGE, "16,16384,1,or_greater,suffix:MiB"), 512);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/textures/streaming/min_size", PROPERTY_HINT_RANGE, "4,2048,1,or_greater,suffix:px"), 128);
+
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/textures/light_projectors/filter", PROPERTY_HINT_ENUM, "Nearest (Fast),Linear (Fast),Nearest Mipmap (Fast),Linear Mipmap (Fast),Nearest Mipmap Anisotropic (Average),Linear Mipmap Anisotropic (Average)"), LIGHT_PROJECTOR_FILTER_LINEAR_MIPMAPS);
 
 	GLOBAL_DEF_RST("rendering/occlusion_culling/occlusion_rays_per_thread", 512);
+	GLOBAL_DEF_RST("rendering/occlusion_culling/temporal_reuse", true);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/occlusion_culling/temporal_reuse_max_frames", PROPERTY_HINT_RANGE, "0,240,1"), 0);
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/environment/glow/upscale_mode", PROPERTY_HINT_ENUM, "Linear (Fast),Bicubic (Slow)"), 1);
 	GLOBAL_DEF("rendering/environment/glow/upscale_mode.mobile", 0);
@@ -2988,6 +3033,9 @@ void RenderingServer::init() {
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 1000);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/forward_renderer/threaded_render_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 500);
 
+	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "rendering/mesh_lod/lod_change/cache_camera_threshold", PROPERTY_HINT_RANGE, "0,10,0.001,or_greater,suffix:m"), 0.05);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::FLOAT, "rendering/mesh_lod/lod_change/hysteresis", PROPERTY_HINT_RANGE, "0,0.5,0.01"), 0.1);
+
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"), 512);
 
 	// OpenGL limits
@@ -143,6 +143,13 @@ public:
 	typedef void (*TextureDetectRoughnessCallback)(void *, const String &, TextureDetectRoughnessChannel);
 	virtual void texture_set_detect_roughness_callback(RID p_texture, TextureDetectRoughnessCallback p_callback, void *p_userdata) = 0;
 
+	// Called by the renderer when a streamed texture should be reloaded so its largest side is at most p_size.
+	// p_data_size is the size of the largest mip that can be streamed in, which may differ from the size override.
+	// The owner is passed as an ObjectID, as it may be freed while a request is on its way.
+	typedef void (*TextureStreamingCallback)(ObjectID p_owner, int p_size);
+
+	virtual void texture_set_streaming_callback(RID p_texture, const Size2i &p_data_size, TextureStreamingCallback p_callback, ObjectID p_owner) = 0;
+
 	struct TextureInfo {
 		RID texture;
 		uint32_t width;
@@ -1222,6 +1229,7 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask) = 0;
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center) = 0;
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform) = 0;
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) = 0;
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id) = 0;
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight) = 0;
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material) = 0;
@@ -1244,6 +1252,7 @@ public:
 	PackedInt64Array _instances_cull_aabb_bind(const AABB &p_aabb, RID p_scenario = RID()) const;
 	PackedInt64Array _instances_cull_ray_bind(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const;
 	PackedInt64Array _instances_cull_convex_bind(const TypedArray<Plane> &p_convex, RID p_scenario = RID()) const;
+	void _instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms);
 
 	enum InstanceFlags {
 		INSTANCE_FLAG_USE_BAKED_LIGHT,
@@ -1533,6 +1542,7 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_PENDING_SHADER_COMPILATIONS,
 		RENDERING_INFO_MAX
 	};
 
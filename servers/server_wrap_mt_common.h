@@ -75,25 +75,25 @@
 		}                                                                       \
 	}
 
-#define FUNC0(m_type)                                             \
-	virtual void m_type() override {                              \
-		WRITE_ACTION                                              \
-		if (Thread::get_caller_id() != server_thread) {           \
-			command_queue.push(server_name, &ServerName::m_type); \
-		} else {                                                  \
-			command_queue.flush_if_pending();                     \
-			server_name->m_type();                                \
-		}                                                         \
-	}
-
-#define FUNC0C(m_type)                                            \
-	virtual void m_type() const override {                        \
-		if (Thread::get_caller_id() != server_thread) {           \
-			command_queue.push(server_name, &ServerName::m_type); \
-		} else {                                                  \
-			command_queue.flush_if_pending();                     \
-			server_name->m_type();                                \
-		}                                                         \
+#define FUNC0(m_type)                                                      \
+	virtual void m_type() override {                                       \
+		WRITE_ACTION                                                       \
+		if (Thread::get_caller_id() != server_thread) {                    \
+			command_queue.push_buffered(server_name, &ServerName::m_type); \
+		} else {                                                           \
+			command_queue.flush_if_pending();                              \
+			server_name->m_type();                                         \
+		}                                                                  \
+	}
+
+#define FUNC0C(m_type)                                                     \
+	virtual void m_type() const override {                                 \
+		if (Thread::get_caller_id() != server_thread) {                    \
+			command_queue.push_buffered(server_name, &ServerName::m_type); \
+		} else {                                                           \
+			command_queue.flush_if_pending();                              \
+			server_name->m_type();                                         \
+		}                                                                  \
 	}
 
 #define FUNC0S(m_type)                                                     \
@@ -171,25 +171,25 @@
 		}                                                                      \
 	}
 
-#define FUNC1(m_type, m_arg1)                                         \
-	virtual void m_type(m_arg1 p1) override {                         \
-		WRITE_ACTION                                                  \
-		if (Thread::get_caller_id() != server_thread) {               \
-			command_queue.push(server_name, &ServerName::m_type, p1); \
-		} else {                                                      \
-			command_queue.flush_if_pending();                         \
-			server_name->m_type(p1);                                  \
-		}                                                             \
+#define FUNC1(m_type, m_arg1)                                                  \
+	virtual void m_type(m_arg1 p1) override {                                  \
+		WRITE_ACTION                                                           \
+		if (Thread::get_caller_id() != server_thread) {                        \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1); \
+		} else {                                                               \
+			command_queue.flush_if_pending();                                  \
+			server_name->m_type(p1);                                           \
+		}                                                                      \
 	}
 
-#define FUNC1C(m_type, m_arg1)                                        \
-	virtual void m_type(m_arg1 p1) const override {                   \
-		if (Thread::get_caller_id() != server_thread) {               \
-			command_queue.push(server_name, &ServerName::m_type, p1); \
-		} else {                                                      \
-			command_queue.flush_if_pending();                         \
-			server_name->m_type(p1);                                  \
-		}                                                             \
+#define FUNC1C(m_type, m_arg1)                                                 \
+	virtual void m_type(m_arg1 p1) const override {                            \
+		if (Thread::get_caller_id() != server_thread) {                        \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1); \
+		} else {                                                               \
+			command_queue.flush_if_pending();                                  \
+			server_name->m_type(p1);                                           \
+		}                                                                      \
 	}
 
 #define FUNC2R(m_r, m_type, m_arg1, m_arg2)                                             \
@@ -242,25 +242,25 @@
 		}                                                                          \
 	}
 
-#define FUNC2(m_type, m_arg1, m_arg2)                                     \
-	virtual void m_type(m_arg1 p1, m_arg2 p2) override {                  \
-		WRITE_ACTION                                                      \
-		if (Thread::get_caller_id() != server_thread) {                   \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2); \
-		} else {                                                          \
-			command_queue.flush_if_pending();                             \
-			server_name->m_type(p1, p2);                                  \
-		}                                                                 \
+#define FUNC2(m_type, m_arg1, m_arg2)                                              \
+	virtual void m_type(m_arg1 p1, m_arg2 p2) override {                           \
+		WRITE_ACTION                                                               \
+		if (Thread::get_caller_id() != server_thread) {                            \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2); \
+		} else {                                                                   \
+			command_queue.flush_if_pending();                                      \
+			server_name->m_type(p1, p2);                                           \
+		}                                                                          \
 	}
 
-#define FUNC2C(m_type, m_arg1, m_arg2)                                    \
-	virtual void m_type(m_arg1 p1, m_arg2 p2) const override {            \
-		if (Thread::get_caller_id() != server_thread) {                   \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2); \
-		} else {                                                          \
-			command_queue.flush_if_pending();                             \
-			server_name->m_type(p1, p2);                                  \
-		}                                                                 \
+#define FUNC2C(m_type, m_arg1, m_arg2)                                             \
+	virtual void m_type(m_arg1 p1, m_arg2 p2) const override {                     \
+		if (Thread::get_caller_id() != server_thread) {                            \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2); \
+		} else {                                                                   \
+			command_queue.flush_if_pending();                                      \
+			server_name->m_type(p1, p2);                                           \
+		}                                                                          \
 	}
 
 #define FUNC3R(m_r, m_type, m_arg1, m_arg2, m_arg3)                                         \
@@ -313,25 +313,25 @@
 		}                                                                              \
 	}
 
-#define FUNC3(m_type, m_arg1, m_arg2, m_arg3)                                 \
-	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {           \
-		WRITE_ACTION                                                          \
-		if (Thread::get_caller_id() != server_thread) {                       \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3); \
-		} else {                                                              \
-			command_queue.flush_if_pending();                                 \
-			server_name->m_type(p1, p2, p3);                                  \
-		}                                                                     \
+#define FUNC3(m_type, m_arg1, m_arg2, m_arg3)                                          \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) override {                    \
+		WRITE_ACTION                                                                   \
+		if (Thread::get_caller_id() != server_thread) {                                \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3); \
+		} else {                                                                       \
+			command_queue.flush_if_pending();                                          \
+			server_name->m_type(p1, p2, p3);                                           \
+		}                                                                              \
 	}
 
-#define FUNC3C(m_type, m_arg1, m_arg2, m_arg3)                                \
-	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) const override {     \
-		if (Thread::get_caller_id() != server_thread) {                       \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3); \
-		} else {                                                              \
-			command_queue.flush_if_pending();                                 \
-			server_name->m_type(p1, p2, p3);                                  \
-		}                                                                     \
+#define FUNC3C(m_type, m_arg1, m_arg2, m_arg3)                                         \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3) const override {              \
+		if (Thread::get_caller_id() != server_thread) {                                \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3); \
+		} else {                                                                       \
+			command_queue.flush_if_pending();                                          \
+			server_name->m_type(p1, p2, p3);                                           \
+		}                                                                              \
 	}
 
 #define FUNC4R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                     \
@@ -384,25 +384,25 @@
 		}                                                                                  \
 	}
 
-#define FUNC4(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                             \
-	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) override {    \
-		WRITE_ACTION                                                              \
-		if (Thread::get_caller_id() != server_thread) {                           \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4); \
-		} else {                                                                  \
-			command_queue.flush_if_pending();                                     \
-			server_name->m_type(p1, p2, p3, p4);                                  \
-		}                                                                         \
+#define FUNC4(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                      \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) override {             \
+		WRITE_ACTION                                                                       \
+		if (Thread::get_caller_id() != server_thread) {                                    \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4); \
+		} else {                                                                           \
+			command_queue.flush_if_pending();                                              \
+			server_name->m_type(p1, p2, p3, p4);                                           \
+		}                                                                                  \
 	}
 
-#define FUNC4C(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                               \
-	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) const override { \
-		if (Thread::get_caller_id() != server_thread) {                              \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4);    \
-		} else {                                                                     \
-			command_queue.flush_if_pending();                                        \
-			server_name->m_type(p1, p2, p3, p4);                                     \
-		}                                                                            \
+#define FUNC4C(m_type, m_arg1, m_arg2, m_arg3, m_arg4)                                     \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4) const override {       \
+		if (Thread::get_caller_id() != server_thread) {                                    \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4); \
+		} else {                                                                           \
+			command_queue.flush_if_pending();                                              \
+			server_name->m_type(p1, p2, p3, p4);                                           \
+		}                                                                                  \
 	}
 
 #define FUNC5R(m_r, m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                 \
@@ -455,21 +455,21 @@
 		}                                                                                       \
 	}
 
-#define FUNC5(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                             \
-	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) override { \
-		WRITE_ACTION                                                                      \
-		if (Thread::get_caller_id() != server_thread) {                                   \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);     \
-		} else {                                                                          \
-			command_queue.flush_if_pending();                                             \
-			server_name->m_type(p1, p2, p3, p4, p5);                                      \
-		}                                                                                 \
+#define FUNC5(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                  \
+	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) override {      \
+		WRITE_ACTION                                                                           \
+		if (Thread::get_caller_id() != server_thread) {                                        \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5); \
+		} else {                                                                               \
+			command_queue.flush_if_pending();                                                  \
+			server_name->m_type(p1, p2, p3, p4, p5);                                           \
+		}                                                                                      \
 	}
 
 #define FUNC5C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5)                                  \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5) const override { \
 		if (Thread::get_caller_id() != server_thread) {                                         \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);           \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5);  \
 		} else {                                                                                \
 			command_queue.flush_if_pending();                                                   \
 			server_name->m_type(p1, p2, p3, p4, p5);                                            \
@@ -530,7 +530,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) override { \
 		WRITE_ACTION                                                                                 \
 		if (Thread::get_caller_id() != server_thread) {                                              \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);            \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);   \
 		} else {                                                                                     \
 			command_queue.flush_if_pending();                                                        \
 			server_name->m_type(p1, p2, p3, p4, p5, p6);                                             \
@@ -540,7 +540,7 @@
 #define FUNC6C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6)                                     \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6) const override { \
 		if (Thread::get_caller_id() != server_thread) {                                                    \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);                  \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6);         \
 		} else {                                                                                           \
 			command_queue.flush_if_pending();                                                              \
 			server_name->m_type(p1, p2, p3, p4, p5, p6);                                                   \
@@ -601,7 +601,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) override { \
 		WRITE_ACTION                                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                                         \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                   \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);          \
 		} else {                                                                                                \
 			command_queue.flush_if_pending();                                                                   \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7);                                                    \
@@ -611,7 +611,7 @@
 #define FUNC7C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7)                                        \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7) const override { \
 		if (Thread::get_caller_id() != server_thread) {                                                               \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                         \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7);                \
 		} else {                                                                                                      \
 			command_queue.flush_if_pending();                                                                         \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7);                                                          \
@@ -672,7 +672,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) override { \
 		WRITE_ACTION                                                                                                       \
 		if (Thread::get_caller_id() != server_thread) {                                                                    \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                          \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                 \
 		} else {                                                                                                           \
 			command_queue.flush_if_pending();                                                                              \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8);                                                           \
@@ -682,7 +682,7 @@
 #define FUNC8C(m_type, m_arg1, m_arg2, m_arg3, m_arg4, m_arg5, m_arg6, m_arg7, m_arg8)                                           \
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8) const override { \
 		if (Thread::get_caller_id() != server_thread) {                                                                          \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                                \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8);                       \
 		} else {                                                                                                                 \
 			command_queue.flush_if_pending();                                                                                    \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8);                                                                 \
@@ -693,7 +693,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9) override { \
 		WRITE_ACTION                                                                                                                  \
 		if (Thread::get_caller_id() != server_thread) {                                                                               \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9);                                 \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9);                        \
 		} else {                                                                                                                      \
 			command_queue.flush_if_pending();                                                                                         \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9);                                                                  \
@@ -704,7 +704,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10) override { \
 		WRITE_ACTION                                                                                                                               \
 		if (Thread::get_caller_id() != server_thread) {                                                                                            \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);                                         \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);                                \
 		} else {                                                                                                                                   \
 			command_queue.flush_if_pending();                                                                                                      \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);                                                                          \
@@ -715,7 +715,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11) override { \
 		WRITE_ACTION                                                                                                                                            \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                         \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);                                                 \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);                                        \
 		} else {                                                                                                                                                \
 			command_queue.flush_if_pending();                                                                                                                   \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);                                                                                  \
@@ -726,7 +726,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12) override { \
 		WRITE_ACTION                                                                                                                                                         \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                      \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);                                                         \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);                                                \
 		} else {                                                                                                                                                             \
 			command_queue.flush_if_pending();                                                                                                                                \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);                                                                                          \
@@ -737,7 +737,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13) override { \
 		WRITE_ACTION                                                                                                                                                                      \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                   \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);                                                                 \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);                                                        \
 		} else {                                                                                                                                                                          \
 			command_queue.flush_if_pending();                                                                                                                                             \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);                                                                                                  \
@@ -748,7 +748,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13, m_arg14 p14) override { \
 		WRITE_ACTION                                                                                                                                                                                   \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                                \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);                                                                         \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);                                                                \
 		} else {                                                                                                                                                                                       \
 			command_queue.flush_if_pending();                                                                                                                                                          \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);                                                                                                          \
@@ -759,7 +759,7 @@
 	virtual void m_type(m_arg1 p1, m_arg2 p2, m_arg3 p3, m_arg4 p4, m_arg5 p5, m_arg6 p6, m_arg7 p7, m_arg8 p8, m_arg9 p9, m_arg10 p10, m_arg11 p11, m_arg12 p12, m_arg13 p13, m_arg14 p14, m_arg15 p15) override { \
 		WRITE_ACTION                                                                                                                                                                                                \
 		if (Thread::get_caller_id() != server_thread) {                                                                                                                                                             \
-			command_queue.push(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);                                                                                 \
+			command_queue.push_buffered(server_name, &ServerName::m_type, p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);                                                                        \
 		} else {                                                                                                                                                                                                    \
 			command_queue.flush_if_pending();                                                                                                                                                                       \
 			server_name->m_type(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);                                                                                                                  \
@@ -107,6 +107,33 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory mapped read") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("testdata.csv"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	Vector<uint8_t> expected = f->get_buffer(f->get_length());
+
+	Ref<FileAccess> f_mapped = FileAccess::open_mapped(TestUtils::get_data_path("testdata.csv"));
+	REQUIRE(!f_mapped.is_null());
+	CHECK(f_mapped->get_length() == uint64_t(expected.size()));
+
+	// Platforms without mapping support fall back to regular reads.
+	const uint8_t *mapped_data = f_mapped->get_mapped_data();
+	if (mapped_data) {
+		CHECK(memcmp(mapped_data, expected.ptr(), expected.size()) == 0);
+	}
+
+	CHECK(f_mapped->get_buffer(expected.size()) == expected);
+	CHECK(!f_mapped->eof_reached());
+	CHECK(f_mapped->get_8() == 0);
+	CHECK(f_mapped->eof_reached());
+
+	f_mapped->seek(3);
+	CHECK(f_mapped->get_position() == 3);
+	CHECK(f_mapped->get_8() == expected[3]);
+	f_mapped->seek_end(-1);
+	CHECK(f_mapped->get_8() == expected[expected.size() - 1]);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  test_file_access_compressed.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FILE_ACCESS_COMPRESSED_H
+#define TEST_FILE_ACCESS_COMPRESSED_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFileAccessCompressed {
+
+static const uint32_t BLOCK_SIZE = 4096;
+static const int BLOCK_COUNT = 24;
+
+static Vector<uint8_t> create_data() {
+	// A partial block at the end.
+	Vector<uint8_t> data;
+	data.resize(BLOCK_SIZE * BLOCK_COUNT + 1000);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < data.size(); i++) {
+		w[i] = uint8_t((i / 7) * 31 + (i >> 12));
+	}
+	return data;
+}
+
+// Writes p_data compressed, with the first bytes of block p_corrupt_block zeroed if it's not negative.
+static String write_compressed(const Vector<uint8_t> &p_data, Compression::Mode p_mode, int p_corrupt_block = -1) {
+	const String path = OS::get_singleton()->get_cache_path().path_join("file_access_compressed_test.bin");
+	Vector<uint8_t> compressed = FileAccessCompressed::compress_buffer(p_data.ptr(), p_data.size(), "GCPF", p_mode, BLOCK_SIZE);
+	REQUIRE(!compressed.is_empty());
+
+	if (p_corrupt_block >= 0) {
+		// Header, then the compressed size of every block, then the blocks.
+		uint32_t block_count = p_data.size() / BLOCK_SIZE + 1;
+		uint64_t offset = 16 + block_count * 4;
+		for (int i = 0; i < p_corrupt_block; i++) {
+			offset += decode_uint32(compressed.ptr() + 16 + i * 4);
+		}
+		memset(compressed.ptrw() + offset, 0, 4);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_buffer(compressed.ptr(), compressed.size());
+	return path;
+}
+
+static Ref<FileAccessCompressed> open_compressed(const String &p_path, Compression::Mode p_mode, uint32_t p_readahead_blocks) {
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPF", p_mode, BLOCK_SIZE);
+	fac->set_read_cache(4, p_readahead_blocks);
+	CHECK(fac->open_internal(p_path, FileAccess::READ) == OK);
+	return fac;
+}
+
+// Reads p_length bytes from the current position, in chunks that don't line up with blocks.
+static Vector<uint8_t> read_chunked(const Ref<FileAccessCompressed> &p_fac, uint64_t p_length) {
+	Vector<uint8_t> read;
+	read.resize(p_length);
+	uint64_t total = 0;
+	while (total < p_length) {
+		uint64_t got = p_fac->get_buffer(read.ptrw() + total, MIN(uint64_t(1000), p_length - total));
+		if (got == 0 || got == uint64_t(-1)) {
+			break;
+		}
+		total += got;
+	}
+	read.resize(total);
+	return read;
+}
+
+TEST_CASE("[FileAccessCompressed] Readahead reads the same data") {
+	const Vector<uint8_t> data = create_data();
+	const Compression::Mode modes[] = { Compression::MODE_ZSTD, Compression::MODE_DEFLATE };
+
+	for (Compression::Mode mode : modes) {
+		const String path = write_compressed(data, mode);
+
+		for (uint32_t readahead : { 0, 3 }) {
+			Ref<FileAccessCompressed> fac = open_compressed(path, mode, readahead);
+			CHECK(fac->get_length() == uint64_t(data.size()));
+			CHECK_MESSAGE(read_chunked(fac, data.size()) == data, vformat("Sequential read differs with mode %d and readahead %d.", int(mode), readahead));
+			CHECK(fac->eof_reached() == false);
+			uint8_t byte = 0;
+			CHECK(fac->get_buffer(&byte, 1) == 0);
+			CHECK(fac->eof_reached());
+		}
+
+		DirAccess::remove_absolute(path);
+	}
+}
+
+TEST_CASE("[FileAccessCompressed] Seeking back while reading ahead") {
+	const Vector<uint8_t> data = create_data();
+	const Compression::Mode modes[] = { Compression::MODE_ZSTD, Compression::MODE_DEFLATE };
+
+	for (Compression::Mode mode : modes) {
+		const String path = write_compressed(data, mode);
+		Ref<FileAccessCompressed> fac = open_compressed(path, mode, 3);
+
+		// Read ahead well past the start, so the first blocks leave the cache.
+		const uint64_t middle = BLOCK_SIZE * 12 + 100;
+		CHECK(read_chunked(fac, middle) == data.slice(0, middle));
+
+		// Back to a block that was evicted, then to one that may still be cached.
+		const uint64_t positions[] = { BLOCK_SIZE * 2 + 17, BLOCK_SIZE * 11 + 5, BLOCK_SIZE * 20 };
+		for (uint64_t position : positions) {
+			fac->seek(position);
+			CHECK(fac->get_position() == position);
+			CHECK_MESSAGE(read_chunked(fac, BLOCK_SIZE * 3) == data.slice(position, position + BLOCK_SIZE * 3), vformat("Read after seeking to %d differs with mode %d.", position, int(mode)));
+		}
+
+		// Reading on to the end after seeking back.
+		fac->seek(BLOCK_SIZE * 4 + 1);
+		CHECK(read_chunked(fac, data.size()) == data.slice(BLOCK_SIZE * 4 + 1));
+
+		fac.unref();
+		DirAccess::remove_absolute(path);
+	}
+}
+
+TEST_CASE("[FileAccessCompressed] Corrupt block fails with and without readahead") {
+	const Vector<uint8_t> data = create_data();
+	const Compression::Mode modes[] = { Compression::MODE_ZSTD, Compression::MODE_DEFLATE };
+	const int corrupt_block = 6;
+
+	for (Compression::Mode mode : modes) {
+		const String path = write_compressed(data, mode, corrupt_block);
+
+		for (uint32_t readahead : { 0, 3 }) {
+			Ref<FileAccessCompressed> fac = open_compressed(path, mode, readahead);
+
+			ERR_PRINT_OFF;
+			Vector<uint8_t> read = read_chunked(fac, data.size());
+			ERR_PRINT_ON;
+
+			// Everything before the corrupt block is read, and nothing from it on.
+			CHECK_MESSAGE(read.size() <= int64_t(BLOCK_SIZE * corrupt_block), vformat("Read past the corrupt block with mode %d and readahead %d.", int(mode), readahead));
+			CHECK(read.size() >= int64_t(BLOCK_SIZE * corrupt_block - 1000));
+			CHECK(read == data.slice(0, read.size()));
+
+			// Blocks after it can still be read by seeking past it.
+			fac->seek(BLOCK_SIZE * (corrupt_block + 1));
+			CHECK(read_chunked(fac, BLOCK_SIZE) == data.slice(BLOCK_SIZE * (corrupt_block + 1), BLOCK_SIZE * (corrupt_block + 2)));
+		}
+
+		DirAccess::remove_absolute(path);
+	}
+}
+
+} // namespace TestFileAccessCompressed
+
+#endif // TEST_FILE_ACCESS_COMPRESSED_H
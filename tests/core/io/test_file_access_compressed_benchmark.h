@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_file_access_compressed_benchmark.h                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FILE_ACCESS_COMPRESSED_BENCHMARK_H
+#define TEST_FILE_ACCESS_COMPRESSED_BENCHMARK_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFileAccessCompressedBenchmark {
+
+static const int DATA_SIZE = 16 * 1024 * 1024;
+static const int READ_CHUNK_SIZE = 4096;
+
+// Repeated runs of random bytes, which compresses about as well as typical resource data.
+static Vector<uint8_t> create_data() {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	Vector<uint8_t> data;
+	data.resize(DATA_SIZE);
+	uint8_t *w = data.ptrw();
+	int i = 0;
+	while (i < DATA_SIZE) {
+		uint8_t value = rng->randi() & 0xFF;
+		int run = MIN(int(rng->randi_range(1, 8)), DATA_SIZE - i);
+		for (int j = 0; j < run; j++) {
+			w[i++] = value;
+		}
+	}
+	return data;
+}
+
+static void benchmark_read(const Vector<uint8_t> &p_data, Compression::Mode p_mode, const String &p_mode_name, uint32_t p_block_size) {
+	const String path = OS::get_singleton()->get_cache_path().path_join("file_access_compressed_benchmark.bin");
+
+	{
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", p_mode, p_block_size);
+		REQUIRE(fac->open_internal(path, FileAccess::WRITE) == OK);
+		fac->store_buffer(p_data.ptr(), p_data.size());
+	}
+
+	Vector<uint8_t> read;
+	read.resize(READ_CHUNK_SIZE);
+	double results[2] = {};
+	const uint32_t readahead[2] = { 0, 4 };
+
+	for (int r = 0; r < 2; r++) {
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", p_mode, p_block_size);
+		fac->set_read_cache(4, readahead[r]);
+		REQUIRE(fac->open_internal(path, FileAccess::READ) == OK);
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		uint64_t total = 0;
+		bool matches = true;
+		while (total < uint64_t(p_data.size())) {
+			uint64_t got = fac->get_buffer(read.ptrw(), READ_CHUNK_SIZE);
+			if (got == 0) {
+				break;
+			}
+			matches = matches && memcmp(read.ptr(), p_data.ptr() + total, got) == 0;
+			total += got;
+		}
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+
+		CHECK(total == uint64_t(p_data.size()));
+		CHECK(matches);
+		results[r] = p_data.size() / (1024.0 * 1024.0) / (usec / 1000000.0);
+	}
+
+	uint64_t compressed_size = FileAccess::open(path, FileAccess::READ)->get_length();
+	MESSAGE(vformat("%s, %d KiB blocks, ratio %.2f: %.0f MiB/s, %.0f MiB/s with readahead.",
+			p_mode_name, p_block_size / 1024, double(p_data.size()) / compressed_size, results[0], results[1]));
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][FileAccessCompressed] Sequential read throughput") {
+	const Vector<uint8_t> data = create_data();
+	const uint32_t block_sizes[] = { 4096, 65536, 262144 };
+
+	for (uint32_t block_size : block_sizes) {
+		benchmark_read(data, Compression::MODE_ZSTD, "Zstd", block_size);
+	}
+	for (uint32_t block_size : block_sizes) {
+		benchmark_read(data, Compression::MODE_DEFLATE, "Deflate", block_size);
+	}
+}
+
+} // namespace TestFileAccessCompressedBenchmark
+
+#endif // TEST_FILE_ACCESS_COMPRESSED_BENCHMARK_H
@@ -32,8 +32,10 @@
 #define TEST_IMAGE_H
 
 #include "core/io/image.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
+#include "tests/test_macros.h"
 #include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
@@ -325,6 +327,218 @@ TEST_CASE("[Image] Modifying pixels of an image") {
 		CHECK_MESSAGE(gray_image->get_pixel(2, 2).is_equal_approx(Color(0.266666681, 0.266666681, 0.266666681, 1)), "convert() RGBA to L8 should be around 0.266666681 (68).");
 	}
 }
+
+static Ref<Image> create_noise_image(int p_width, int p_height, Image::Format p_format) {
+	Ref<Image> image = memnew(Image(p_width, p_height, false, p_format));
+	Vector<uint8_t> data = image->get_data();
+	uint8_t *ptr = data.ptrw();
+	uint32_t seed = 12345;
+	if (p_format == Image::FORMAT_RGBAF) {
+		float *fptr = reinterpret_cast<float *>(ptr);
+		for (int i = 0; i < data.size() / 4; i++) {
+			seed = seed * 1103515245 + 12345;
+			fptr[i] = (seed >> 8) / float(1 << 24);
+		}
+	} else {
+		for (int i = 0; i < data.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			ptr[i] = seed >> 24;
+		}
+	}
+	image->set_data(p_width, p_height, false, p_format, data);
+	return image;
+}
+
+TEST_CASE("[Image] Large image operations match per-pixel results") {
+	// Large enough to be split across worker threads and to use the vectorized paths.
+	const int size = 512;
+
+	SUBCASE("RGBA8 mipmaps") {
+		Ref<Image> image = create_noise_image(size, size, Image::FORMAT_RGBA8);
+		image->generate_mipmaps();
+		Vector<uint8_t> data = image->get_data();
+		const uint8_t *base = data.ptr();
+		const uint8_t *mip = base + image->get_mipmap_offset(1);
+		bool matches = true;
+		for (int y = 0; y < size / 2 && matches; y++) {
+			for (int x = 0; x < size / 2 && matches; x++) {
+				for (int c = 0; c < 4; c++) {
+					int sum = base[((y * 2) * size + x * 2) * 4 + c] + base[((y * 2) * size + x * 2 + 1) * 4 + c] + base[((y * 2 + 1) * size + x * 2) * 4 + c] + base[((y * 2 + 1) * size + x * 2 + 1) * 4 + c];
+					matches = matches && mip[(y * (size / 2) + x) * 4 + c] == (sum + 2) >> 2;
+				}
+			}
+		}
+		CHECK_MESSAGE(matches, "RGBA8 mipmap should be the rounded average of each 2x2 block.");
+	}
+
+	SUBCASE("RGBAF mipmaps") {
+		Ref<Image> image = create_noise_image(size, size, Image::FORMAT_RGBAF);
+		image->generate_mipmaps();
+		Vector<uint8_t> data = image->get_data();
+		const float *base = reinterpret_cast<const float *>(data.ptr());
+		const float *mip = reinterpret_cast<const float *>(data.ptr() + image->get_mipmap_offset(1));
+		bool matches = true;
+		for (int y = 0; y < size / 2 && matches; y++) {
+			for (int x = 0; x < size / 2 && matches; x++) {
+				for (int c = 0; c < 4; c++) {
+					float expected = (base[((y * 2) * size + x * 2) * 4 + c] + base[((y * 2) * size + x * 2 + 1) * 4 + c] + base[((y * 2 + 1) * size + x * 2) * 4 + c] + base[((y * 2 + 1) * size + x * 2 + 1) * 4 + c]) * 0.25f;
+					matches = matches && mip[(y * (size / 2) + x) * 4 + c] == expected;
+				}
+			}
+		}
+		CHECK_MESSAGE(matches, "RGBAF mipmap should be the exact average of each 2x2 block.");
+	}
+
+	SUBCASE("Premultiply alpha") {
+		Ref<Image> image = create_noise_image(size, size, Image::FORMAT_RGBA8);
+		Vector<uint8_t> original = image->get_data();
+		image->premultiply_alpha();
+		Vector<uint8_t> data = image->get_data();
+		const uint8_t *result = data.ptr();
+		bool matches = true;
+		for (int i = 0; i < size * size && matches; i++) {
+			const uint8_t *src = &original[i * 4];
+			for (int c = 0; c < 3; c++) {
+				matches = matches && result[i * 4 + c] == ((uint16_t(src[c]) * uint16_t(src[3]) + 255U) >> 8);
+			}
+			matches = matches && result[i * 4 + 3] == src[3];
+		}
+		CHECK_MESSAGE(matches, "premultiply_alpha() should match the scalar formula and keep alpha.");
+	}
+
+	SUBCASE("Resize and convert") {
+		Ref<Image> image = create_noise_image(size, size, Image::FORMAT_RGBA8);
+		Ref<Image> expected = create_noise_image(size, size, Image::FORMAT_RGBA8);
+		image->resize(size / 4, size / 4, Image::INTERPOLATE_NEAREST);
+		image->convert(Image::FORMAT_RGB8);
+		bool matches = true;
+		for (int y = 0; y < size / 4 && matches; y++) {
+			for (int x = 0; x < size / 4 && matches; x++) {
+				Color c = expected->get_pixel(x * 4, y * 4);
+				c.a = 1.0;
+				matches = matches && image->get_pixel(x, y).is_equal_approx(c);
+			}
+		}
+		CHECK_MESSAGE(matches, "Nearest resize followed by RGB8 conversion should pick every 4th pixel.");
+	}
+}
+
+struct CompressOnPoolThread {
+	Ref<Image> image;
+	Image::CompressMode mode = Image::COMPRESS_S3TC;
+	Error err = OK;
+
+	static void compress(void *p_userdata) {
+		CompressOnPoolThread *job = (CompressOnPoolThread *)p_userdata;
+		job->err = job->image->compress(job->mode, Image::COMPRESS_SOURCE_GENERIC);
+	}
+};
+
+TEST_CASE("[Image] Multithreaded texture compression is deterministic") {
+	// Large enough to be split into several tasks per mip level.
+	Ref<Image> source = create_noise_image(512, 512, Image::FORMAT_RGBA8);
+	source->generate_mipmaps();
+
+	const Image::CompressMode modes[] = { Image::COMPRESS_S3TC, Image::COMPRESS_ETC, Image::COMPRESS_ETC2, Image::COMPRESS_BPTC, Image::COMPRESS_ASTC };
+	const char *mode_names[] = { "S3TC", "ETC", "ETC2", "BPTC", "ASTC" };
+	for (int i = 0; i < 5; i++) {
+		Ref<Image> first = source->duplicate();
+		if (first->compress(modes[i], Image::COMPRESS_SOURCE_GENERIC) != OK || !first->is_compressed()) {
+			// Compressor not available in this build.
+			continue;
+		}
+
+		Ref<Image> second = source->duplicate();
+		CHECK(second->compress(modes[i], Image::COMPRESS_SOURCE_GENERIC) == OK);
+		CHECK_MESSAGE(second->get_data() == first->get_data(), vformat("%s compression should give the same data on every run.", mode_names[i]));
+
+		// Compressing from a pool thread takes the single-threaded path, which must give the same data too.
+		CompressOnPoolThread job;
+		job.image = source->duplicate();
+		job.mode = modes[i];
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&CompressOnPoolThread::compress, &job);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		CHECK(job.err == OK);
+		CHECK_MESSAGE(job.image->get_data() == first->get_data(), vformat("%s compression should give the same data on a pool thread.", mode_names[i]));
+	}
+}
+
+static void benchmark_image_operation(const String &p_name, Image::Format p_format, int p_size, void (*p_operation)(const Ref<Image> &)) {
+	const int iterations = 4;
+	uint64_t total_usec = 0;
+	for (int i = 0; i < iterations; i++) {
+		Ref<Image> image = create_noise_image(p_size, p_size, p_format);
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		p_operation(image);
+		total_usec += OS::get_singleton()->get_ticks_usec() - from;
+	}
+	double msec = total_usec / 1000.0 / iterations;
+	MESSAGE(vformat("%s, %s %dx%d: %.3f ms, %.1f Mpixels/s.", p_name, Image::get_format_name(p_format), p_size, p_size, msec, double(p_size) * p_size / MAX(msec, 0.001) / 1000.0));
+}
+
+static void _bench_resize_bilinear(const Ref<Image> &p_image) {
+	p_image->resize(p_image->get_width() / 2 + 1, p_image->get_height() / 2 + 1, Image::INTERPOLATE_BILINEAR);
+}
+
+static void _bench_resize_lanczos(const Ref<Image> &p_image) {
+	p_image->resize(p_image->get_width() / 2 + 1, p_image->get_height() / 2 + 1, Image::INTERPOLATE_LANCZOS);
+}
+
+static void _bench_generate_mipmaps(const Ref<Image> &p_image) {
+	p_image->generate_mipmaps();
+}
+
+static void _bench_convert_rgb8(const Ref<Image> &p_image) {
+	p_image->convert(Image::FORMAT_RGB8);
+}
+
+static void _bench_convert_rgbh(const Ref<Image> &p_image) {
+	p_image->convert(Image::FORMAT_RGBAH);
+}
+
+static void _bench_srgb_to_linear(const Ref<Image> &p_image) {
+	p_image->srgb_to_linear();
+}
+
+static void _bench_premultiply_alpha(const Ref<Image> &p_image) {
+	p_image->premultiply_alpha();
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Image] Resize, mipmaps and format conversion") {
+	for (int size : { 1024, 4096 }) {
+		benchmark_image_operation("Resize (bilinear)", Image::FORMAT_RGBA8, size, _bench_resize_bilinear);
+		benchmark_image_operation("Resize (bilinear)", Image::FORMAT_RGBAF, size, _bench_resize_bilinear);
+		benchmark_image_operation("Resize (lanczos)", Image::FORMAT_RGBA8, size, _bench_resize_lanczos);
+		benchmark_image_operation("Generate mipmaps", Image::FORMAT_RGBA8, size, _bench_generate_mipmaps);
+		benchmark_image_operation("Generate mipmaps", Image::FORMAT_RGBAF, size, _bench_generate_mipmaps);
+		benchmark_image_operation("Convert to RGB8", Image::FORMAT_RGBA8, size, _bench_convert_rgb8);
+		benchmark_image_operation("Convert to RGBAH", Image::FORMAT_RGBAF, size, _bench_convert_rgbh);
+		benchmark_image_operation("sRGB to linear", Image::FORMAT_RGBA8, size, _bench_srgb_to_linear);
+		benchmark_image_operation("Premultiply alpha", Image::FORMAT_RGBA8, size, _bench_premultiply_alpha);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Image] Texture compression") {
+	// Seconds per 4K texture (with mipmaps) for each codec available in this build.
+	const int size = 4096;
+	Ref<Image> source = create_noise_image(size, size, Image::FORMAT_RGBA8);
+	source->generate_mipmaps();
+
+	const Image::CompressMode modes[] = { Image::COMPRESS_S3TC, Image::COMPRESS_ETC, Image::COMPRESS_ETC2, Image::COMPRESS_BPTC, Image::COMPRESS_ASTC };
+	const char *mode_names[] = { "S3TC", "ETC", "ETC2", "BPTC", "ASTC" };
+	for (int i = 0; i < 5; i++) {
+		Ref<Image> image = source->duplicate();
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		Error err = image->compress(modes[i], Image::COMPRESS_SOURCE_GENERIC);
+		double sec = (OS::get_singleton()->get_ticks_usec() - from) / 1000000.0;
+		if (err != OK || !image->is_compressed()) {
+			MESSAGE(vformat("%s: compressor not available, skipped.", mode_names[i]));
+			continue;
+		}
+		MESSAGE(vformat("%s, %dx%d with mipmaps: %.3f s.", mode_names[i], size, size, sec));
+	}
+}
+
 } // namespace TestImage
 
 #endif // TEST_IMAGE_H
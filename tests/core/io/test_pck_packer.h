@@ -31,6 +31,7 @@
 #ifndef TEST_PCK_PACKER_H
 #define TEST_PCK_PACKER_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
@@ -62,6 +63,10 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+	f->seek(4);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_UNCOMPRESSED,
+			"PCK files without compressed files should keep the version older engines can read.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -117,6 +122,97 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and read back a compressed file") {
+	const String source_path = OS::get_singleton()->get_cache_path().path_join("compressible.txt");
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_compressed.pck");
+
+	// Large enough to span several compression blocks.
+	String text;
+	for (int i = 0; i < 20000; i++) {
+		text += vformat("Line %d of a very repetitive text file.\n", i);
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+	CharString expected = text.utf8();
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("res://compressed_pck_test/compressible.txt", source_path, false, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	Ref<FileAccess> pck = FileAccess::open(output_pck_path, FileAccess::READ);
+	REQUIRE(pck.is_valid());
+	CHECK_MESSAGE(
+			pck->get_length() < uint64_t(expected.length()) / 4,
+			"The PCK file should be much smaller than the compressible file it holds.");
+	pck->seek(4);
+	CHECK(pck->get_32() == PACK_FORMAT_VERSION);
+	pck.unref();
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	Ref<FileAccess> f = FileAccess::open("res://compressed_pck_test/compressible.txt", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == uint64_t(expected.length()));
+
+	Vector<uint8_t> data = f->get_buffer(f->get_length());
+	REQUIRE(data.size() == expected.length());
+	CHECK(memcmp(data.ptr(), expected.get_data(), data.size()) == 0);
+
+	// Random access, across block boundaries and backwards.
+	const uint64_t positions[] = { 200000, 65530, 1000, uint64_t(expected.length()) - 3 };
+	for (uint64_t position : positions) {
+		f->seek(position);
+		uint8_t bytes[3] = {};
+		CHECK(f->get_buffer(bytes, 3) == 3);
+		CHECK(memcmp(bytes, expected.get_data() + position, 3) == 0);
+	}
+}
+
+TEST_CASE("[PCKPacker] Pack small files compressed with a trained dictionary") {
+	const String source_dir = OS::get_singleton()->get_cache_path().path_join("pck_dictionary_test");
+	const String output_pck_path = OS::get_singleton()->get_cache_path().path_join("output_dictionary.pck");
+	const String plain_pck_path = OS::get_singleton()->get_cache_path().path_join("output_no_dictionary.pck");
+	const int file_count = 500;
+	REQUIRE(DirAccess::make_dir_recursive_absolute(source_dir) == OK);
+
+	// Too small to compress on their own, but very similar to each other.
+	Vector<String> texts;
+	for (int i = 0; i < file_count; i++) {
+		const String text = vformat("{\"player\": %d, \"position\": [%d.5, %d.25], \"health\": %d, \"name\": \"player_%d\"}", i, i * 7 % 100, i * 3 % 50, i % 100, i % 37);
+		Ref<FileAccess> f = FileAccess::open(source_dir.path_join(itos(i) + ".json"), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+		texts.push_back(text);
+	}
+
+	for (const String &pck_path : { plain_pck_path, output_pck_path }) {
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(pck_path, 4) == OK);
+		for (int i = 0; i < file_count; i++) {
+			CHECK(pck_packer.add_file(vformat("res://pck_dictionary_test/%d.json", i), source_dir.path_join(itos(i) + ".json"), false, true) == OK);
+		}
+		if (pck_path == output_pck_path) {
+			REQUIRE(pck_packer.train_compression_dictionary(4096) == OK);
+		}
+		REQUIRE(pck_packer.flush() == OK);
+	}
+
+	CHECK_MESSAGE(
+			FileAccess::open(output_pck_path, FileAccess::READ)->get_length() < FileAccess::open(plain_pck_path, FileAccess::READ)->get_length(),
+			"The PCK file should be smaller with a dictionary, even though it contains it.");
+
+	// The packer's own copy of the dictionary is gone, the one stored in the PCK must be used.
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+	CHECK_FALSE(FileAccess::exists(PACK_ZSTD_DICTIONARY_PATH));
+	for (int i = 0; i < file_count; i += 49) {
+		CHECK(FileAccess::get_file_as_string(vformat("res://pck_dictionary_test/%d.json", i)) == texts[i]);
+	}
+}
+
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
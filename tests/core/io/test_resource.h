@@ -31,6 +31,8 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/file_access.h"
+#include "core/io/json.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -109,6 +111,162 @@ TEST_CASE("[Resource] Saving and loading") {
 			loaded_child_resource_text->get_name() == "I'm a child resource",
 			"The loaded child resource name should be equal to the expected value.");
 }
+
+TEST_CASE("[Resource] Threaded loading of a dependency tree") {
+	const String leaf_a_path = OS::get_singleton()->get_cache_path().path_join("resource_leaf_a.res");
+	const String leaf_b_path = OS::get_singleton()->get_cache_path().path_join("resource_leaf_b.tres");
+	const String middle_path = OS::get_singleton()->get_cache_path().path_join("resource_middle.tres");
+	const String root_path = OS::get_singleton()->get_cache_path().path_join("resource_root.res");
+	{
+		Ref<Resource> leaf_a = memnew(Resource);
+		leaf_a->set_name("Leaf A");
+		ResourceSaver::save(leaf_a, leaf_a_path);
+		leaf_a->set_path(leaf_a_path);
+		Ref<Resource> leaf_b = memnew(Resource);
+		leaf_b->set_name("Leaf B");
+		ResourceSaver::save(leaf_b, leaf_b_path);
+		leaf_b->set_path(leaf_b_path);
+
+		Ref<Resource> middle = memnew(Resource);
+		middle->set_meta("leaf_a", leaf_a);
+		middle->set_meta("leaf_b", leaf_b);
+		ResourceSaver::save(middle, middle_path);
+		middle->set_path(middle_path);
+
+		Ref<Resource> root = memnew(Resource);
+		root->set_meta("middle", middle);
+		ResourceSaver::save(root, root_path);
+	}
+
+	ResourceLoader::set_load_trace_enabled(true);
+	ResourceLoader::clear_load_trace();
+	REQUIRE(ResourceLoader::load_threaded_request(root_path, "", true) == OK);
+	Ref<Resource> root = ResourceLoader::load_threaded_get(root_path);
+	ResourceLoader::set_load_trace_enabled(false);
+
+	REQUIRE(root.is_valid());
+	Ref<Resource> middle = root->get_meta("middle");
+	REQUIRE(middle.is_valid());
+	CHECK(Ref<Resource>(middle->get_meta("leaf_a"))->get_name() == "Leaf A");
+	CHECK(Ref<Resource>(middle->get_meta("leaf_b"))->get_name() == "Leaf B");
+
+	HashMap<String, ResourceLoader::LoadTraceEntry> trace;
+	for (const ResourceLoader::LoadTraceEntry &E : ResourceLoader::get_load_trace()) {
+		trace[E.path] = E;
+	}
+	ResourceLoader::clear_load_trace();
+	REQUIRE(trace.has(root_path));
+	REQUIRE(trace.has(middle_path));
+	REQUIRE(trace.has(leaf_a_path));
+	REQUIRE(trace.has(leaf_b_path));
+	CHECK(trace[leaf_a_path].error == OK);
+	CHECK(trace[leaf_a_path].type == "Resource");
+	CHECK_MESSAGE(
+			trace[leaf_a_path].end_usec <= trace[middle_path].end_usec,
+			"Dependencies should finish loading before the resources using them.");
+	CHECK(trace[leaf_b_path].end_usec <= trace[middle_path].end_usec);
+	CHECK(trace[middle_path].end_usec <= trace[root_path].end_usec);
+	CHECK(trace[root_path].start_usec <= trace[root_path].end_usec);
+}
+
+TEST_CASE("[Resource] Load trace of nested loads") {
+	const String child_path = OS::get_singleton()->get_cache_path().path_join("resource_trace_child.res");
+	const String parent_path = OS::get_singleton()->get_cache_path().path_join("resource_trace_parent.tres");
+	const String trace_path = OS::get_singleton()->get_cache_path().path_join("resource_load_trace.json");
+	{
+		Ref<Resource> child = memnew(Resource);
+		ResourceSaver::save(child, child_path);
+		child->set_path(child_path);
+
+		Ref<Resource> parent = memnew(Resource);
+		parent->set_meta("child", child);
+		ResourceSaver::save(parent, parent_path);
+	}
+
+	ResourceLoader::set_load_trace_enabled(true);
+	ResourceLoader::clear_load_trace();
+	Ref<Resource> parent = ResourceLoader::load(parent_path);
+	ResourceLoader::set_load_trace_enabled(false);
+	REQUIRE(parent.is_valid());
+
+	HashMap<String, ResourceLoader::LoadTraceEntry> trace;
+	for (const ResourceLoader::LoadTraceEntry &E : ResourceLoader::get_load_trace()) {
+		trace[E.path] = E;
+	}
+	REQUIRE(trace.has(parent_path));
+	REQUIRE(trace.has(child_path));
+	CHECK(trace[parent_path].parent.is_empty());
+	CHECK(trace[parent_path].depth == 0);
+	CHECK(trace[parent_path].loader == "ResourceFormatLoader (tres)");
+	CHECK_MESSAGE(
+			trace[child_path].parent == parent_path,
+			"Nested loads should record the resource that requested them.");
+	CHECK(trace[child_path].depth == 1);
+	CHECK(trace[child_path].loader == "ResourceFormatLoader (res)");
+	CHECK(trace[child_path].bytes == FileAccess::get_file_as_bytes(child_path).size());
+	CHECK(trace[parent_path].start_usec <= trace[child_path].start_usec);
+	CHECK(trace[child_path].end_usec <= trace[parent_path].end_usec);
+
+	REQUIRE(ResourceLoader::save_load_trace(trace_path) == OK);
+	ResourceLoader::clear_load_trace();
+	Dictionary json = JSON::parse_string(FileAccess::get_file_as_string(trace_path));
+	Array events = json["traceEvents"];
+	int complete_events = 0;
+	for (int i = 0; i < events.size(); i++) {
+		Dictionary event = events[i];
+		if (event["ph"] == "X") {
+			complete_events++;
+			CHECK(Dictionary(event["args"]).has("loader"));
+		}
+	}
+	CHECK(complete_events == trace.size());
+}
+
+TEST_CASE("[Resource] Load trace of nested loads on sub-threads") {
+	const String grandchild_path = OS::get_singleton()->get_cache_path().path_join("resource_trace_threaded_grandchild.res");
+	const String child_path = OS::get_singleton()->get_cache_path().path_join("resource_trace_threaded_child.res");
+	const String parent_path = OS::get_singleton()->get_cache_path().path_join("resource_trace_threaded_parent.tres");
+	{
+		Ref<Resource> grandchild = memnew(Resource);
+		ResourceSaver::save(grandchild, grandchild_path);
+		grandchild->set_path(grandchild_path);
+
+		Ref<Resource> child = memnew(Resource);
+		child->set_meta("child", grandchild);
+		ResourceSaver::save(child, child_path);
+		child->set_path(child_path);
+
+		Ref<Resource> parent = memnew(Resource);
+		parent->set_meta("child", child);
+		ResourceSaver::save(parent, parent_path);
+	}
+
+	ResourceLoader::set_load_trace_enabled(true);
+	ResourceLoader::clear_load_trace();
+	REQUIRE(ResourceLoader::load_threaded_request(parent_path, "", true) == OK);
+	Ref<Resource> parent = ResourceLoader::load_threaded_get(parent_path);
+	ResourceLoader::set_load_trace_enabled(false);
+	REQUIRE(parent.is_valid());
+
+	HashMap<String, ResourceLoader::LoadTraceEntry> trace;
+	for (const ResourceLoader::LoadTraceEntry &E : ResourceLoader::get_load_trace()) {
+		trace[E.path] = E;
+	}
+	ResourceLoader::clear_load_trace();
+	REQUIRE(trace.has(parent_path));
+	REQUIRE(trace.has(child_path));
+	REQUIRE(trace.has(grandchild_path));
+	CHECK(trace[parent_path].parent.is_empty());
+	CHECK(trace[parent_path].depth == 0);
+	// Dependencies are scheduled on other threads before the loads needing them start, whichever runs first.
+	CHECK_MESSAGE(
+			trace[child_path].parent == parent_path,
+			"Loads started on other threads should still record the resource that requested them.");
+	CHECK(trace[child_path].depth == 1);
+	CHECK(trace[grandchild_path].parent == child_path);
+	CHECK(trace[grandchild_path].depth == 2);
+}
+
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_dynamic_bvh.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DYNAMIC_BVH_H
+#define TEST_DYNAMIC_BVH_H
+
+#include "core/math/dynamic_bvh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDynamicBVH {
+
+struct CollectQueryResult {
+	Vector<int> indices;
+
+	bool operator()(void *p_data) {
+		indices.push_back(int(intptr_t(p_data)) - 1);
+		return false;
+	}
+};
+
+static Vector<int> query_sorted(DynamicBVH &p_bvh, const AABB &p_aabb) {
+	CollectQueryResult result;
+	p_bvh.aabb_query(p_aabb, result);
+	result.indices.sort();
+	return result.indices;
+}
+
+// Boxes on a grid, apart from each other so queries never land on a shared face.
+static AABB get_box(int p_index, int p_step) {
+	int x = p_index % 16;
+	int y = 0;
+	int z = p_index / 16;
+	if (p_step > 0 && p_index % 3 != 0) {
+		// Two out of three boxes move to another layer, the rest are updated in place.
+		x = (x + p_step * 5) % 16;
+		y = p_step;
+		z = (z + p_step * 3) % 16;
+	}
+	return AABB(Vector3(x * 2.0 + 0.25, y * 2.0 + 0.25, z * 2.0 + 0.25), Vector3(1.5, 1.5, 1.5));
+}
+
+TEST_CASE("[DynamicBVH] Batch updates match single updates") {
+	const int count = 200;
+	DynamicBVH single;
+	DynamicBVH batch;
+	Vector<DynamicBVH::ID> single_ids;
+	Vector<DynamicBVH::ID> batch_ids;
+	for (int i = 0; i < count; i++) {
+		single_ids.push_back(single.insert(get_box(i, 0), (void *)intptr_t(i + 1)));
+		batch_ids.push_back(batch.insert(get_box(i, 0), (void *)intptr_t(i + 1)));
+	}
+
+	for (int step = 1; step <= 3; step++) {
+		Vector<AABB> boxes;
+		for (int i = 0; i < count; i++) {
+			boxes.push_back(get_box(i, step));
+			single.update(single_ids[i], boxes[i]);
+		}
+		batch.update_batch(batch_ids.ptr(), boxes.ptr(), count);
+
+		CHECK(batch.get_leaf_count() == count);
+		for (int i = 0; i < count; i++) {
+			// Each box only overlaps itself, at its new place.
+			Vector<int> found = query_sorted(batch, boxes[i].grow(-0.1));
+			CHECK_MESSAGE(found.size() == 1, vformat("Box %d was not found at its new place at step %d.", i, step));
+			CHECK(found.has(i));
+		}
+
+		const AABB queries[] = {
+			AABB(Vector3(-1, -1, -1), Vector3(40, 10, 40)),
+			AABB(Vector3(3.1, -1, 5.1), Vector3(7.7, 10, 4.3)),
+			AABB(Vector3(20.1, -1, 0.1), Vector3(0.3, 10, 31.7)),
+			AABB(Vector3(50, 50, 50), Vector3(1, 1, 1)),
+		};
+		for (const AABB &query : queries) {
+			Vector<int> expected;
+			for (int i = 0; i < count; i++) {
+				if (boxes[i].intersects(query)) {
+					expected.push_back(i);
+				}
+			}
+			CHECK(query_sorted(single, query) == expected);
+			CHECK(query_sorted(batch, query) == expected);
+		}
+	}
+
+	for (int i = 0; i < count; i++) {
+		single.remove(single_ids[i]);
+		batch.remove(batch_ids[i]);
+	}
+	CHECK(batch.is_empty());
+}
+
+} // namespace TestDynamicBVH
+
+#endif // TEST_DYNAMIC_BVH_H
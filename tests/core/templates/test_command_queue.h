@@ -422,6 +422,258 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class BufferedReceiver {
+public:
+	LocalVector<int> log[4];
+	int sync_count = 0;
+
+	void record(int p_thread, int p_value) {
+		log[p_thread].push_back(p_value);
+	}
+	void record_unbuffered(int p_thread, int p_value) {
+		log[p_thread].push_back(-p_value);
+	}
+};
+
+class BufferedProducer {
+public:
+	CommandQueueMT *queue = nullptr;
+	BufferedReceiver *receiver = nullptr;
+	int index = 0;
+	int count = 0;
+	int unbuffered_every = 0;
+	bool buffered = true;
+	Thread thread;
+
+	void run() {
+		for (int i = 1; i <= count; i++) {
+			if (unbuffered_every > 0 && i % unbuffered_every == 0) {
+				queue->push(receiver, &BufferedReceiver::record_unbuffered, index, i);
+			} else if (buffered) {
+				queue->push_buffered(receiver, &BufferedReceiver::record, index, i);
+			} else {
+				queue->push(receiver, &BufferedReceiver::record, index, i);
+			}
+		}
+	}
+	static void static_run(void *p_producer) {
+		static_cast<BufferedProducer *>(p_producer)->run();
+	}
+};
+
+TEST_CASE("[CommandQueue] Buffered commands from threads") {
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	// Enough commands to span several chunks.
+	const int count = 20000;
+	BufferedProducer producers[4];
+	for (int i = 0; i < 4; i++) {
+		producers[i].queue = &queue;
+		producers[i].receiver = &receiver;
+		producers[i].index = i;
+		producers[i].count = count;
+		producers[i].thread.start(&BufferedProducer::static_run, &producers[i]);
+	}
+	for (int i = 0; i < 4; i++) {
+		producers[i].thread.wait_to_finish();
+	}
+
+	queue.flush_all();
+	CHECK_MESSAGE(receiver.log[0].size() == 0,
+			"Buffered commands should not run when only the shared queue is flushed.");
+
+	queue.flush_thread_buffers();
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(receiver.log[i].size() == uint32_t(count));
+		bool in_order = true;
+		for (int j = 0; j < count; j++) {
+			in_order = in_order && receiver.log[i][j] == j + 1;
+		}
+		CHECK_MESSAGE(in_order, "Commands from each thread should run in push order.");
+	}
+
+	// The main thread never buffers.
+	queue.push_buffered(&receiver, &BufferedReceiver::record, 0, 1);
+	queue.flush_all();
+	CHECK(receiver.log[0].size() == uint32_t(count + 1));
+}
+
+TEST_CASE("[CommandQueue] Buffered commands keep their order with shared queue commands") {
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	BufferedProducer producer;
+	producer.queue = &queue;
+	producer.receiver = &receiver;
+	producer.count = 1000;
+	producer.unbuffered_every = 100;
+	producer.thread.start(&BufferedProducer::static_run, &producer);
+	producer.thread.wait_to_finish();
+
+	// A frame boundary before the shared queue reaches this thread's commands must not reorder them.
+	queue.flush_thread_buffers();
+	CHECK(receiver.log[0].size() == 0);
+
+	queue.flush_all();
+	queue.flush_thread_buffers();
+	REQUIRE(receiver.log[0].size() == 1000);
+	bool in_order = true;
+	for (int i = 0; i < 1000; i++) {
+		int expected = (i + 1) % 100 == 0 ? -(i + 1) : i + 1;
+		in_order = in_order && receiver.log[0][i] == expected;
+	}
+	CHECK_MESSAGE(in_order, "Buffered and shared queue commands should run in push order.");
+}
+
+TEST_CASE("[CommandQueue] Buffered commands run before later commands from other threads") {
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	BufferedProducer producer;
+	producer.queue = &queue;
+	producer.receiver = &receiver;
+	producer.count = 100;
+	producer.thread.start(&BufferedProducer::static_run, &producer);
+	producer.thread.wait_to_finish();
+
+	// Like freeing a resource another thread was still filling, this must run after what it buffered.
+	queue.push(&receiver, &BufferedReceiver::record_unbuffered, 0, 1000);
+	queue.flush_all();
+	REQUIRE(receiver.log[0].size() == 101);
+	CHECK(receiver.log[0][0] == 1);
+	CHECK(receiver.log[0][99] == 100);
+	CHECK(receiver.log[0][100] == -1000);
+
+	// The server thread calls flush_if_pending() before running a call itself, which must see them too.
+	producer.thread.start(&BufferedProducer::static_run, &producer);
+	producer.thread.wait_to_finish();
+	queue.flush_if_pending();
+	CHECK(receiver.log[0].size() == 201);
+}
+
+static void push_shared_then_buffered(void *p_producer) {
+	BufferedProducer *producer = static_cast<BufferedProducer *>(p_producer);
+	producer->queue->push(producer->receiver, &BufferedReceiver::record_unbuffered, producer->index, 1);
+	producer->queue->push_buffered(producer->receiver, &BufferedReceiver::record, producer->index, 2);
+}
+
+TEST_CASE("[CommandQueue] Commands buffered after a shared command run after it") {
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	// Leaves commands buffered by another thread, so the next shared push queues a flush of all buffers ahead of it.
+	BufferedProducer other;
+	other.queue = &queue;
+	other.receiver = &receiver;
+	other.index = 1;
+	other.count = 1;
+	other.thread.start(&BufferedProducer::static_run, &other);
+	other.thread.wait_to_finish();
+
+	BufferedProducer producer;
+	producer.queue = &queue;
+	producer.receiver = &receiver;
+	producer.thread.start(&push_shared_then_buffered, &producer);
+	producer.thread.wait_to_finish();
+
+	queue.flush_all();
+	CHECK(receiver.log[1].size() == 1);
+	REQUIRE(receiver.log[0].size() == 1);
+	CHECK_MESSAGE(receiver.log[0][0] == -1, "The queued flush should not run commands buffered after the shared one.");
+
+	queue.flush_thread_buffers();
+	REQUIRE(receiver.log[0].size() == 2);
+	CHECK(receiver.log[0][1] == 2);
+
+	// Same with a frame boundary before the shared queue is flushed.
+	producer.index = 2;
+	producer.thread.start(&push_shared_then_buffered, &producer);
+	producer.thread.wait_to_finish();
+	queue.flush_thread_buffers();
+	CHECK(receiver.log[2].size() == 0);
+
+	queue.flush_all();
+	queue.flush_thread_buffers();
+	REQUIRE(receiver.log[2].size() == 2);
+	CHECK(receiver.log[2][0] == -1);
+	CHECK(receiver.log[2][1] == 2);
+}
+
+TEST_CASE("[CommandQueue] Buffers of exited threads are reused") {
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	for (int i = 0; i < 20; i++) {
+		BufferedProducer producer;
+		producer.queue = &queue;
+		producer.receiver = &receiver;
+		producer.count = 10;
+		producer.thread.start(&BufferedProducer::static_run, &producer);
+		producer.thread.wait_to_finish();
+		queue.flush_thread_buffers();
+	}
+
+	CHECK(receiver.log[0].size() == 200);
+	CHECK_MESSAGE(queue.get_thread_buffer_count() == 1, "Short-lived threads should not each keep a buffer.");
+}
+
+static void benchmark_producers(int p_thread_count, bool p_buffered) {
+	const int command_count = 200000;
+	const int frame_count = 10;
+
+	CommandQueueMT queue(false);
+	queue.set_thread_buffers_enabled(true);
+	BufferedReceiver receiver;
+
+	uint64_t push_usec = 0;
+	uint64_t flush_usec = 0;
+
+	for (int frame = 0; frame < frame_count; frame++) {
+		BufferedProducer producers[4];
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < p_thread_count; i++) {
+			producers[i].queue = &queue;
+			producers[i].receiver = &receiver;
+			producers[i].index = i;
+			producers[i].count = command_count / p_thread_count;
+			producers[i].buffered = p_buffered;
+			producers[i].thread.start(&BufferedProducer::static_run, &producers[i]);
+		}
+		for (int i = 0; i < p_thread_count; i++) {
+			producers[i].thread.wait_to_finish();
+		}
+		uint64_t after_push = OS::get_singleton()->get_ticks_usec();
+
+		queue.flush_all();
+		queue.flush_thread_buffers();
+		uint64_t after_flush = OS::get_singleton()->get_ticks_usec();
+
+		push_usec += after_push - from;
+		flush_usec += after_flush - after_push;
+
+		for (int i = 0; i < p_thread_count; i++) {
+			receiver.log[i].clear();
+		}
+	}
+
+	MESSAGE(vformat("%s queue, %d producer threads, %d commands/frame: push %.3f ms/frame, flush %.3f ms/frame.",
+			p_buffered ? "Thread buffered" : "Shared", p_thread_count, command_count, push_usec / 1000.0 / frame_count, flush_usec / 1000.0 / frame_count));
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][CommandQueue] Multi-producer throughput") {
+	for (int thread_count = 1; thread_count <= 4; thread_count *= 2) {
+		benchmark_producers(thread_count, false);
+		benchmark_producers(thread_count, true);
+	}
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
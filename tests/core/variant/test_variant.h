@@ -126,6 +126,58 @@ TEST_CASE("[Variant] Writer and parser Variant::FLOAT") {
 	CHECK_MESSAGE(float_parsed == 1.0e+100, "Should match the double literal.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays") {
+	String errs;
+	int line = 1;
+	Variant parsed;
+
+	VariantParser::StreamString ss;
+	ss.s = "PackedFloat32Array(1, -2.5,3e2 ,\n\tinf, ; comment\n-4e-1, nan)";
+	REQUIRE(VariantParser::parse(&ss, parsed, errs, line) == OK);
+	REQUIRE(parsed.get_type() == Variant::PACKED_FLOAT32_ARRAY);
+	PackedFloat32Array floats = parsed;
+	REQUIRE(floats.size() == 6);
+	CHECK(floats[0] == 1.0f);
+	CHECK(floats[1] == -2.5f);
+	CHECK(floats[2] == 300.0f);
+	CHECK(Math::is_inf(floats[3]));
+	CHECK(floats[4] == -0.4f);
+	CHECK(Math::is_nan(floats[5]));
+	CHECK_MESSAGE(line == 3, "Line breaks inside the array should be counted.");
+
+	VariantParser::StreamString bss;
+	bss.s = "PackedByteArray( 0, 127,255 )";
+	REQUIRE(VariantParser::parse(&bss, parsed, errs, line) == OK);
+	PackedByteArray bytes = parsed;
+	REQUIRE(bytes.size() == 3);
+	CHECK(bytes[0] == 0);
+	CHECK(bytes[1] == 127);
+	CHECK(bytes[2] == 255);
+
+	VariantParser::StreamString ess;
+	ess.s = "PackedInt64Array()";
+	REQUIRE(VariantParser::parse(&ess, parsed, errs, line) == OK);
+	CHECK(PackedInt64Array(parsed).is_empty());
+
+	VariantParser::StreamString iss;
+	iss.s = "PackedInt64Array(-9223372036854775807, 9223372036854775807)";
+	REQUIRE(VariantParser::parse(&iss, parsed, errs, line) == OK);
+	PackedInt64Array ints = parsed;
+	REQUIRE(ints.size() == 2);
+	CHECK(ints[0] == -9223372036854775807);
+	CHECK(ints[1] == 9223372036854775807);
+
+	VariantParser::StreamString uss;
+	uss.s = "PackedInt32Array(1, 2";
+	CHECK(VariantParser::parse(&uss, parsed, errs, line) == ERR_PARSE_ERROR);
+	CHECK(errs == "Expected ',' or ')' in constructor");
+
+	VariantParser::StreamString wss;
+	wss.s = "PackedInt32Array(1, \"2\")";
+	CHECK(VariantParser::parse(&wss, parsed, errs, line) == ERR_PARSE_ERROR);
+	CHECK(errs == "Expected float in constructor");
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i and Color") {
 	Variant int_v = 0;
 	Variant bool_v = true;
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_variant_parser_benchmark.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VARIANT_PARSER_BENCHMARK_H
+#define TEST_VARIANT_PARSER_BENCHMARK_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "core/variant/variant_parser.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVariantParserBenchmark {
+
+static const int LOAD_COUNT = 5;
+
+// A text resource dominated by long packed arrays, like a scene with baked meshes or navigation data.
+static Ref<Resource> create_resource(int p_count) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(0x5eed);
+
+	PackedFloat32Array floats;
+	floats.resize(p_count);
+	float *fw = floats.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		fw[i] = rng->randf_range(-1000.0, 1000.0);
+	}
+
+	PackedByteArray bytes;
+	bytes.resize(p_count);
+	uint8_t *bw = bytes.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		bw[i] = rng->randi() & 0xFF;
+	}
+
+	Ref<Resource> res;
+	res.instantiate();
+	res->set_meta("floats", floats);
+	res->set_meta("bytes", bytes);
+	return res;
+}
+
+static void benchmark_text_resource_load(int p_count) {
+	const String path = OS::get_singleton()->get_cache_path().path_join("variant_parser_benchmark.tres");
+	Ref<Resource> res = create_resource(p_count);
+	REQUIRE(ResourceSaver::save(res, path) == OK);
+
+	Vector<uint8_t> file_bytes = FileAccess::get_file_as_bytes(path);
+	REQUIRE(!file_bytes.is_empty());
+	double file_mb = file_bytes.size() / (1024.0 * 1024.0);
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOAD_COUNT; i++) {
+		Ref<Resource> loaded = ResourceLoader::load(path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded.is_valid());
+		CHECK(PackedFloat32Array(loaded->get_meta("floats")).size() == p_count);
+		CHECK(PackedByteArray(loaded->get_meta("bytes")).size() == p_count);
+	}
+	double load_msec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1)) / 1000.0 / LOAD_COUNT;
+
+	// Parsing the bare values from the file isolates the tokenizer from resource and property setup.
+	String text;
+	VariantWriter::write_to_string(res->get_meta("floats"), text);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(text);
+	f.unref();
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < LOAD_COUNT; i++) {
+		VariantParser::StreamFile stream;
+		stream.f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(stream.f.is_valid());
+		Variant value;
+		String err_str;
+		int line = 1;
+		REQUIRE(VariantParser::parse(&stream, value, err_str, line) == OK);
+		CHECK(PackedFloat32Array(value).size() == p_count);
+	}
+	double parse_msec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1)) / 1000.0 / LOAD_COUNT;
+	double parse_mb = text.utf8().length() / (1024.0 * 1024.0);
+
+	MESSAGE(vformat("%d values, %.1f MiB: %.3f ms/load (%.1f MiB/s); PackedFloat32Array alone %.1f MiB: %.3f ms/parse (%.1f MiB/s).",
+			p_count, file_mb, load_msec, file_mb * 1000.0 / load_msec, parse_mb, parse_msec, parse_mb * 1000.0 / parse_msec));
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][VariantParser] Large text resource load") {
+	benchmark_text_resource_load(10000);
+	benchmark_text_resource_load(100000);
+	benchmark_text_resource_load(1000000);
+}
+
+} // namespace TestVariantParserBenchmark
+
+#endif // TEST_VARIANT_PARSER_BENCHMARK_H
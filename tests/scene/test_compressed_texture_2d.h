@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_compressed_texture_2d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_COMPRESSED_TEXTURE_2D_H
+#define TEST_COMPRESSED_TEXTURE_2D_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "scene/resources/texture.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCompressedTexture2D {
+
+// Writes a 64x64 RGBA8 image with mipmaps in the uncompressed .ctex layout, every mipmap level filled with its index.
+static String write_image_data(const String &p_file_name) {
+	const int size = 64;
+	Vector<uint8_t> data;
+	data.resize(Image::get_image_data_size(size, size, Image::FORMAT_RGBA8, true));
+	const int mipmaps = Image::get_image_required_mipmaps(size, size, Image::FORMAT_RGBA8);
+	for (int i = 0; i <= mipmaps; i++) {
+		int mw, mh;
+		int ofs = Image::get_image_mipmap_offset_and_dimensions(size, size, Image::FORMAT_RGBA8, i, mw, mh);
+		memset(data.ptrw() + ofs, i, mw * mh * 4);
+	}
+
+	String path = OS::get_singleton()->get_cache_path().path_join(p_file_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
+	f->store_16(size);
+	f->store_16(size);
+	f->store_32(mipmaps);
+	f->store_32(Image::FORMAT_RGBA8);
+	f->store_buffer(data.ptr(), data.size());
+	return path;
+}
+
+TEST_CASE("[CompressedTexture2D] Load image data with a size limit") {
+	const String path = write_image_data("test_compressed_texture_2d_image");
+
+	SUBCASE("No limit loads every mipmap") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		Ref<Image> image = CompressedTexture2D::load_image_from_file(f, 0);
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == Size2i(64, 64));
+		CHECK(image->has_mipmaps());
+		CHECK(image->get_mipmap_count() == 6);
+		CHECK(image->get_pixel(0, 0).get_r8() == 0);
+	}
+
+	SUBCASE("Limit skips the mipmaps larger than it") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		Ref<Image> image = CompressedTexture2D::load_image_from_file(f, 16);
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == Size2i(16, 16));
+		CHECK(image->has_mipmaps());
+		CHECK(image->get_mipmap_count() == 4);
+		CHECK_MESSAGE(image->get_pixel(0, 0).get_r8() == 2, "The third mipmap level should become the base level.");
+	}
+
+	SUBCASE("Limit that is not a mipmap size rounds down") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		Ref<Image> image = CompressedTexture2D::load_image_from_file(f, 20);
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == Size2i(16, 16));
+	}
+
+	SUBCASE("Limit below the smallest mipmap keeps the last one") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		Ref<Image> image = CompressedTexture2D::load_image_from_file(f, 1);
+		REQUIRE(image.is_valid());
+		CHECK(image->get_size() == Size2i(1, 1));
+		CHECK_FALSE(image->has_mipmaps());
+	}
+
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestCompressedTexture2D
+
+#endif // TEST_COMPRESSED_TEXTURE_2D_H
@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*  test_cpu_particles_benchmark.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_CPU_PARTICLES_BENCHMARK_H
+#define TEST_CPU_PARTICLES_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "scene/2d/cpu_particles_2d.h"
+#include "scene/3d/cpu_particles_3d.h"
+#include "scene/main/window.h"
+#include "scene/resources/curve.h"
+#include "scene/resources/gradient.h"
+
+#include "tests/test_macros.h"
+
+namespace TestCPUParticlesBenchmark {
+
+static const int FRAME_COUNT = 120;
+
+// Enables the curves and randomized parameters that make the per-particle update expensive,
+// so the benchmark reflects a typical effect rather than particles falling in a straight line.
+template <class T>
+static void configure_particles(T *p_particles, int p_amount) {
+	p_particles->set_amount(p_amount);
+	p_particles->set_lifetime(1.0);
+	p_particles->set_randomness_ratio(0.5);
+	p_particles->set_lifetime_randomness(0.25);
+	p_particles->set_param_min(T::PARAM_INITIAL_LINEAR_VELOCITY, 2.0);
+	p_particles->set_param_max(T::PARAM_INITIAL_LINEAR_VELOCITY, 5.0);
+	p_particles->set_param_max(T::PARAM_RADIAL_ACCEL, 1.0);
+	p_particles->set_param_max(T::PARAM_TANGENTIAL_ACCEL, 1.0);
+	p_particles->set_param_max(T::PARAM_DAMPING, 0.5);
+	p_particles->set_param_max(T::PARAM_ANGULAR_VELOCITY, 90.0);
+
+	Ref<Curve> scale_curve;
+	scale_curve.instantiate();
+	scale_curve->add_point(Vector2(0.0, 0.0));
+	scale_curve->add_point(Vector2(0.2, 1.0));
+	scale_curve->add_point(Vector2(1.0, 0.0));
+	p_particles->set_param_curve(T::PARAM_SCALE, scale_curve);
+
+	Ref<Gradient> color_ramp;
+	color_ramp.instantiate();
+	color_ramp->add_point(0.5, Color(1, 0.5, 0));
+	p_particles->set_color_ramp(color_ramp);
+
+	p_particles->set_emitting(true);
+}
+
+template <class T>
+static void benchmark_particles(const String &p_name, int p_amount) {
+	T *particles = memnew(T);
+	configure_particles(particles, p_amount);
+	SceneTree::get_singleton()->get_root()->add_child(particles);
+
+	// Let every particle be emitted once before measuring.
+	for (int frame = 0; frame < 60; frame++) {
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+	}
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		SceneTree::get_singleton()->process(1.0 / 60.0);
+	}
+	uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	CHECK(particles->is_emitting());
+
+	double elapsed_msec = MAX(elapsed_usec, uint64_t(1)) / 1000.0;
+	MESSAGE(vformat("%s, %d particles: %.3f ms/frame, %.0f particles/ms.",
+			p_name, p_amount, elapsed_msec / FRAME_COUNT, double(p_amount) * FRAME_COUNT / elapsed_msec));
+
+	memdelete(particles);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][CPUParticles3D] Particle simulation") {
+	benchmark_particles<CPUParticles3D>("CPUParticles3D", 100);
+	benchmark_particles<CPUParticles3D>("CPUParticles3D", 1000);
+	benchmark_particles<CPUParticles3D>("CPUParticles3D", 10000);
+	benchmark_particles<CPUParticles3D>("CPUParticles3D", 100000);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][CPUParticles2D] Particle simulation") {
+	benchmark_particles<CPUParticles2D>("CPUParticles2D", 100);
+	benchmark_particles<CPUParticles2D>("CPUParticles2D", 1000);
+	benchmark_particles<CPUParticles2D>("CPUParticles2D", 10000);
+	benchmark_particles<CPUParticles2D>("CPUParticles2D", 100000);
+}
+
+} // namespace TestCPUParticlesBenchmark
+
+#endif // TEST_CPU_PARTICLES_BENCHMARK_H
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_importer_mesh.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_IMPORTER_MESH_H
+#define TEST_IMPORTER_MESH_H
+
+#include "scene/resources/importer_mesh.h"
+#include "scene/resources/surface_tool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestImporterMesh {
+
+TEST_CASE("[ImporterMesh] Optimize surfaces") {
+	if (!SurfaceTool::optimize_overdraw_func) {
+		// The meshoptimizer module is disabled.
+		return;
+	}
+
+	// Two triangles forming a quad, without shared vertices, plus one unused vertex.
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	PackedVector3Array vertices = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 1, 0), Vector3(0, 0, 0), Vector3(1, 1, 0), Vector3(0, 1, 0), Vector3(5, 5, 5) };
+	PackedVector2Array uvs = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 0), Vector2(1, 1), Vector2(0, 1), Vector2(0, 0) };
+	PackedInt32Array indices = { 0, 1, 2, 3, 4, 5 };
+	arrays[Mesh::ARRAY_VERTEX] = vertices;
+	arrays[Mesh::ARRAY_TEX_UV] = uvs;
+	arrays[Mesh::ARRAY_INDEX] = indices;
+
+	Ref<ImporterMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, arrays);
+	mesh->optimize_surfaces();
+
+	Array optimized = mesh->get_surface_arrays(0);
+	PackedVector3Array new_vertices = optimized[Mesh::ARRAY_VERTEX];
+	PackedVector2Array new_uvs = optimized[Mesh::ARRAY_TEX_UV];
+	PackedInt32Array new_indices = optimized[Mesh::ARRAY_INDEX];
+	CHECK(new_vertices.size() == 4);
+	CHECK(new_uvs.size() == 4);
+	REQUIRE(new_indices.size() == 6);
+
+	// Every triangle must still exist, with matching attributes.
+	for (int i = 0; i < 2; i++) {
+		bool found = false;
+		for (int j = 0; j < 2 && !found; j++) {
+			for (int rotation = 0; rotation < 3 && !found; rotation++) {
+				bool match = true;
+				for (int k = 0; k < 3; k++) {
+					int src = indices[i * 3 + k];
+					int dst = new_indices[j * 3 + (k + rotation) % 3];
+					match = match && vertices[src] == new_vertices[dst] && uvs[src] == new_uvs[dst];
+				}
+				found = match;
+			}
+		}
+		CHECK(found);
+	}
+}
+
+TEST_CASE("[ImporterMesh] Optimize surfaces keeps the vertices of LODs") {
+	if (!SurfaceTool::optimize_overdraw_func) {
+		// The meshoptimizer module is disabled.
+		return;
+	}
+
+	// The LOD draws one triangle with a vertex the surface itself doesn't use.
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	PackedVector3Array vertices = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 1, 0), Vector3(0, 1, 0), Vector3(2, 2, 0) };
+	PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+	PackedInt32Array lod_indices = { 0, 1, 4 };
+	arrays[Mesh::ARRAY_VERTEX] = vertices;
+	arrays[Mesh::ARRAY_INDEX] = indices;
+	Dictionary lods;
+	lods[0.5] = lod_indices;
+
+	Ref<ImporterMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface(Mesh::PRIMITIVE_TRIANGLES, arrays, Array(), lods);
+	mesh->optimize_surfaces();
+
+	Array optimized = mesh->get_surface_arrays(0);
+	PackedVector3Array new_vertices = optimized[Mesh::ARRAY_VERTEX];
+	CHECK(new_vertices.size() == 5);
+	REQUIRE(mesh->get_surface_lod_count(0) == 1);
+	Vector<int> new_lod_indices = mesh->get_surface_lod_indices(0, 0);
+	REQUIRE(new_lod_indices.size() == 3);
+	for (int i = 0; i < 3; i++) {
+		REQUIRE(new_lod_indices[i] >= 0);
+		REQUIRE(new_lod_indices[i] < new_vertices.size());
+		CHECK(new_vertices[new_lod_indices[i]] == vertices[lod_indices[i]]);
+	}
+}
+
+} // namespace TestImporterMesh
+
+#endif // TEST_IMPORTER_MESH_H
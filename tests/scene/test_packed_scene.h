@@ -0,0 +1,323 @@
+/**************************************************************************/
+/*  test_packed_scene.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/2d/sprite_2d.h"
+#include "scene/audio/audio_stream_player.h"
+#include "scene/main/timer.h"
+#include "scene/main/window.h"
+#include "scene/resources/packed_scene.h"
+#include "scene/resources/texture.h"
+#include "servers/audio_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedScene {
+
+static Ref<PackedScene> create_child_scene() {
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	Ref<SceneState> state = scene->get_state();
+
+	int root = state->add_node(-1, -1, state->add_name("Node2D"), state->add_name("Child"), -1, -1);
+	int sprite = state->add_node(root, root, state->add_name("Sprite2D"), state->add_name("Sprite"), -1, -1);
+	state->add_node_property(sprite, state->add_name("centered"), state->add_value(false));
+	return scene;
+}
+
+// A scene using what the instantiation plan covers: native nodes, groups, connections with binds,
+// metadata, an instantiated sub-scene and a property override on a node inside it.
+static Ref<PackedScene> create_enemy_scene() {
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	Ref<SceneState> state = scene->get_state();
+	int position = state->add_name("position");
+	int modulate = state->add_name("modulate");
+
+	int root = state->add_node(-1, -1, state->add_name("Node2D"), state->add_name("Enemy"), -1, -1);
+	state->add_node_property(root, position, state->add_value(Vector2(10, 20)));
+	state->add_node_property(root, state->add_name("rotation"), state->add_value(0.5));
+	state->add_node_property(root, state->add_name("metadata/kind"), state->add_value("enemy"));
+	state->add_node_group(root, state->add_name("enemies"));
+
+	int sprite = state->add_node(root, root, state->add_name("Sprite2D"), state->add_name("Sprite"), -1, -1);
+	state->add_node_property(sprite, modulate, state->add_value(Color(1, 0, 0)));
+	state->add_node_property(sprite, state->add_name("offset"), state->add_value(Vector2(1, 2)));
+
+	int timer = state->add_node(root, root, state->add_name("Timer"), state->add_name("Timer"), -1, -1);
+	state->add_node_property(timer, state->add_name("wait_time"), state->add_value(2.5));
+	state->add_node_property(timer, state->add_name("one_shot"), state->add_value(true));
+
+	int child = state->add_node(root, root, SceneState::TYPE_INSTANTIATED, state->add_name("Child"), state->add_value(create_child_scene()), -1);
+	state->add_node_property(child, position, state->add_value(Vector2(5, 5)));
+	int child_sprite = state->add_node(child, -1, SceneState::TYPE_INSTANTIATED, state->add_name("Sprite"), -1, -1);
+	state->add_node_property(child_sprite, modulate, state->add_value(Color(0, 1, 0)));
+
+	int timeout = state->add_name("timeout");
+	state->add_connection(timer, sprite, timeout, state->add_name("hide"), 0, 0, Vector<int>());
+	Vector<int> binds;
+	binds.push_back(state->add_value(false));
+	state->add_connection(timer, child_sprite, timeout, state->add_name("set_visible"), 0, 0, binds);
+	return scene;
+}
+
+static void check_same_nodes(Node *p_a, Node *p_b) {
+	CHECK(p_a->get_class() == p_b->get_class());
+	CHECK(p_a->get_name() == p_b->get_name());
+	CHECK((p_a->get_owner() ? p_a->get_path_to(p_a->get_owner()) : NodePath()) == (p_b->get_owner() ? p_b->get_path_to(p_b->get_owner()) : NodePath()));
+
+	List<PropertyInfo> plist;
+	p_a->get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		if (E.usage & PROPERTY_USAGE_STORAGE) {
+			CHECK_MESSAGE(p_a->get(E.name) == p_b->get(E.name), vformat("Property \"%s\" of \"%s\" should match.", E.name, p_a->get_name()));
+		}
+	}
+
+	List<Node::GroupInfo> groups_a;
+	List<Node::GroupInfo> groups_b;
+	p_a->get_groups(&groups_a);
+	p_b->get_groups(&groups_b);
+	CHECK(groups_a.size() == groups_b.size());
+
+	List<Object::Connection> connections_a;
+	List<Object::Connection> connections_b;
+	p_a->get_signals_connected_to_this(&connections_a);
+	p_b->get_signals_connected_to_this(&connections_b);
+	CHECK(connections_a.size() == connections_b.size());
+
+	REQUIRE(p_a->get_child_count() == p_b->get_child_count());
+	for (int i = 0; i < p_a->get_child_count(); i++) {
+		check_same_nodes(p_a->get_child(i), p_b->get_child(i));
+	}
+}
+
+TEST_CASE("[SceneTree][PackedScene] Instantiation plan matches the generic path") {
+	Ref<PackedScene> scene = create_enemy_scene();
+
+	SceneState::set_use_instantiation_plan(false);
+	Node *generic = scene->instantiate();
+	SceneState::set_use_instantiation_plan(true);
+	Node *planned = scene->instantiate();
+	REQUIRE(generic);
+	REQUIRE(planned);
+
+	check_same_nodes(generic, planned);
+
+	CHECK(planned->get_name() == "Enemy");
+	CHECK(Object::cast_to<Node2D>(planned)->get_position() == Vector2(10, 20));
+	CHECK(planned->get_meta("kind") == "enemy");
+	CHECK(planned->is_in_group("enemies"));
+	Sprite2D *sprite = Object::cast_to<Sprite2D>(planned->get_node(NodePath("Sprite")));
+	REQUIRE(sprite);
+	CHECK(sprite->get_modulate() == Color(1, 0, 0));
+	CHECK(sprite->get_owner() == planned);
+	Timer *timer = Object::cast_to<Timer>(planned->get_node(NodePath("Timer")));
+	REQUIRE(timer);
+	CHECK(timer->get_wait_time() == doctest::Approx(2.5));
+	CHECK(timer->is_one_shot());
+	Sprite2D *child_sprite = Object::cast_to<Sprite2D>(planned->get_node(NodePath("Child/Sprite")));
+	REQUIRE(child_sprite);
+	CHECK(Object::cast_to<Node2D>(planned->get_node(NodePath("Child")))->get_position() == Vector2(5, 5));
+	CHECK(child_sprite->get_modulate() == Color(0, 1, 0));
+	CHECK_FALSE(child_sprite->is_centered());
+
+	List<Object::Connection> connections;
+	timer->get_signal_connection_list("timeout", &connections);
+	CHECK(connections.size() == 2);
+	timer->emit_signal("timeout");
+	CHECK_FALSE(sprite->is_visible());
+	CHECK_FALSE(child_sprite->is_visible());
+
+	memdelete(generic);
+	memdelete(planned);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Instantiation plan is rebuilt when the scene changes") {
+	Ref<PackedScene> scene = create_enemy_scene();
+	Node *before = scene->instantiate();
+	REQUIRE(before);
+	CHECK_FALSE(before->get_node(NodePath("Sprite"))->is_in_group("visible_things"));
+
+	Ref<SceneState> state = scene->get_state();
+	state->add_node_group(1, state->add_name("visible_things"));
+	Node *after = scene->instantiate();
+	REQUIRE(after);
+	CHECK(after->get_node(NodePath("Sprite"))->is_in_group("visible_things"));
+
+	memdelete(before);
+	memdelete(after);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Released instances are reset and reused") {
+	Ref<PackedScene> scene = create_enemy_scene();
+	scene->set_instance_pool_size(1);
+	Window *root = SceneTree::get_singleton()->get_root();
+	Node *listener = memnew(Node);
+	root->add_child(listener);
+
+	Node *instance = scene->instantiate();
+	REQUIRE(instance);
+	root->add_child(instance);
+	Node2D *enemy = Object::cast_to<Node2D>(instance);
+	Sprite2D *sprite = Object::cast_to<Sprite2D>(instance->get_node(NodePath("Sprite")));
+	Timer *timer = Object::cast_to<Timer>(instance->get_node(NodePath("Timer")));
+	REQUIRE(enemy);
+	REQUIRE(sprite);
+	REQUIRE(timer);
+
+	enemy->set_position(Vector2(100, 100));
+	enemy->set_meta("hit_points", 3);
+	enemy->add_to_group("damaged");
+	enemy->remove_from_group("enemies");
+	sprite->set_modulate(Color(0, 0, 1));
+	timer->connect("timeout", Callable(listener, "queue_free"));
+
+	scene->release_instance(instance);
+	CHECK(scene->get_pooled_instance_count() == 1);
+	CHECK(instance->get_parent() == nullptr);
+
+	Node *reused = scene->instantiate();
+	CHECK(reused == instance);
+	CHECK(scene->get_pooled_instance_count() == 0);
+	CHECK(enemy->get_position() == Vector2(10, 20));
+	CHECK_FALSE(enemy->has_meta("hit_points"));
+	CHECK(enemy->get_meta("kind") == "enemy");
+	CHECK(enemy->is_in_group("enemies"));
+	CHECK_FALSE(enemy->is_in_group("damaged"));
+	CHECK(sprite->get_modulate() == Color(1, 0, 0));
+	CHECK_FALSE_MESSAGE(
+			timer->is_connected("timeout", Callable(listener, "queue_free")),
+			"Connections to nodes outside of the instance should be dropped.");
+	List<Object::Connection> connections;
+	timer->get_signal_connection_list("timeout", &connections);
+	CHECK(connections.size() == 2);
+
+	// Instances whose nodes changed can't be reset, they're freed instead.
+	reused->add_child(memnew(Node));
+	scene->release_instance(reused);
+	CHECK(scene->get_pooled_instance_count() == 0);
+	SceneTree::get_singleton()->process(0);
+
+	memdelete(listener);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Released instances get back the connections of the template only") {
+	Ref<PackedScene> scene = create_enemy_scene();
+	Ref<PlaceholderTexture2D> texture;
+	texture.instantiate();
+	Ref<SceneState> state = scene->get_state();
+	state->add_node_property(1, state->add_name("texture"), state->add_value(texture));
+	scene->set_instance_pool_size(1);
+	SceneTree *tree = SceneTree::get_singleton();
+
+	Node *instance = scene->instantiate();
+	REQUIRE(instance);
+	tree->get_root()->add_child(instance);
+	Sprite2D *sprite = Object::cast_to<Sprite2D>(instance->get_node(NodePath("Sprite")));
+	Timer *timer = Object::cast_to<Timer>(instance->get_node(NodePath("Timer")));
+	REQUIRE(sprite);
+	REQUIRE(timer);
+
+	Ref<Resource> listener;
+	listener.instantiate();
+	timer->connect("timeout", Callable(listener.ptr(), "emit_changed"));
+	tree->connect("process_frame", Callable(sprite, "hide"));
+	texture->connect("changed", Callable(sprite, "show"));
+	timer->disconnect("timeout", Callable(sprite, "hide"));
+
+	scene->release_instance(instance);
+	REQUIRE(scene->get_pooled_instance_count() == 1);
+	CHECK_FALSE_MESSAGE(
+			timer->is_connected("timeout", Callable(listener.ptr(), "emit_changed")),
+			"Connections to objects that aren't nodes should be dropped.");
+	CHECK_FALSE_MESSAGE(
+			tree->is_connected("process_frame", Callable(sprite, "hide")),
+			"Connections from objects outside of the instance should be dropped.");
+	CHECK_FALSE(texture->is_connected("changed", Callable(sprite, "show")));
+	CHECK_MESSAGE(
+			timer->is_connected("timeout", Callable(sprite, "hide")),
+			"Connections of the template that were removed should be made again.");
+	List<Object::Connection> connections;
+	texture->get_signal_connection_list("changed", &connections);
+	CHECK_MESSAGE(connections.size() == 1, "The connection made by Sprite2D to its texture should be kept.");
+
+	Node *reused = scene->instantiate();
+	CHECK(reused == instance);
+	memdelete(reused);
+}
+
+static int count_connections_to(Object *p_source, const StringName &p_signal, Object *p_target) {
+	List<Object::Connection> connections;
+	p_source->get_signal_connection_list(p_signal, &connections);
+	int count = 0;
+	for (const Object::Connection &E : connections) {
+		if (E.callable.get_object() == p_target) {
+			count++;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[Audio][PackedScene] Released instances keep the connections their nodes made when created") {
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	Ref<SceneState> state = scene->get_state();
+	state->add_node(-1, -1, state->add_name("AudioStreamPlayer"), state->add_name("Player"), -1, -1);
+	scene->set_instance_pool_size(2);
+
+	Node *first = scene->instantiate();
+	Node *second = scene->instantiate();
+	REQUIRE(Object::cast_to<AudioStreamPlayer>(first));
+	REQUIRE(Object::cast_to<AudioStreamPlayer>(second));
+	AudioServer *audio_server = AudioServer::get_singleton();
+	REQUIRE(count_connections_to(audio_server, "bus_layout_changed", second) == 1);
+
+	audio_server->connect("bus_layout_changed", Callable(second, "stop"));
+	scene->release_instance(second);
+	REQUIRE(scene->get_pooled_instance_count() == 1);
+	CHECK_MESSAGE(
+			count_connections_to(audio_server, "bus_layout_changed", second) == 1,
+			"Connections made by the player to the AudioServer when created should be kept.");
+	CHECK_FALSE_MESSAGE(
+			audio_server->is_connected("bus_layout_changed", Callable(second, "stop")),
+			"Connections from outside of the instance made after it was created should be dropped.");
+
+	Node *reused = scene->instantiate();
+	CHECK(reused == second);
+	memdelete(first);
+	memdelete(reused);
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_packed_scene_benchmark.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_BENCHMARK_H
+#define TEST_PACKED_SCENE_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "scene/2d/area_2d.h"
+#include "scene/2d/collision_shape_2d.h"
+#include "scene/2d/sprite_2d.h"
+#include "scene/main/timer.h"
+#include "scene/main/window.h"
+#include "scene/resources/circle_shape_2d.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedSceneBenchmark {
+
+static const int INSTANTIATE_COUNT = 2000;
+
+// Something like an enemy: an area with a few sprites and collision shapes, timers and connections.
+static Ref<PackedScene> create_scene(int p_parts) {
+	Area2D *root = memnew(Area2D);
+	root->set_name("Enemy");
+	root->set_position(Vector2(100, 100));
+	root->set_collision_layer(2);
+	root->add_to_group("enemies", true);
+
+	Ref<CircleShape2D> shape;
+	shape.instantiate();
+	shape->set_radius(8);
+
+	for (int i = 0; i < p_parts; i++) {
+		Sprite2D *sprite = memnew(Sprite2D);
+		sprite->set_name(vformat("Sprite%d", i));
+		sprite->set_position(Vector2(i * 4, i * 2));
+		sprite->set_modulate(Color(1, 0.5, 0.5));
+		sprite->set_offset(Vector2(1, 1));
+		sprite->set_centered(false);
+		root->add_child(sprite);
+		sprite->set_owner(root);
+
+		CollisionShape2D *collision = memnew(CollisionShape2D);
+		collision->set_name(vformat("Collision%d", i));
+		collision->set_position(Vector2(i * 4, i * 2));
+		collision->set_shape(shape);
+		root->add_child(collision);
+		collision->set_owner(root);
+
+		Timer *timer = memnew(Timer);
+		timer->set_name(vformat("Timer%d", i));
+		timer->set_wait_time(0.5 + i);
+		timer->set_one_shot(true);
+		root->add_child(timer);
+		timer->set_owner(root);
+		timer->connect("timeout", Callable(sprite, "hide"), Object::CONNECT_PERSIST);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instantiate();
+	CHECK(scene->pack(root) == OK);
+	memdelete(root);
+	return scene;
+}
+
+static double measure_instantiations_per_second(const Ref<PackedScene> &p_scene, bool p_use_plan) {
+	SceneState::set_use_instantiation_plan(p_use_plan);
+
+	// The first instance compiles the plan.
+	memdelete(p_scene->instantiate());
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < INSTANTIATE_COUNT; i++) {
+		Node *node = p_scene->instantiate();
+		memdelete(node);
+	}
+	uint64_t elapsed_usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+
+	SceneState::set_use_instantiation_plan(true);
+	return INSTANTIATE_COUNT * 1000000.0 / elapsed_usec;
+}
+
+static void benchmark_instantiate(int p_parts) {
+	Ref<PackedScene> scene = create_scene(p_parts);
+	double generic = measure_instantiations_per_second(scene, false);
+	double planned = measure_instantiations_per_second(scene, true);
+	MESSAGE(vformat("%d nodes: %.0f instantiations/s generic, %.0f instantiations/s with the instantiation plan (%.2fx).",
+			scene->get_state()->get_node_count(), generic, planned, planned / generic));
+}
+
+static void benchmark_pool(int p_parts) {
+	Ref<PackedScene> scene = create_scene(p_parts);
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	// Memory used by each live instance.
+	const int live_count = 100;
+	Vector<Node *> live;
+	uint64_t mem_before = OS::get_singleton()->get_static_memory_usage();
+	for (int i = 0; i < live_count; i++) {
+		live.push_back(scene->instantiate());
+	}
+	uint64_t instance_bytes = (OS::get_singleton()->get_static_memory_usage() - mem_before) / live_count;
+	for (Node *E : live) {
+		memdelete(E);
+	}
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < INSTANTIATE_COUNT; i++) {
+		Node *node = scene->instantiate();
+		root->add_child(node);
+		root->remove_child(node);
+		memdelete(node);
+	}
+	uint64_t plain_usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+
+	// The pool keeps one instance and the state to reset it to.
+	mem_before = OS::get_singleton()->get_static_memory_usage();
+	scene->set_instance_pool_size(1);
+	Node *first = scene->instantiate();
+	root->add_child(first);
+	scene->release_instance(first);
+	REQUIRE(scene->get_pooled_instance_count() == 1);
+	uint64_t pool_bytes = OS::get_singleton()->get_static_memory_usage() - mem_before;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < INSTANTIATE_COUNT; i++) {
+		Node *node = scene->instantiate();
+		root->add_child(node);
+		scene->release_instance(node);
+	}
+	uint64_t pooled_usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+	CHECK(scene->get_pooled_instance_count() == 1);
+	scene->set_instance_pool_size(0);
+
+	MESSAGE(vformat("%d nodes: instantiate and free %.1f us/cycle, pooled %.1f us/cycle (%.2fx). %d bytes per instance, %d bytes held by the pool.",
+			scene->get_state()->get_node_count(), double(plain_usec) / INSTANTIATE_COUNT, double(pooled_usec) / INSTANTIATE_COUNT,
+			double(plain_usec) / pooled_usec, instance_bytes, pool_bytes));
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][PackedScene] Instantiation") {
+	benchmark_instantiate(1);
+	benchmark_instantiate(4);
+	benchmark_instantiate(16);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][PackedScene] Instance pooling") {
+	benchmark_pool(1);
+	benchmark_pool(4);
+	benchmark_pool(16);
+}
+
+} // namespace TestPackedSceneBenchmark
+
+#endif // TEST_PACKED_SCENE_BENCHMARK_H
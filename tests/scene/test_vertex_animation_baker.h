@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  test_vertex_animation_baker.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VERTEX_ANIMATION_BAKER_H
+#define TEST_VERTEX_ANIMATION_BAKER_H
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/3d/vertex_animation_baker.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+#include "scene/resources/animation_library.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVertexAnimationBaker {
+
+TEST_CASE("[SceneTree][VertexAnimationBaker] Bake a bone moving a triangle") {
+	Node3D *character = memnew(Node3D);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton3D");
+	skeleton->add_bone("root");
+	character->add_child(skeleton);
+
+	// A triangle fully weighted to the only bone.
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	PackedVector3Array vertices = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 0, 1) };
+	PackedVector3Array normals = { Vector3(0, 1, 0), Vector3(0, 1, 0), Vector3(0, 1, 0) };
+	PackedInt32Array bones = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	PackedFloat32Array weights = { 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 };
+	arrays[Mesh::ARRAY_VERTEX] = vertices;
+	arrays[Mesh::ARRAY_NORMAL] = normals;
+	arrays[Mesh::ARRAY_BONES] = bones;
+	arrays[Mesh::ARRAY_WEIGHTS] = weights;
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(mesh);
+	skeleton->add_child(mesh_instance);
+
+	// Moves the bone up by 2 units over one second.
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	int track = animation->add_track(Animation::TYPE_POSITION_3D);
+	animation->track_set_path(track, NodePath("Skeleton3D:root"));
+	animation->position_track_insert_key(track, 0.0, Vector3(0, 0, 0));
+	animation->position_track_insert_key(track, 1.0, Vector3(0, 2, 0));
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("move", animation);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->add_animation_library("", library);
+	character->add_child(player);
+
+	SceneTree::get_singleton()->get_root()->add_child(character);
+
+	Ref<VertexAnimationBaker> baker;
+	baker.instantiate();
+	CHECK(baker->bake(mesh_instance, player, "move", 2.0) == OK);
+	CHECK(baker->get_frame_count() == 2);
+	CHECK(baker->get_fps() == doctest::Approx(2.0));
+
+	Ref<Image> positions = baker->get_position_texture()->get_image();
+	REQUIRE(positions.is_valid());
+	CHECK(positions->get_width() == 3);
+	CHECK(positions->get_height() == 2);
+	for (int i = 0; i < vertices.size(); i++) {
+		Color rest = positions->get_pixel(i, 0);
+		Color moved = positions->get_pixel(i, 1);
+		CHECK(Vector3(rest.r, rest.g, rest.b).is_equal_approx(vertices[i]));
+		CHECK(Vector3(moved.r, moved.g, moved.b).is_equal_approx(vertices[i] + Vector3(0, 1, 0)));
+	}
+
+	Ref<ArrayMesh> baked_mesh = baker->get_mesh();
+	REQUIRE(baked_mesh.is_valid());
+	CHECK(baked_mesh->get_surface_count() == 1);
+	CHECK((baked_mesh->surface_get_format(0) & Mesh::ARRAY_FORMAT_TEX_UV2) != 0);
+	CHECK((baked_mesh->surface_get_format(0) & Mesh::ARRAY_FORMAT_BONES) == 0);
+	CHECK(baked_mesh->surface_get_material(0) == baker->get_material());
+	CHECK(baked_mesh->get_aabb().has_point(Vector3(0, 1, 0)));
+
+	memdelete(character);
+}
+
+TEST_CASE("[SceneTree][VertexAnimationBaker] Bake keeps the material of each surface") {
+	Node3D *character = memnew(Node3D);
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	skeleton->set_name("Skeleton3D");
+	skeleton->add_bone("root");
+	character->add_child(skeleton);
+
+	Array arrays;
+	arrays.resize(Mesh::ARRAY_MAX);
+	arrays[Mesh::ARRAY_VERTEX] = PackedVector3Array({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 0, 1) });
+	arrays[Mesh::ARRAY_BONES] = PackedInt32Array({ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+	arrays[Mesh::ARRAY_WEIGHTS] = PackedFloat32Array({ 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0 });
+	Ref<ArrayMesh> mesh;
+	mesh.instantiate();
+	const Color colors[2] = { Color(1, 0, 0), Color(0, 1, 0) };
+	for (int i = 0; i < 2; i++) {
+		mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, arrays);
+		Ref<StandardMaterial3D> surface_material;
+		surface_material.instantiate();
+		surface_material->set_albedo(colors[i]);
+		mesh->surface_set_material(i, surface_material);
+	}
+
+	MeshInstance3D *mesh_instance = memnew(MeshInstance3D);
+	mesh_instance->set_mesh(mesh);
+	skeleton->add_child(mesh_instance);
+
+	Ref<Animation> animation;
+	animation.instantiate();
+	animation->set_length(1.0);
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("idle", animation);
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->add_animation_library("", library);
+	character->add_child(player);
+
+	SceneTree::get_singleton()->get_root()->add_child(character);
+
+	Ref<VertexAnimationBaker> baker;
+	baker.instantiate();
+	CHECK(baker->bake(mesh_instance, player, "idle", 1.0) == OK);
+
+	Ref<ArrayMesh> baked_mesh = baker->get_mesh();
+	REQUIRE(baked_mesh.is_valid());
+	REQUIRE(baked_mesh->get_surface_count() == 2);
+	CHECK(baked_mesh->surface_get_material(0) == baker->get_material());
+	for (int i = 0; i < 2; i++) {
+		Ref<ShaderMaterial> baked_material = baked_mesh->surface_get_material(i);
+		REQUIRE(baked_material.is_valid());
+		CHECK(Color(baked_material->get_shader_parameter("albedo")) == colors[i]);
+	}
+
+	memdelete(character);
+}
+
+} // namespace TestVertexAnimationBaker
+
+#endif // TEST_VERTEX_ANIMATION_BAKER_H
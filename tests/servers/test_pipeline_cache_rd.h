@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_pipeline_cache_rd.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PIPELINE_CACHE_RD_H
+#define TEST_PIPELINE_CACHE_RD_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPipelineCacheRD {
+
+typedef HashMap<uint64_t, LocalVector<PipelineCacheRD::ManifestVersion>> Manifest;
+
+static Manifest create_manifest() {
+	Manifest manifest;
+
+	// A mesh pipeline drawing to a color and depth attachment.
+	PipelineCacheRD::ManifestVersion mesh_version;
+	mesh_version.has_vertex_format = true;
+	RD::VertexAttribute position;
+	position.location = 0;
+	position.format = RD::DATA_FORMAT_R32G32B32_SFLOAT;
+	position.stride = 12;
+	RD::VertexAttribute normal;
+	normal.location = 1;
+	normal.offset = 12;
+	normal.format = RD::DATA_FORMAT_A2B10G10R10_UNORM_PACK32;
+	normal.stride = 4;
+	normal.frequency = RD::VERTEX_FREQUENCY_INSTANCE;
+	mesh_version.vertex_attributes.push_back(position);
+	mesh_version.vertex_attributes.push_back(normal);
+	RD::AttachmentFormat color;
+	color.format = RD::DATA_FORMAT_R16G16B16A16_SFLOAT;
+	color.usage_flags = RD::TEXTURE_USAGE_COLOR_ATTACHMENT_BIT;
+	RD::AttachmentFormat depth;
+	depth.format = RD::DATA_FORMAT_D32_SFLOAT;
+	depth.samples = RD::TEXTURE_SAMPLES_4;
+	depth.usage_flags = RD::TEXTURE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	mesh_version.attachments.push_back(color);
+	mesh_version.attachments.push_back(depth);
+	RD::FramebufferPass pass;
+	pass.color_attachments.push_back(0);
+	pass.preserve_attachments.push_back(1);
+	pass.depth_attachment = 1;
+	mesh_version.passes.push_back(pass);
+	mesh_version.view_count = 2;
+	mesh_version.render_pass = 1;
+	mesh_version.bool_specializations = 0x5;
+	manifest[0x123456789abcdef0].push_back(mesh_version);
+
+	// A wireframe pipeline without vertex input, drawing to an empty framebuffer.
+	PipelineCacheRD::ManifestVersion empty_version;
+	empty_version.samples = RD::TEXTURE_SAMPLES_8;
+	empty_version.wireframe = true;
+	manifest[0x123456789abcdef0].push_back(empty_version);
+	manifest[42].push_back(empty_version);
+
+	return manifest;
+}
+
+static void check_same_manifest(const Manifest &p_manifest, const Manifest &p_expected) {
+	REQUIRE(p_manifest.size() == p_expected.size());
+	for (const KeyValue<uint64_t, LocalVector<PipelineCacheRD::ManifestVersion>> &E : p_expected) {
+		REQUIRE(p_manifest.has(E.key));
+		const LocalVector<PipelineCacheRD::ManifestVersion> &versions = p_manifest[E.key];
+		REQUIRE(versions.size() == E.value.size());
+		for (uint32_t i = 0; i < versions.size(); i++) {
+			const PipelineCacheRD::ManifestVersion &version = versions[i];
+			const PipelineCacheRD::ManifestVersion &expected = E.value[i];
+			CHECK(version.has_vertex_format == expected.has_vertex_format);
+			CHECK(version.render_pass == expected.render_pass);
+			CHECK(version.wireframe == expected.wireframe);
+			CHECK(version.bool_specializations == expected.bool_specializations);
+			CHECK(version.view_count == expected.view_count);
+			CHECK(version.samples == expected.samples);
+
+			REQUIRE(version.vertex_attributes.size() == expected.vertex_attributes.size());
+			for (int j = 0; j < version.vertex_attributes.size(); j++) {
+				CHECK(version.vertex_attributes[j].location == expected.vertex_attributes[j].location);
+				CHECK(version.vertex_attributes[j].offset == expected.vertex_attributes[j].offset);
+				CHECK(version.vertex_attributes[j].format == expected.vertex_attributes[j].format);
+				CHECK(version.vertex_attributes[j].stride == expected.vertex_attributes[j].stride);
+				CHECK(version.vertex_attributes[j].frequency == expected.vertex_attributes[j].frequency);
+			}
+
+			REQUIRE(version.attachments.size() == expected.attachments.size());
+			for (int j = 0; j < version.attachments.size(); j++) {
+				CHECK(version.attachments[j].format == expected.attachments[j].format);
+				CHECK(version.attachments[j].samples == expected.attachments[j].samples);
+				CHECK(version.attachments[j].usage_flags == expected.attachments[j].usage_flags);
+			}
+
+			REQUIRE(version.passes.size() == expected.passes.size());
+			for (int j = 0; j < version.passes.size(); j++) {
+				CHECK(version.passes[j].color_attachments == expected.passes[j].color_attachments);
+				CHECK(version.passes[j].input_attachments == expected.passes[j].input_attachments);
+				CHECK(version.passes[j].resolve_attachments == expected.passes[j].resolve_attachments);
+				CHECK(version.passes[j].preserve_attachments == expected.passes[j].preserve_attachments);
+				CHECK(version.passes[j].depth_attachment == expected.passes[j].depth_attachment);
+				CHECK(version.passes[j].vrs_attachment == expected.passes[j].vrs_attachment);
+			}
+		}
+	}
+}
+
+static void overwrite_file(const String &p_path, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_buffer(p_data.ptr(), p_data.size());
+}
+
+TEST_CASE("[PipelineCacheRD] Pipeline manifest round trip") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("pipeline_manifest_test.bin");
+	const Manifest expected = create_manifest();
+	REQUIRE(PipelineCacheRD::write_manifest_file(path, expected) == OK);
+	const Vector<uint8_t> data = FileAccess::get_file_as_bytes(path);
+	REQUIRE(data.size() > 8);
+
+	Manifest manifest;
+
+	SUBCASE("Reading back") {
+		CHECK(PipelineCacheRD::read_manifest_file(path, manifest) == OK);
+		check_same_manifest(manifest, expected);
+	}
+
+	SUBCASE("Rejecting another version") {
+		Vector<uint8_t> other_version = data;
+		other_version.write[4] += 1;
+		overwrite_file(path, other_version);
+		manifest[1].push_back(PipelineCacheRD::ManifestVersion());
+		CHECK(PipelineCacheRD::read_manifest_file(path, manifest) == ERR_FILE_UNRECOGNIZED);
+		CHECK(manifest.is_empty());
+	}
+
+	SUBCASE("Rejecting a bad header") {
+		Vector<uint8_t> bad_header = data;
+		bad_header.write[0] = 'X';
+		overwrite_file(path, bad_header);
+		ERR_PRINT_OFF;
+		CHECK(PipelineCacheRD::read_manifest_file(path, manifest) == ERR_FILE_CORRUPT);
+		ERR_PRINT_ON;
+		CHECK(manifest.is_empty());
+	}
+
+	SUBCASE("Rejecting a truncated file") {
+		for (int size : { 12, data.size() / 2, data.size() - 1 }) {
+			overwrite_file(path, data.slice(0, size));
+			ERR_PRINT_OFF;
+			CHECK_MESSAGE(PipelineCacheRD::read_manifest_file(path, manifest) == ERR_FILE_CORRUPT, vformat("Truncated to %d bytes.", size));
+			ERR_PRINT_ON;
+			CHECK(manifest.is_empty());
+		}
+	}
+
+	DirAccess::remove_absolute(path);
+	CHECK(PipelineCacheRD::read_manifest_file(path, manifest) != OK);
+}
+
+} // namespace TestPipelineCacheRD
+
+#endif // TEST_PIPELINE_CACHE_RD_H
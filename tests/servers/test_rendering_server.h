@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  test_rendering_server.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_SERVER_H
+#define TEST_RENDERING_SERVER_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServer {
+
+static Transform3D get_instance_transform(int p_index, int p_step) {
+	Basis basis;
+	if (p_step > 0) {
+		basis = Basis(Vector3(0, 1, 0), p_step * 0.3).scaled(Vector3(1, 1 + p_step * 0.5, 1));
+	}
+	return Transform3D(basis, Vector3((p_index % 8) * 3.0 + p_step * 5.0, p_step * 2.0, (p_index / 8) * 3.0));
+}
+
+static Vector<ObjectID> cull_sorted(const AABB &p_aabb, RID p_scenario) {
+	Vector<ObjectID> instances = RS::get_singleton()->instances_cull_aabb(p_aabb, p_scenario);
+	instances.sort();
+	return instances;
+}
+
+TEST_CASE("[SceneTree][RenderingServer] Bulk instance transforms match single ones") {
+	RS *rs = RS::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = PackedVector3Array({ Vector3(-0.5, -0.5, -0.5), Vector3(0.5, 0.5, 0.5), Vector3(0.5, -0.5, 0.5) });
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	// The same instances in two scenarios, one moved one instance at a time and the other in bulk.
+	const int count = 64;
+	RID single_scenario = rs->scenario_create();
+	RID bulk_scenario = rs->scenario_create();
+	Vector<RID> single_instances;
+	Vector<RID> bulk_instances;
+	for (int i = 0; i < count; i++) {
+		single_instances.push_back(rs->instance_create2(mesh, single_scenario));
+		bulk_instances.push_back(rs->instance_create2(mesh, bulk_scenario));
+		rs->instance_attach_object_instance_id(single_instances[i], ObjectID(uint64_t(i + 1)));
+		rs->instance_attach_object_instance_id(bulk_instances[i], ObjectID(uint64_t(i + 1)));
+		rs->instance_set_transform(single_instances[i], get_instance_transform(i, 0));
+		rs->instance_set_transform(bulk_instances[i], get_instance_transform(i, 0));
+	}
+	RSG::scene->update();
+
+	for (int step = 1; step <= 3; step++) {
+		Vector<Transform3D> transforms;
+		for (int i = 0; i < count; i++) {
+			transforms.push_back(get_instance_transform(i, step));
+			rs->instance_set_transform(single_instances[i], transforms[i]);
+		}
+		rs->instances_set_transforms(bulk_instances, transforms);
+		RSG::scene->update();
+
+		for (int i = 0; i < count; i++) {
+			const AABB &single_aabb = scene_cull->instance_owner.get_or_null(single_instances[i])->transformed_aabb;
+			const AABB &bulk_aabb = scene_cull->instance_owner.get_or_null(bulk_instances[i])->transformed_aabb;
+			CHECK_MESSAGE(bulk_aabb.is_equal_approx(single_aabb), vformat("Instance %d has different bounds after step %d.", i, step));
+			CHECK(cull_sorted(bulk_aabb, bulk_scenario) == cull_sorted(single_aabb, single_scenario));
+		}
+
+		const AABB queries[] = {
+			AABB(Vector3(-10, -10, -10), Vector3(60, 30, 60)),
+			AABB(Vector3(6.1, -10, 2.2), Vector3(7.3, 30, 8.9)),
+			AABB(Vector3(17.7, step * 2.0 - 0.2, -2.0), Vector3(0.4, 0.4, 30)),
+			AABB(Vector3(100, 100, 100), Vector3(1, 1, 1)),
+		};
+		for (const AABB &query : queries) {
+			CHECK(cull_sorted(query, bulk_scenario) == cull_sorted(query, single_scenario));
+		}
+		CHECK(cull_sorted(queries[0], bulk_scenario).size() == count);
+	}
+
+	for (int i = 0; i < count; i++) {
+		rs->free(single_instances[i]);
+		rs->free(bulk_instances[i]);
+	}
+	rs->free(single_scenario);
+	rs->free(bulk_scenario);
+	rs->free(mesh);
+}
+
+} // namespace TestRenderingServer
+
+#endif // TEST_RENDERING_SERVER_H
@@ -0,0 +1,347 @@
+/**************************************************************************/
+/*  test_rendering_server_benchmark.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_SERVER_BENCHMARK_H
+#define TEST_RENDERING_SERVER_BENCHMARK_H
+
+#include "core/os/os.h"
+#include "core/templates/command_queue_mt.h"
+#include "servers/rendering/dummy/rasterizer_scene_dummy.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/renderer_viewport.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+// These benchmarks build synthetic scenes against the dummy rasterizer used by the test runner,
+// so they only measure the CPU side of rendering (instance updates, culling, command submission)
+// and can run on machines without a GPU.
+
+namespace TestRenderingServerBenchmark {
+
+static const int FRAME_COUNT = 60;
+
+// The dummy rasterizer has no render targets or render buffers, so viewports are skipped when drawing.
+// This provides just enough of them for viewports to be culled and drawn.
+class BenchmarkSceneRender : public RasterizerSceneDummy {
+public:
+	Ref<RenderSceneBuffers> render_buffers_create() override { return memnew(RenderSceneBuffers); }
+};
+
+// Installs the scene render above while in scope. Everything using viewports must be created and freed inside it.
+struct BenchmarkRenderer {
+	BenchmarkSceneRender scene_render;
+	RendererSceneRender *previous_scene_render = nullptr;
+	// Stands in for a render target, the dummy texture storage ignores render target calls on it.
+	RID render_target;
+
+	BenchmarkRenderer() {
+		RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+		previous_scene_render = scene_cull->scene_render;
+		scene_cull->scene_render = &scene_render;
+		render_target = RSG::texture_storage->texture_allocate();
+		RSG::texture_storage->texture_2d_placeholder_initialize(render_target);
+	}
+
+	void attach_render_target(RID p_viewport) {
+		RendererViewport::Viewport *viewport = RSG::viewport->viewport_owner.get_or_null(p_viewport);
+		ERR_FAIL_NULL(viewport);
+		viewport->render_target = render_target;
+	}
+
+	~BenchmarkRenderer() {
+		RSG::texture_storage->texture_free(render_target);
+		static_cast<RendererSceneCull *>(RSG::scene)->scene_render = previous_scene_render;
+	}
+};
+
+static RID create_benchmark_mesh() {
+	RS *rs = RS::get_singleton();
+
+	PackedVector3Array vertices;
+	vertices.push_back(Vector3(-0.5, -0.5, -0.5));
+	vertices.push_back(Vector3(0.5, 0.5, 0.5));
+	vertices.push_back(Vector3(0.5, -0.5, 0.5));
+
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+
+	RID mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+	return mesh;
+}
+
+struct BenchmarkScene3D {
+	RID scenario;
+	RID viewport;
+	RID camera;
+	RID mesh;
+	RID light;
+	Vector<RID> instances;
+	Vector<RID> light_instances;
+	int grid_size = 0;
+
+	Transform3D get_instance_transform(int p_index, int p_frame) const {
+		int x = p_index % grid_size;
+		int z = p_index / grid_size;
+		float bob = Math::sin(p_frame * 0.1 + p_index) * 0.1;
+		return Transform3D(Basis(), Vector3(x * 2.0, bob, z * 2.0));
+	}
+
+	void create(BenchmarkRenderer &p_renderer, int p_mesh_count, int p_light_count) {
+		RS *rs = RS::get_singleton();
+
+		scenario = rs->scenario_create();
+		viewport = rs->viewport_create();
+		p_renderer.attach_render_target(viewport);
+		rs->viewport_set_size(viewport, 1920, 1080);
+		rs->viewport_set_update_mode(viewport, RS::VIEWPORT_UPDATE_ALWAYS);
+		rs->viewport_set_scenario(viewport, scenario);
+		rs->viewport_set_active(viewport, true);
+
+		camera = rs->camera_create();
+		rs->camera_set_perspective(camera, 70.0, 0.05, 500.0);
+		rs->viewport_attach_camera(viewport, camera);
+
+		mesh = create_benchmark_mesh();
+
+		grid_size = MAX(1, (int)Math::ceil(Math::sqrt((double)p_mesh_count)));
+		for (int i = 0; i < p_mesh_count; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_attach_object_instance_id(instance, ObjectID(uint64_t(i + 1)));
+			rs->instance_set_transform(instance, get_instance_transform(i, 0));
+			instances.push_back(instance);
+		}
+
+		light = rs->omni_light_create();
+		rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, 8.0);
+		for (int i = 0; i < p_light_count; i++) {
+			RID instance = rs->instance_create2(light, scenario);
+			float x = (i * 7919 % 1000) / 1000.0 * grid_size * 2.0;
+			float z = (i * 104729 % 1000) / 1000.0 * grid_size * 2.0;
+			rs->instance_set_transform(instance, Transform3D(Basis(), Vector3(x, 2.0, z)));
+			light_instances.push_back(instance);
+		}
+
+		set_camera(0);
+	}
+
+	void set_camera(int p_frame) {
+		// Orbit above the grid looking at its center, so a varying part of the instances is culled.
+		float extent = grid_size * 2.0;
+		Vector3 center = Vector3(extent * 0.5, 0.0, extent * 0.5);
+		float angle = p_frame * Math_TAU / FRAME_COUNT;
+		Vector3 eye = center + Vector3(Math::cos(angle), 0.5, Math::sin(angle)) * extent * 0.5;
+		RS::get_singleton()->camera_set_transform(camera, Transform3D(Basis(), eye).looking_at(center, Vector3(0, 1, 0)));
+	}
+
+	void free() {
+		RS *rs = RS::get_singleton();
+		for (const RID &instance : instances) {
+			rs->free(instance);
+		}
+		for (const RID &instance : light_instances) {
+			rs->free(instance);
+		}
+		rs->free(light);
+		rs->free(mesh);
+		rs->free(camera);
+		rs->free(viewport);
+		rs->free(scenario);
+	}
+};
+
+static void benchmark_scene_3d(int p_mesh_count, int p_light_count, bool p_bulk_transforms = false) {
+	BenchmarkRenderer renderer;
+	BenchmarkScene3D scene;
+	scene.create(renderer, p_mesh_count, p_light_count);
+
+	// Sanity check the setup, every instance must be registered in the scenario indexer.
+	RSG::scene->update();
+	float extent = scene.grid_size * 2.0;
+	CHECK(RS::get_singleton()->instances_cull_aabb(AABB(Vector3(-1, -1, -1), Vector3(extent + 2, 2, extent + 2)), scene.scenario).size() == p_mesh_count);
+
+	uint64_t set_transform_usec = 0;
+	uint64_t update_usec = 0;
+	uint64_t draw_usec = 0;
+
+	Vector<Transform3D> transforms;
+	transforms.resize(scene.instances.size());
+
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		if (p_bulk_transforms) {
+			Transform3D *transforms_ptr = transforms.ptrw();
+			for (int i = 0; i < scene.instances.size(); i++) {
+				transforms_ptr[i] = scene.get_instance_transform(i, frame);
+			}
+			RS::get_singleton()->instances_set_transforms(scene.instances, transforms);
+		} else {
+			for (int i = 0; i < scene.instances.size(); i++) {
+				RS::get_singleton()->instance_set_transform(scene.instances[i], scene.get_instance_transform(i, frame));
+			}
+		}
+		scene.set_camera(frame);
+		uint64_t after_set = OS::get_singleton()->get_ticks_usec();
+
+		RSG::scene->update();
+		uint64_t after_update = OS::get_singleton()->get_ticks_usec();
+
+		RSG::viewport->draw_viewports();
+		uint64_t after_draw = OS::get_singleton()->get_ticks_usec();
+
+		set_transform_usec += after_set - from;
+		update_usec += after_update - after_set;
+		draw_usec += after_draw - after_update;
+	}
+
+	// Moved instances must still be found at their new positions.
+	CHECK(RS::get_singleton()->instances_cull_aabb(AABB(Vector3(-1, -1, -1), Vector3(extent + 2, 2, extent + 2)), scene.scenario).size() == p_mesh_count);
+
+	MESSAGE(vformat("3D scene, %d meshes, %d lights%s: set transforms %.3f ms/frame, instance update %.3f ms/frame, cull and draw viewports %.3f ms/frame.",
+			p_mesh_count, p_light_count, p_bulk_transforms ? " (bulk transforms)" : "", set_transform_usec / 1000.0 / FRAME_COUNT, update_usec / 1000.0 / FRAME_COUNT, draw_usec / 1000.0 / FRAME_COUNT));
+
+	scene.free();
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][RenderingServer] 3D instance update and culling") {
+	benchmark_scene_3d(1000, 0);
+	benchmark_scene_3d(10000, 0);
+	benchmark_scene_3d(10000, 64);
+	benchmark_scene_3d(50000, 256);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][RenderingServer] 3D bulk instance transforms") {
+	benchmark_scene_3d(10000, 0, true);
+	benchmark_scene_3d(10000, 64, true);
+	benchmark_scene_3d(50000, 256, true);
+}
+
+static void benchmark_canvas(int p_item_count) {
+	BenchmarkRenderer renderer;
+	RS *rs = RS::get_singleton();
+
+	RID viewport = rs->viewport_create();
+	renderer.attach_render_target(viewport);
+	rs->viewport_set_size(viewport, 1920, 1080);
+	rs->viewport_set_update_mode(viewport, RS::VIEWPORT_UPDATE_ALWAYS);
+	rs->viewport_set_active(viewport, true);
+
+	RID canvas = rs->canvas_create();
+	rs->viewport_attach_canvas(viewport, canvas);
+
+	Vector<RID> items;
+	for (int i = 0; i < p_item_count; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, canvas);
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+		items.push_back(item);
+	}
+
+	uint64_t set_transform_usec = 0;
+	uint64_t draw_usec = 0;
+
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < items.size(); i++) {
+			// Scatter items across an area twice the size of the viewport, so part of them is culled.
+			Vector2 position = Vector2((i * 37 + frame * 4) % 3840, (i * 53) % 2160);
+			rs->canvas_item_set_transform(items[i], Transform2D(0.0, position));
+		}
+		uint64_t after_set = OS::get_singleton()->get_ticks_usec();
+
+		RSG::viewport->draw_viewports();
+		uint64_t after_draw = OS::get_singleton()->get_ticks_usec();
+
+		set_transform_usec += after_set - from;
+		draw_usec += after_draw - after_set;
+	}
+
+	MESSAGE(vformat("Canvas, %d items: set transforms %.3f ms/frame, cull and draw viewports %.3f ms/frame.",
+			p_item_count, set_transform_usec / 1000.0 / FRAME_COUNT, draw_usec / 1000.0 / FRAME_COUNT));
+
+	for (const RID &item : items) {
+		rs->free(item);
+	}
+	rs->free(canvas);
+	rs->free(viewport);
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][RenderingServer] Canvas item culling") {
+	benchmark_canvas(1000);
+	benchmark_canvas(10000);
+	benchmark_canvas(50000);
+}
+
+class CommandReceiver {
+public:
+	uint64_t count = 0;
+	Vector3 origin_sum;
+
+	void set_transform(RID p_instance, const Transform3D &p_transform) {
+		count++;
+		origin_sum += p_transform.origin;
+	}
+};
+
+TEST_CASE_BENCHMARK("[Benchmark][RenderingServer] Command queue throughput") {
+	const int command_count = 100000;
+
+	CommandQueueMT queue(false);
+	CommandReceiver receiver;
+
+	uint64_t push_usec = 0;
+	uint64_t flush_usec = 0;
+
+	for (int frame = 0; frame < FRAME_COUNT; frame++) {
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < command_count; i++) {
+			queue.push(&receiver, &CommandReceiver::set_transform, RID(), Transform3D(Basis(), Vector3(i, frame, 0)));
+		}
+		uint64_t after_push = OS::get_singleton()->get_ticks_usec();
+
+		queue.flush_all();
+		uint64_t after_flush = OS::get_singleton()->get_ticks_usec();
+
+		push_usec += after_push - from;
+		flush_usec += after_flush - after_push;
+	}
+
+	CHECK(receiver.count == uint64_t(command_count) * FRAME_COUNT);
+
+	MESSAGE(vformat("Command queue, %d commands/frame: push %.3f ms/frame, flush %.3f ms/frame.",
+			command_count, push_usec / 1000.0 / FRAME_COUNT, flush_usec / 1000.0 / FRAME_COUNT));
+}
+
+} // namespace TestRenderingServerBenchmark
+
+#endif // TEST_RENDERING_SERVER_BENCHMARK_H
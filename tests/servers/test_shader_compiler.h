@@ -0,0 +1,221 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+static const char *test_shader_code = R"(
+shader_type spatial;
+render_mode unshaded;
+
+uniform vec4 tint : source_color = vec4(1.0, 0.5, 0.25, 1.0);
+uniform sampler2D albedo_texture : filter_nearest;
+
+void fragment() {
+	ALBEDO = tint.rgb * texture(albedo_texture, UV).rgb * sin(TIME);
+	ALPHA = tint.a;
+}
+)";
+
+// The flags and uniforms a compilation reports back through its IdentifierActions.
+struct CompileResult {
+	Error err = FAILED;
+	bool unshaded = false;
+	bool uses_time = false;
+	bool writes_alpha = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::GeneratedCode gen_code;
+};
+
+static void initialize_compiler(ShaderCompiler &r_compiler) {
+	ShaderCompiler::DefaultIdentifierActions actions;
+	actions.renames["ALBEDO"] = "albedo";
+	actions.renames["ALPHA"] = "alpha";
+	actions.renames["UV"] = "uv_interp";
+	actions.renames["TIME"] = "global_time";
+	actions.render_mode_defines["unshaded"] = "#define MODE_UNSHADED\n";
+	actions.usage_defines["ALPHA"] = "#define USE_ALPHA\n";
+	actions.default_filter = ShaderLanguage::FILTER_LINEAR_MIPMAP;
+	actions.default_repeat = ShaderLanguage::REPEAT_ENABLE;
+	actions.sampler_array_name = "material_samplers";
+	actions.base_texture_binding_index = 1;
+	actions.texture_layout_set = 2;
+	actions.base_uniform_string = "material.";
+	r_compiler.initialize(actions);
+}
+
+static CompileResult compile(ShaderCompiler &p_compiler) {
+	CompileResult result;
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_flags["unshaded"] = &result.unshaded;
+	actions.usage_flag_pointers["TIME"] = &result.uses_time;
+	actions.write_flag_pointers["ALPHA"] = &result.writes_alpha;
+	actions.uniforms = &result.uniforms;
+	result.err = p_compiler.compile(RS::SHADER_SPATIAL, test_shader_code, &actions, "res://test.gdshader", result.gen_code);
+	return result;
+}
+
+static void check_same_result(const CompileResult &p_result, const CompileResult &p_expected) {
+	CHECK(p_result.err == OK);
+	CHECK(p_result.unshaded == p_expected.unshaded);
+	CHECK(p_result.uses_time == p_expected.uses_time);
+	CHECK(p_result.writes_alpha == p_expected.writes_alpha);
+
+	const ShaderCompiler::GeneratedCode &code = p_result.gen_code;
+	const ShaderCompiler::GeneratedCode &expected_code = p_expected.gen_code;
+	CHECK(code.defines == expected_code.defines);
+	CHECK(code.uniforms == expected_code.uniforms);
+	CHECK(code.uniform_offsets == expected_code.uniform_offsets);
+	CHECK(code.uniform_total_size == expected_code.uniform_total_size);
+	for (int i = 0; i < ShaderCompiler::STAGE_MAX; i++) {
+		CHECK(code.stage_globals[i] == expected_code.stage_globals[i]);
+	}
+	CHECK(code.code.size() == expected_code.code.size());
+	for (const KeyValue<String, String> &E : expected_code.code) {
+		const String *stage_code = code.code.getptr(E.key);
+		REQUIRE(stage_code);
+		CHECK(*stage_code == E.value);
+	}
+	REQUIRE(code.texture_uniforms.size() == expected_code.texture_uniforms.size());
+	for (int i = 0; i < code.texture_uniforms.size(); i++) {
+		CHECK(code.texture_uniforms[i].name == expected_code.texture_uniforms[i].name);
+		CHECK(code.texture_uniforms[i].filter == expected_code.texture_uniforms[i].filter);
+	}
+	CHECK(code.uses_fragment_time == expected_code.uses_fragment_time);
+
+	CHECK(p_result.uniforms.size() == p_expected.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_expected.uniforms) {
+		REQUIRE(p_result.uniforms.has(E.key));
+		const ShaderLanguage::ShaderNode::Uniform &u = p_result.uniforms[E.key];
+		CHECK(u.order == E.value.order);
+		CHECK(u.texture_order == E.value.texture_order);
+		CHECK(u.type == E.value.type);
+		CHECK(u.hint == E.value.hint);
+		REQUIRE(u.default_value.size() == E.value.default_value.size());
+		for (int i = 0; i < u.default_value.size(); i++) {
+			CHECK(u.default_value[i].uint == E.value.default_value[i].uint);
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Generated code round-trips through the disk cache") {
+	const String dir = OS::get_singleton()->get_cache_path().path_join("shader_compiler_cache_test");
+	const String cache_dir = dir.path_join("shader_compiler");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+	ShaderCompiler::set_cache_dir(dir);
+
+	ShaderCompiler compiler;
+	initialize_compiler(compiler);
+
+	ShaderCompiler::CacheStats stats = ShaderCompiler::get_cache_stats();
+	const CompileResult expected = compile(compiler);
+	REQUIRE(expected.err == OK);
+	CHECK(expected.unshaded);
+	CHECK(expected.uses_time);
+	CHECK(expected.writes_alpha);
+	CHECK(expected.uniforms.has("tint"));
+	CHECK(expected.uniforms.has("albedo_texture"));
+	CHECK(ShaderCompiler::get_cache_stats().compiled == stats.compiled + 1);
+
+	PackedStringArray files = DirAccess::get_files_at(cache_dir);
+	REQUIRE(files.size() == 1);
+	const String cache_file = cache_dir.path_join(files[0]);
+
+	SUBCASE("Loading the cached code") {
+		stats = ShaderCompiler::get_cache_stats();
+		check_same_result(compile(compiler), expected);
+		CHECK(ShaderCompiler::get_cache_stats().cache_hits == stats.cache_hits + 1);
+		CHECK(ShaderCompiler::get_cache_stats().compiled == stats.compiled);
+	}
+
+	SUBCASE("Recompiling when the cache version doesn't match") {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_file);
+		REQUIRE(data.size() > 8);
+		data.write[4] += 1;
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		f->store_buffer(data.ptr(), data.size());
+		f.unref();
+
+		stats = ShaderCompiler::get_cache_stats();
+		check_same_result(compile(compiler), expected);
+		CHECK(ShaderCompiler::get_cache_stats().cache_hits == stats.cache_hits);
+		CHECK(ShaderCompiler::get_cache_stats().compiled == stats.compiled + 1);
+
+		// The recompiled code replaced the outdated file.
+		check_same_result(compile(compiler), expected);
+		CHECK(ShaderCompiler::get_cache_stats().cache_hits == stats.cache_hits + 1);
+	}
+
+	SUBCASE("Recompiling when the cache file is corrupt") {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_file);
+		Vector<uint8_t> variants[2];
+		// Bad header.
+		variants[0] = data;
+		variants[0].write[0] = 'X';
+		// Truncated.
+		variants[1] = data.slice(0, data.size() / 2);
+
+		for (const Vector<uint8_t> &variant : variants) {
+			Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+			f->store_buffer(variant.ptr(), variant.size());
+			f.unref();
+
+			stats = ShaderCompiler::get_cache_stats();
+			ERR_PRINT_OFF;
+			CompileResult result = compile(compiler);
+			ERR_PRINT_ON;
+			check_same_result(result, expected);
+			CHECK(ShaderCompiler::get_cache_stats().cache_hits == stats.cache_hits);
+			CHECK(ShaderCompiler::get_cache_stats().compiled == stats.compiled + 1);
+		}
+	}
+
+	ShaderCompiler::set_cache_dir(String());
+	for (const String &file : DirAccess::get_files_at(cache_dir)) {
+		DirAccess::remove_absolute(cache_dir.path_join(file));
+	}
+	DirAccess::remove_absolute(cache_dir);
+	DirAccess::remove_absolute(dir);
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H